@@ -62,7 +62,7 @@ int main() {
   Sharing::Shared<AppSettings::Settings> settings(
       AppSettings::settingsFileStorage(dataDir / "settings.json"));
   Sharing::Shared<std::optional<SavedGame::Game>> savedGame(
-      SavedGame::savedGameFileStorage(dataDir / "savedgame.json"));
+      SavedGame::savedGameJournalStorage(dataDir / "savedgame.json"));
 
   // Wire up live dependencies as early as possible, the analog of TCA's
   // `prepareDependencies` at the app entry point.
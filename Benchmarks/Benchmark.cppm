@@ -0,0 +1,234 @@
+export module Benchmark;
+
+import std;
+import AllocationTracking;
+
+// A tiny micro-benchmark harness for `FifteenBenchmarks` — deliberately small,
+// so the suite needs nothing beyond `import std`. A benchmark is a named kernel
+// that runs its operation `iterations` times; the harness calibrates the count
+// until a run takes at least `minTime`, then reports nanoseconds, heap
+// allocations and allocated bytes per operation. Allocations are counted by
+// AllocationTracking's replacement `operator new`, which every benchmark tool
+// links (AllocationHooks).
+//
+// Results print as a table and, with `--json`, as machine-readable JSON so a
+// regression can be tracked across commits. `LatencyHistogram` is shared with
+// the load tools (FifteenLoadGenerator, FifteenHttpLoad).
+export namespace Benchmark {
+
+// Keeps `value` alive as far as the optimizer can tell, so a kernel whose
+// result is otherwise unused isn't deleted.
+template <typename T> inline void doNotOptimize(const T &value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  static const void *volatile sink;
+  sink = &value;
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+struct Result {
+  std::string name;
+  std::uint64_t iterations = 0;
+  double nsPerOp = 0.0;
+  double allocsPerOp = 0.0;
+  double bytesPerOp = 0.0;
+};
+
+struct Options {
+  std::chrono::nanoseconds minTime = std::chrono::milliseconds(250);
+  std::string filter; // substring of the names to run; empty = all
+};
+
+// A kernel runs its operation `iterations` times. Everything inside the call is
+// timed, so do setup in the registering code and capture it.
+using Kernel = std::function<void(std::uint64_t iterations)>;
+
+class Suite {
+public:
+  void add(std::string name, Kernel kernel) {
+    benchmarks_.push_back({std::move(name), std::move(kernel)});
+  }
+
+  std::vector<Result> run(const Options &options) const {
+    std::vector<Result> results;
+    for (const auto &[name, kernel] : benchmarks_) {
+      if (!options.filter.empty() && !name.contains(options.filter)) {
+        continue;
+      }
+      results.push_back(measure(name, kernel, options.minTime));
+    }
+    return results;
+  }
+
+private:
+  static Result measure(const std::string &name, const Kernel &kernel,
+                        std::chrono::nanoseconds minTime) {
+    using Clock = std::chrono::steady_clock;
+    std::uint64_t iterations = 1;
+    while (true) {
+      const AllocationTracking::Totals before = AllocationTracking::threadTotals();
+      const auto start = Clock::now();
+      kernel(iterations);
+      const auto elapsed = Clock::now() - start;
+      const AllocationTracking::Totals after = AllocationTracking::threadTotals();
+      const std::uint64_t runAllocs = after.allocations - before.allocations;
+      const std::uint64_t runBytes = after.bytes - before.bytes;
+
+      if (elapsed >= minTime || iterations >= (std::uint64_t{1} << 40)) {
+        const auto n = static_cast<double>(iterations);
+        return Result{.name = name,
+                      .iterations = iterations,
+                      .nsPerOp = std::chrono::duration<double, std::nano>(elapsed).count() / n,
+                      .allocsPerOp = static_cast<double>(runAllocs) / n,
+                      .bytesPerOp = static_cast<double>(runBytes) / n};
+      }
+      // Aim 20% past the target from the last run, growing at most 10x a step.
+      const double perOp =
+          std::max(1.0, static_cast<double>(elapsed.count()) / static_cast<double>(iterations));
+      const double wanted = static_cast<double>(minTime.count()) * 1.2 / perOp;
+      iterations = std::clamp(static_cast<std::uint64_t>(wanted), iterations + 1, iterations * 10);
+    }
+  }
+
+  std::vector<std::pair<std::string, Kernel>> benchmarks_;
+};
+
+// Latencies in log-linear microsecond buckets: exact below 16µs, then 16
+// buckets per power of two (~6% resolution). Counters are relaxed atomics, so
+// the load tools' worker threads record without a lock and the reporter diffs
+// snapshots for per-interval figures.
+class LatencyHistogram {
+public:
+  static constexpr int kSubBuckets = 16;
+  static constexpr int kBuckets = 40 * kSubBuckets;
+  using Counts = std::array<std::uint64_t, kBuckets>;
+
+  void record(std::chrono::nanoseconds latency) {
+    const auto us = static_cast<std::uint64_t>(std::max<std::int64_t>(
+        0, std::chrono::duration_cast<std::chrono::microseconds>(latency).count()));
+    counts_[static_cast<std::size_t>(bucketOf(us))].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  Counts snapshot() const {
+    Counts counts{};
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+      counts[i] = counts_[i].load(std::memory_order_relaxed);
+    }
+    return counts;
+  }
+
+  static std::uint64_t total(const Counts &counts) {
+    return std::accumulate(counts.begin(), counts.end(), std::uint64_t{0});
+  }
+
+  // Upper bound of the bucket holding quantile `q` (0..1), in microseconds.
+  static double percentile(const Counts &counts, double q) {
+    const std::uint64_t n = total(counts);
+    if (n == 0) {
+      return 0.0;
+    }
+    const auto rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(n))));
+    std::uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+      seen += counts[static_cast<std::size_t>(i)];
+      if (seen >= rank) {
+        return static_cast<double>(lowerBound(i + 1));
+      }
+    }
+    return static_cast<double>(lowerBound(kBuckets));
+  }
+
+  static Counts minus(const Counts &lhs, const Counts &rhs) {
+    Counts out{};
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      out[i] = lhs[i] - rhs[i];
+    }
+    return out;
+  }
+
+  // Smallest latency (µs) that lands in bucket `index`.
+  static std::uint64_t lowerBound(int index) {
+    if (index < kSubBuckets) {
+      return static_cast<std::uint64_t>(index);
+    }
+    const int shift = index / kSubBuckets - 1;
+    return static_cast<std::uint64_t>(kSubBuckets + index % kSubBuckets) << shift;
+  }
+
+private:
+  static int bucketOf(std::uint64_t us) {
+    if (us < kSubBuckets) {
+      return static_cast<int>(us);
+    }
+    const int shift = std::bit_width(us) - 5; // keep the top five bits: 1xxxx
+    const int index = (shift + 1) * kSubBuckets + static_cast<int>((us >> shift) & 15);
+    return std::min(index, kBuckets - 1);
+  }
+
+  std::array<std::atomic<std::uint64_t>, kBuckets> counts_{};
+};
+
+// Prints percentiles and a bar per power of two of `counts` (µs buckets).
+inline void printLatency(std::string_view title, const LatencyHistogram::Counts &counts) {
+  using H = LatencyHistogram;
+  const std::uint64_t n = H::total(counts);
+  std::println("{}: {} samples  p50 {:.3f}ms  p90 {:.3f}ms  p99 {:.3f}ms  p99.9 {:.3f}ms", title, n,
+               H::percentile(counts, 0.50) / 1000.0, H::percentile(counts, 0.90) / 1000.0,
+               H::percentile(counts, 0.99) / 1000.0, H::percentile(counts, 0.999) / 1000.0);
+  if (n == 0) {
+    return;
+  }
+  std::array<std::uint64_t, H::kBuckets / H::kSubBuckets> rows{};
+  for (int i = 0; i < H::kBuckets; ++i) {
+    rows[static_cast<std::size_t>(i / H::kSubBuckets)] += counts[static_cast<std::size_t>(i)];
+  }
+  const std::uint64_t widest = std::ranges::max(rows);
+  for (std::size_t row = 0; row < rows.size(); ++row) {
+    if (rows[row] == 0) {
+      continue;
+    }
+    const auto bar = static_cast<std::size_t>(40.0 * static_cast<double>(rows[row]) /
+                                              static_cast<double>(widest));
+    const std::uint64_t below = H::lowerBound(static_cast<int>(row + 1) * H::kSubBuckets);
+    std::println("  < {:>9}us  {:>10}  {}", below, rows[row],
+                 std::string(std::max<std::size_t>(bar, 1), '#'));
+  }
+}
+
+// Throughput view of `nsPerOp` (events/sec for the engine kernels).
+inline double opsPerSecond(const Result &result) {
+  return result.nsPerOp > 0.0 ? 1e9 / result.nsPerOp : 0.0;
+}
+
+inline void printTable(std::span<const Result> results) {
+  std::size_t width = 9;
+  for (const Result &r : results) {
+    width = std::max(width, r.name.size());
+  }
+  std::println("{:<{}}  {:>14}  {:>12}  {:>14}  {:>12}  {:>12}", "benchmark", width, "iterations",
+               "ns/op", "ops/s", "allocs/op", "B/op");
+  for (const Result &r : results) {
+    std::println("{:<{}}  {:>14}  {:>12.1f}  {:>14.0f}  {:>12.2f}  {:>12.1f}", r.name, width,
+                 r.iterations, r.nsPerOp, opsPerSecond(r), r.allocsPerOp, r.bytesPerOp);
+  }
+}
+
+// {"benchmarks": [{"name", "iterations", "ns_per_op", "ops_per_sec",
+// "allocs_per_op", "bytes_per_op"}, ...]}. Names are ASCII identifiers, so quoting is enough.
+inline std::string toJson(std::span<const Result> results) {
+  std::string out = "{\n  \"benchmarks\": [";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const Result &r = results[i];
+    out += std::format("{}\n    {{\"name\": \"{}\", \"iterations\": {}, \"ns_per_op\": {:.3f}, "
+                       "\"ops_per_sec\": {:.1f}, \"allocs_per_op\": {:.4f}, "
+                       "\"bytes_per_op\": {:.2f}}}",
+                       i == 0 ? "" : ",", r.name, r.iterations, r.nsPerOp, opsPerSecond(r),
+                       r.allocsPerOp, r.bytesPerOp);
+  }
+  out += "\n  ]\n}\n";
+  return out;
+}
+
+} // namespace Benchmark
@@ -0,0 +1,197 @@
+// GameServer::Engine kernels: the referee driven directly with synthetic
+// traffic, no sockets, so what is measured is matchmaking, move replay and
+// live-feed fan-out alone. One op is one engine event (join / move / leave /
+// observe); ops/s is therefore events/sec and allocs/op allocations per event.
+//
+// Time and randomness are pinned: the clock is constant and the generator
+// always returns the same seed, so every match deals the same board for its
+// grid. That is what lets a pre-generated event script stay legal no matter
+// how often it is replayed — the script, not the engine, decides the moves.
+
+import std;
+import Benchmark;
+import Dependencies;
+import GameServer;
+import PuzzleCore;
+
+namespace {
+
+constexpr std::uint64_t kSeed = 7;
+
+enum class EventKind : std::uint8_t { join, move, leave, observe };
+
+struct Event {
+  EventKind kind = EventKind::move;
+  GameServer::PlayerId player = 0;
+  int value = 0; // grid for a join, tile index for a move
+};
+
+struct Traffic {
+  int players = 1'000;
+  int observers = 16;
+  int movesPerPlayer = 40;
+  int maxGrid = 6;
+};
+
+// The moves that solve the pinned deal for `grid` (undo the scramble
+// back-to-front; see Tests/GameServerTests.cpp).
+std::vector<int> solutionFor(int grid) {
+  auto rng = Dependencies::RandomNumberGenerator::seeded(kSeed);
+  std::vector<std::string> tiles;
+  std::vector<int> history;
+  PuzzleCore::scramble(grid, rng, tiles, history, grid * grid * 10);
+  std::vector<int> solution;
+  int empty = grid * grid - 1;
+  for (const int pos : history) {
+    solution.push_back(empty);
+    empty = pos;
+  }
+  std::ranges::reverse(solution);
+  return solution;
+}
+
+// One complete session, ending with an empty engine: observers subscribe,
+// players join in pairs (so each pair is matched on the same grid), everyone
+// plays round-robin — every fourth pair's first player runs the full solution
+// so matches finish, the rest make random legal slides — then everyone leaves
+// (walkovers for unfinished matches).
+std::vector<Event> session(const Traffic &traffic) {
+  std::vector<Event> events;
+  const int observerBase = traffic.players + 1;
+  for (int o = 0; o < traffic.observers; ++o) {
+    events.push_back({.kind = EventKind::observe, .player = observerBase + o});
+  }
+
+  struct Seat {
+    int grid = 4;
+    std::vector<std::string> tiles;
+    std::vector<int> history;
+    std::vector<int> script; // moves still to play
+  };
+  std::vector<Seat> seats(static_cast<std::size_t>(traffic.players));
+  std::mt19937_64 rng(kSeed);
+  const int grids = traffic.maxGrid - PuzzleCore::minGrid + 1;
+  for (int p = 0; p < traffic.players; ++p) {
+    Seat &seat = seats[static_cast<std::size_t>(p)];
+    const int pair = p / 2;
+    seat.grid = PuzzleCore::minGrid + pair % grids;
+    seat.tiles = PuzzleCore::scrambled(seat.grid, kSeed);
+    if (pair % 4 == 0 && p % 2 == 0) {
+      seat.script = solutionFor(seat.grid);
+    } else {
+      int previous = -1;
+      std::vector<std::string> tiles = seat.tiles;
+      for (int m = 0; m < traffic.movesPerPlayer; ++m) {
+        const int empty = *PuzzleCore::emptyIndex(tiles);
+        auto options = PuzzleCore::neighbors(empty, seat.grid);
+        std::erase(options, previous);
+        const int pick = options[static_cast<std::size_t>(rng() % options.size())];
+        PuzzleCore::slide(tiles, seat.history, seat.grid, pick);
+        seat.script.push_back(pick);
+        previous = empty;
+      }
+    }
+    events.push_back({.kind = EventKind::join, .player = p + 1, .value = seat.grid});
+  }
+
+  for (std::size_t step = 0;; ++step) {
+    bool any = false;
+    for (int p = 0; p < traffic.players; ++p) {
+      const Seat &seat = seats[static_cast<std::size_t>(p)];
+      if (step < seat.script.size()) {
+        events.push_back({.kind = EventKind::move, .player = p + 1, .value = seat.script[step]});
+        any = true;
+      }
+    }
+    if (!any) {
+      break;
+    }
+  }
+
+  for (int p = 0; p < traffic.players; ++p) {
+    events.push_back({.kind = EventKind::leave, .player = p + 1});
+  }
+  for (int o = 0; o < traffic.observers; ++o) {
+    events.push_back({.kind = EventKind::leave, .player = observerBase + o});
+  }
+  return events;
+}
+
+GameServer::Output apply(GameServer::Engine &engine, const Event &event) {
+  switch (event.kind) {
+  case EventKind::join:
+    return engine.join(event.player, "Player", event.value);
+  case EventKind::move:
+    return engine.move(event.player, event.value);
+  case EventKind::leave:
+    return engine.leave(event.player);
+  case EventKind::observe:
+    return engine.observe(event.player);
+  }
+  return {};
+}
+
+template <typename Body> void withPinnedDependencies(Body body) {
+  Dependencies::withDependencies(
+      [](Dependencies::DependencyValues &values) {
+        values.set<Dependencies::DateGeneratorKey>(Dependencies::DateGenerator::constant(50.0));
+        values.set<Dependencies::RandomNumberGeneratorKey>(
+            Dependencies::RandomNumberGenerator{[] { return kSeed; }});
+      },
+      [&] {
+        body();
+        return 0;
+      });
+}
+
+// Replays `events` cyclically on one engine. The script returns the engine to
+// empty at its end, so the wrap is seamless.
+Benchmark::Kernel replay(std::vector<Event> events) {
+  return [events = std::move(events)](std::uint64_t iterations) {
+    withPinnedDependencies([&] {
+      GameServer::Engine engine;
+      std::size_t next = 0;
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        Benchmark::doNotOptimize(apply(engine, events[next]).messages.size());
+        next = next + 1 == events.size() ? 0 : next + 1;
+      }
+    });
+  };
+}
+
+} // namespace
+
+void registerGameServerBenchmarks(Benchmark::Suite &suite) {
+  // Mixed traffic, with and without a live-feed audience: every join and
+  // leave fans a Presence update out to each observer.
+  for (const int observers : {0, 16, 256}) {
+    const Traffic traffic{.observers = observers};
+    suite.add(std::format("GameServer.session/{}p{}o", traffic.players, observers),
+              replay(session(traffic)));
+  }
+
+  // Steady state of one match: the first player shuttles a tile back and
+  // forth, so every event is a legal, relayed move. (The history grows, as it
+  // would in a long race.)
+  for (const int grid : {4, PuzzleCore::maxGrid}) {
+    const auto tiles = PuzzleCore::scrambled(grid, kSeed);
+    const int empty = *PuzzleCore::emptyIndex(tiles);
+    const int neighbor = PuzzleCore::neighbors(empty, grid).front();
+    suite.add(std::format("GameServer.move/{}", grid), [=](std::uint64_t iterations) {
+      withPinnedDependencies([&] {
+        GameServer::Engine engine;
+        (void)engine.join(1, "A", grid);
+        (void)engine.join(2, "B", grid);
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+          Benchmark::doNotOptimize(engine.move(1, (i & 1) == 0 ? neighbor : empty).messages.size());
+        }
+      });
+    });
+  }
+
+  // Matchmaking churn: a pair joins, is matched, and walks over.
+  suite.add("GameServer.join+leave", replay({{.kind = EventKind::join, .player = 1, .value = 4},
+                                             {.kind = EventKind::join, .player = 2, .value = 4},
+                                             {.kind = EventKind::leave, .player = 1},
+                                             {.kind = EventKind::leave, .player = 2}}));
+}
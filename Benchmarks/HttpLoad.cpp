@@ -0,0 +1,443 @@
+// FifteenHttpLoad — a load tester for the HTTP API. It runs the same request
+// mix (`GET /leaderboard` for random board sizes, with `--post-ratio` of
+// `POST /scores`) in two phases, so transport cost can be told apart from the
+// handler's:
+//
+//  - middleware: `SiteMiddleware::respond` called in-process against a
+//    `:memory:` DatabaseClient seeded with `--seed-scores` games. Only the
+//    `respond` call is timed — routing, validation, SQLite and JSON;
+//  - http: `--concurrency` workers against a running FifteenServer on
+//    127.0.0.1:`--port`, timing connect + request + response. With
+//    `--keep-alive` a worker asks to reuse its connection and does so for as
+//    long as the server allows; a `Connection: close` response (HttpServer
+//    answers every request that way) is honored and counted.
+//
+// Each phase reports throughput and, per route, a latency histogram.
+//
+//   FifteenHttpLoad [--phase all|middleware|http] [--concurrency N]
+//                   [--duration <s>] [--post-ratio <fraction>] [--keep-alive]
+//                   [--port P] [--seed-scores N] [--json <path>|-]
+
+import std;
+import Benchmark;
+import DatabaseClient;
+import DatabaseClientLive;
+import PuzzleCore;
+import ServerRouter;
+import SharedModels;
+import SiteMiddleware;
+import TcpSocket;
+
+namespace {
+
+using Benchmark::LatencyHistogram;
+using Clock = std::chrono::steady_clock;
+
+constexpr const char *kHost = "127.0.0.1"; // localhost only, by design
+
+enum class Phase : std::uint8_t { all, middleware, http };
+
+struct Options {
+  Phase phase = Phase::all;
+  int concurrency = 8;
+  std::chrono::seconds duration{10};
+  double postRatio = 0.1;
+  bool keepAlive = false;
+  int port = 8080;
+  int seedScores = 1'000;
+  std::optional<std::string> jsonPath;
+};
+
+struct RouteStats {
+  std::atomic<std::uint64_t> ok{0};
+  std::atomic<std::uint64_t> failed{0}; // transport error or unexpected status
+  LatencyHistogram latency;
+};
+
+struct Totals {
+  RouteStats leaderboard;
+  RouteStats scores;
+  std::atomic<std::uint64_t> connects{0};
+  std::atomic<std::uint64_t> serverClosed{0}; // keep-alive asked, Connection: close answered
+};
+
+// A worker sends one request and reports whether it got the expected status.
+using Worker = std::function<bool(const ServerRouter::Request &)>;
+
+ServerRouter::Route nextRoute(std::mt19937_64 &rng, int worker, double postRatio) {
+  constexpr auto grids = static_cast<unsigned>(PuzzleCore::maxGrid - PuzzleCore::minGrid + 1);
+  const int grid = PuzzleCore::minGrid + static_cast<int>(rng() % grids);
+  if (std::generate_canonical<double, 53>(rng) < postRatio) {
+    return ServerRouter::SubmitScore{
+        .submission = SharedModels::ScoreSubmission{.name = std::format("load-{}", worker),
+                                                    .gridSize = grid,
+                                                    .moves = 50 + static_cast<int>(rng() % 500),
+                                                    .duration = 10 + static_cast<int>(rng() % 600),
+                                                    .playedAt = 1'700'000'000.0}};
+  }
+  return ServerRouter::FetchLeaderboard{.gridSize = grid};
+}
+
+// --- HTTP client ---------------------------------------------------------------
+
+// The bytes HttpServer's request parser expects for `request`.
+std::string render(const ServerRouter::Request &request, bool keepAlive) {
+  std::string target = request.path;
+  if (!request.query.empty()) {
+    target += '?';
+    target += request.query;
+  }
+  std::string out = std::format("{} {} HTTP/1.1\r\nHost: {}\r\nConnection: {}\r\n", request.method,
+                                target, kHost, keepAlive ? "keep-alive" : "close");
+  if (!request.body.empty()) {
+    out += std::format("Content-Type: application/json\r\nContent-Length: {}\r\n",
+                       request.body.size());
+  }
+  out += "\r\n";
+  out += request.body;
+  return out;
+}
+
+struct HttpResponse {
+  int status = 0;
+  bool close = true; // the server will close the connection after this response
+  std::string body;
+};
+
+std::optional<HttpResponse> readResponse(TcpSocket::Connection &connection) {
+  const auto statusLine = connection.readLine();
+  if (statusLine.status != TcpSocket::ReadStatus::line) {
+    return std::nullopt;
+  }
+  // "HTTP/1.1 200 OK"
+  std::istringstream stream(statusLine.line);
+  std::string version;
+  HttpResponse response;
+  stream >> version >> response.status;
+  if (!version.starts_with("HTTP/1.") || response.status == 0) {
+    return std::nullopt;
+  }
+  response.close = version == "HTTP/1.0";
+
+  std::size_t contentLength = 0;
+  while (true) {
+    const auto header = connection.readLine();
+    if (header.status != TcpSocket::ReadStatus::line) {
+      return std::nullopt;
+    }
+    if (header.line.empty()) {
+      break;
+    }
+    const std::size_t colon = header.line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    std::string name = header.line.substr(0, colon);
+    std::ranges::transform(name, name.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    std::string_view value = std::string_view(header.line).substr(colon + 1);
+    while (!value.empty() && value.front() == ' ') {
+      value.remove_prefix(1);
+    }
+    if (name == "content-length") {
+      std::from_chars(value.data(), value.data() + value.size(), contentLength);
+    } else if (name == "connection") {
+      std::string token(value);
+      std::ranges::transform(token, token.begin(),
+                             [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+      response.close = token == "close";
+    }
+  }
+  if (contentLength > 0) {
+    auto body = connection.readExact(contentLength);
+    if (!body.has_value()) {
+      return std::nullopt;
+    }
+    response.body = std::move(*body);
+  }
+  return response;
+}
+
+// One worker's connection. Reuses it between requests when keep-alive is on
+// and the server agreed; a reused connection that turns out to be closed is
+// retried once on a fresh one (the server may drop idle connections).
+class HttpClient {
+public:
+  HttpClient(int port, bool keepAlive, Totals &totals)
+      : port_(port), keepAlive_(keepAlive), totals_(totals) {}
+
+  std::optional<HttpResponse> send(const ServerRouter::Request &request) {
+    const std::string bytes = render(request, keepAlive_);
+    for (int attempt = 0; attempt < 2; ++attempt) {
+      const bool reused = connection_.has_value();
+      if (!reused) {
+        connection_ = TcpSocket::Connection::connect(kHost, port_);
+        if (!connection_.has_value()) {
+          return std::nullopt;
+        }
+        connection_->setReceiveTimeout(std::chrono::seconds(5));
+        totals_.connects.fetch_add(1, std::memory_order_relaxed);
+      }
+      std::optional<HttpResponse> response;
+      if (connection_->sendAll(bytes)) {
+        response = readResponse(*connection_);
+      }
+      if (!response.has_value()) {
+        connection_.reset();
+        if (reused) {
+          continue;
+        }
+        return std::nullopt;
+      }
+      if (!keepAlive_ || response->close) {
+        if (keepAlive_) {
+          totals_.serverClosed.fetch_add(1, std::memory_order_relaxed);
+        }
+        connection_.reset();
+      }
+      return response;
+    }
+    return std::nullopt;
+  }
+
+private:
+  int port_;
+  bool keepAlive_;
+  Totals &totals_;
+  std::optional<TcpSocket::Connection> connection_;
+};
+
+// --- Phases ----------------------------------------------------------------------
+
+struct PhaseResult {
+  std::string name;
+  double seconds = 0.0;
+  std::uint64_t leaderboardOk = 0, leaderboardFailed = 0;
+  std::uint64_t scoresOk = 0, scoresFailed = 0;
+  LatencyHistogram::Counts leaderboardLatency{};
+  LatencyHistogram::Counts scoresLatency{};
+  std::uint64_t connects = 0;
+  std::uint64_t serverClosed = 0;
+
+  double requestsPerSecond() const {
+    const auto requests = leaderboardOk + leaderboardFailed + scoresOk + scoresFailed;
+    return seconds > 0.0 ? static_cast<double>(requests) / seconds : 0.0;
+  }
+};
+
+// Runs `options.concurrency` workers (each made by `makeWorker`) until the
+// duration lapses. Requests are printed from routes outside the timed region.
+PhaseResult runPhase(std::string name, const Options &options,
+                     const std::function<Worker(Totals &)> &makeWorker) {
+  Totals totals;
+  const auto began = Clock::now();
+  const auto deadline = began + options.duration;
+  {
+    std::vector<std::jthread> workers;
+    for (int w = 0; w < options.concurrency; ++w) {
+      workers.emplace_back([&, w] {
+        const Worker worker = makeWorker(totals);
+        std::mt19937_64 rng(static_cast<std::uint64_t>(w) + 1);
+        while (Clock::now() < deadline) {
+          const ServerRouter::Route route = nextRoute(rng, w, options.postRatio);
+          const ServerRouter::Request request = ServerRouter::print(route);
+          const auto start = Clock::now();
+          const bool ok = worker(request);
+          const auto elapsed = Clock::now() - start;
+          RouteStats &stats = std::holds_alternative<ServerRouter::FetchLeaderboard>(route)
+                                  ? totals.leaderboard
+                                  : totals.scores;
+          (ok ? stats.ok : stats.failed).fetch_add(1, std::memory_order_relaxed);
+          stats.latency.record(elapsed);
+        }
+      });
+    }
+  }
+  return PhaseResult{.name = std::move(name),
+                     .seconds = std::chrono::duration<double>(Clock::now() - began).count(),
+                     .leaderboardOk = totals.leaderboard.ok.load(),
+                     .leaderboardFailed = totals.leaderboard.failed.load(),
+                     .scoresOk = totals.scores.ok.load(),
+                     .scoresFailed = totals.scores.failed.load(),
+                     .leaderboardLatency = totals.leaderboard.latency.snapshot(),
+                     .scoresLatency = totals.scores.latency.snapshot(),
+                     .connects = totals.connects.load(),
+                     .serverClosed = totals.serverClosed.load()};
+}
+
+bool expectedStatus(const ServerRouter::Request &request, int status) {
+  return status == (request.method == "POST" ? 201 : 200);
+}
+
+std::optional<PhaseResult> middlewarePhase(const Options &options) {
+  const SiteMiddleware::Environment environment{.database = DatabaseClient::live(":memory:")};
+  if (!environment.database.migrate().has_value()) {
+    std::println(std::cerr, "FifteenHttpLoad: could not migrate the in-memory database");
+    return std::nullopt;
+  }
+  std::mt19937_64 rng(99);
+  for (int i = 0; i < options.seedScores; ++i) {
+    const auto route = nextRoute(rng, i, 1.0);
+    (void)environment.database.saveGame(std::get<ServerRouter::SubmitScore>(route).submission);
+  }
+  return runPhase("middleware", options, [&environment](Totals &) -> Worker {
+    return [&environment](const ServerRouter::Request &request) {
+      return expectedStatus(request, SiteMiddleware::respond(environment, request).status);
+    };
+  });
+}
+
+std::optional<PhaseResult> httpPhase(const Options &options) {
+  // Probe with a real request: HttpServer is sequential, so an idle probe
+  // connection would hold it until its read timeout.
+  Totals probe;
+  if (!HttpClient(options.port, false, probe)
+           .send(ServerRouter::print(ServerRouter::FetchLeaderboard{}))
+           .has_value()) {
+    std::println(std::cerr,
+                 "FifteenHttpLoad: no server on {}:{} — start FifteenServer (FIFTEEN_SERVER_PORT) "
+                 "or use --phase middleware",
+                 kHost, options.port);
+    return std::nullopt;
+  }
+  return runPhase("http", options, [&options](Totals &totals) -> Worker {
+    auto client = std::make_shared<HttpClient>(options.port, options.keepAlive, totals);
+    return [client](const ServerRouter::Request &request) {
+      const auto response = client->send(request);
+      return response.has_value() && expectedStatus(request, response->status);
+    };
+  });
+}
+
+void printPhase(const PhaseResult &result) {
+  std::println("\n== {} — {:.1f}s, {:.0f} req/s", result.name, result.seconds,
+               result.requestsPerSecond());
+  std::println("GET /leaderboard  ok {}  failed {}", result.leaderboardOk,
+               result.leaderboardFailed);
+  std::println("POST /scores      ok {}  failed {}", result.scoresOk, result.scoresFailed);
+  if (result.connects > 0) {
+    std::println("connections opened {}  closed by server despite keep-alive {}", result.connects,
+                 result.serverClosed);
+  }
+  Benchmark::printLatency("GET /leaderboard latency", result.leaderboardLatency);
+  Benchmark::printLatency("POST /scores latency", result.scoresLatency);
+}
+
+std::string routeJson(std::uint64_t ok, std::uint64_t failed,
+                      const LatencyHistogram::Counts &latency) {
+  return std::format("{{\"ok\": {}, \"failed\": {}, \"p50_ms\": {:.3f}, \"p90_ms\": {:.3f}, "
+                     "\"p99_ms\": {:.3f}, \"p999_ms\": {:.3f}}}",
+                     ok, failed, LatencyHistogram::percentile(latency, 0.50) / 1000.0,
+                     LatencyHistogram::percentile(latency, 0.90) / 1000.0,
+                     LatencyHistogram::percentile(latency, 0.99) / 1000.0,
+                     LatencyHistogram::percentile(latency, 0.999) / 1000.0);
+}
+
+// {"phases": [{"name", "seconds", "requests_per_second", "leaderboard": {...},
+// "scores": {...}, "connects", "server_closed"}, ...]}
+std::string toJson(std::span<const PhaseResult> results) {
+  std::string out = "{\n  \"phases\": [";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const PhaseResult &r = results[i];
+    out += std::format("{}\n    {{\"name\": \"{}\", \"seconds\": {:.2f}, "
+                       "\"requests_per_second\": {:.1f},\n     \"leaderboard\": {},\n"
+                       "     \"scores\": {},\n     \"connects\": {}, \"server_closed\": {}}}",
+                       i == 0 ? "" : ",", r.name, r.seconds, r.requestsPerSecond(),
+                       routeJson(r.leaderboardOk, r.leaderboardFailed, r.leaderboardLatency),
+                       routeJson(r.scoresOk, r.scoresFailed, r.scoresLatency), r.connects,
+                       r.serverClosed);
+  }
+  out += "\n  ]\n}\n";
+  return out;
+}
+
+std::optional<Options> parseOptions(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    if (arg == "--keep-alive") {
+      options.keepAlive = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      return std::nullopt;
+    }
+    const std::string_view value = argv[++i];
+    if (arg == "--phase") {
+      if (value == "all") {
+        options.phase = Phase::all;
+      } else if (value == "middleware") {
+        options.phase = Phase::middleware;
+      } else if (value == "http") {
+        options.phase = Phase::http;
+      } else {
+        return std::nullopt;
+      }
+    } else if (arg == "--concurrency") {
+      options.concurrency = std::max(1, std::atoi(argv[i]));
+    } else if (arg == "--duration") {
+      options.duration = std::chrono::seconds(std::max(1, std::atoi(argv[i])));
+    } else if (arg == "--post-ratio") {
+      options.postRatio = std::clamp(std::atof(argv[i]), 0.0, 1.0);
+    } else if (arg == "--port") {
+      options.port = std::atoi(argv[i]);
+    } else if (arg == "--seed-scores") {
+      options.seedScores = std::max(0, std::atoi(argv[i]));
+    } else if (arg == "--json") {
+      options.jsonPath = std::string(value);
+    } else {
+      return std::nullopt;
+    }
+  }
+  return options;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const auto parsed = parseOptions(argc, argv);
+  if (!parsed) {
+    std::println(std::cerr, "usage: FifteenHttpLoad [--phase all|middleware|http] "
+                            "[--concurrency N] [--duration <s>] [--post-ratio <fraction>] "
+                            "[--keep-alive] [--port P] [--seed-scores N] [--json <path>|-]");
+    return 2;
+  }
+  const Options options = *parsed;
+  std::println("FifteenHttpLoad: {} workers, {}s per phase, {:.0f}% POST /scores{}",
+               options.concurrency, options.duration.count(), options.postRatio * 100.0,
+               options.keepAlive ? ", keep-alive" : "");
+
+  std::vector<PhaseResult> results;
+  bool ok = true;
+  if (options.phase != Phase::http) {
+    if (auto result = middlewarePhase(options)) {
+      printPhase(*result);
+      results.push_back(std::move(*result));
+    } else {
+      ok = false;
+    }
+  }
+  if (options.phase != Phase::middleware) {
+    if (auto result = httpPhase(options)) {
+      printPhase(*result);
+      results.push_back(std::move(*result));
+    } else {
+      ok = false;
+    }
+  }
+
+  if (options.jsonPath) {
+    const std::string json = toJson(results);
+    if (*options.jsonPath == "-") {
+      std::print("{}", json);
+    } else {
+      std::ofstream out(*options.jsonPath, std::ios::binary | std::ios::trunc);
+      if (!out) {
+        std::println(std::cerr, "cannot write {}", *options.jsonPath);
+        return 1;
+      }
+      out << json;
+    }
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,619 @@
+// FifteenLoadGenerator — a soak harness for the multiplayer referee. Where
+// Bootstrap/e2e.py scripts a single two-player race, this opens thousands of
+// `TcpSocket::Connection`s to a GameServer on 127.0.0.1, joins random grids and
+// races: every player sends moves at a steady rate, a share of them play the
+// auto-solver's plan (so matches really finish and players re-queue), the rest
+// wander with random legal slides, and a handful of observers subscribe to the
+// live feed. It reports, every interval and at the end:
+//
+//  - relay latency: a player's `Move` send to its opponent's `OpponentMoved`
+//    receipt (both ends live in this process, so one steady clock times both);
+//  - moves/sec sent and relays/sec received, finished matches, rejected moves;
+//  - the server's resident memory (Linux /proc; n/a elsewhere);
+//  - with FIFTEEN_ALLOCATION_TRACKING and an in-process referee, the server's
+//    heap allocations per stage (decode / engine / encode), per move sent.
+//
+// By default the referee runs in this process (GameServer::run on `--port`), so
+// one command soaks it and the memory figure includes the generator itself.
+// `--server-pid <pid>` targets an already running FifteenServer on `--port`
+// instead and samples that process. Either way traffic never leaves localhost.
+//
+//   FifteenLoadGenerator [--players N] [--observers N] [--rate <moves/s>]
+//                        [--solvers <fraction>] [--max-grid G] [--connect-rate <conns/s>]
+//                        [--duration <s>] [--report-every <s>] [--port P]
+//                        [--server-pid <pid>] [--json <path>|-]
+//
+// Exits non-zero if the referee rejected any move (a desync between client and
+// server rules).
+
+#include <signal.h> // C headers: safe to mix with `import std` (see Sources/server/main.cpp)
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+import std;
+import AllocationTracking;
+import Benchmark;
+import Dependencies;
+import GameServer;
+import Metrics;
+import MultiplayerCore;
+import PuzzleCore;
+import SharedModels;
+import SolverClient;
+import SolverClientLive;
+import TcpSocket;
+
+namespace {
+
+using Benchmark::LatencyHistogram;
+using Clock = std::chrono::steady_clock;
+
+constexpr const char *kHost = "127.0.0.1"; // localhost only, by design
+
+struct Options {
+  int players = 1000;
+  int observers = 8;
+  double rate = 10.0;    // moves per second per player
+  double solvers = 0.5;  // fraction of players that follow the auto-solver
+  int maxGrid = 5;       // grids are drawn from [PuzzleCore::minGrid, maxGrid]
+  int connectRate = 500; // new connections per second during ramp-up
+  std::chrono::seconds duration{60};
+  std::chrono::seconds reportEvery{5};
+  int port = 18191;
+  std::optional<int> serverPid; // nullopt = host the referee in-process
+  std::optional<std::string> jsonPath;
+};
+
+std::stop_source shutdownSource;
+
+void onSignal(int) { shutdownSource.request_stop(); }
+
+std::int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch())
+      .count();
+}
+
+// --- Shared counters -------------------------------------------------------------
+
+struct Totals {
+  std::atomic<int> connected{0};
+  std::atomic<int> connectFailures{0};
+  std::atomic<int> refused{0}; // ServerFull
+  std::atomic<int> dropped{0}; // closed by the server mid-run
+  std::atomic<std::uint64_t> movesSent{0};
+  std::atomic<std::uint64_t> relays{0}; // OpponentMoved received
+  std::atomic<std::uint64_t> rejected{0};
+  std::atomic<std::uint64_t> matchesStarted{0};
+  std::atomic<std::uint64_t> matchesFinished{0}; // counted once, by the winner
+  std::atomic<std::uint64_t> walkovers{0};
+  std::atomic<std::uint64_t> feedMessages{0}; // received by observers
+  LatencyHistogram relayLatency;
+};
+
+// One player's send timestamps, indexed by move count. The opponent reads the
+// slot named by `OpponentMoved.moveCount`; a slot is always rewritten before
+// the move it times is sent, so a stale value from an earlier match is never
+// read for a relay of this one.
+struct SendClock {
+  static constexpr std::size_t kSlots = 1024; // far more than can be in flight
+  std::array<std::atomic<std::int64_t>, kSlots> sentAt{};
+
+  void stamp(int moveCount) {
+    sentAt[static_cast<std::size_t>(moveCount) % kSlots].store(nowNs(), std::memory_order_release);
+  }
+  std::int64_t sent(int moveCount) const {
+    return sentAt[static_cast<std::size_t>(moveCount) % kSlots].load(std::memory_order_acquire);
+  }
+};
+
+// --- Players ---------------------------------------------------------------------
+
+std::string playerName(int index) { return std::format("load-{}", index); }
+
+std::optional<int> playerIndex(std::string_view name) {
+  if (!name.starts_with("load-")) {
+    return std::nullopt;
+  }
+  name.remove_prefix(5);
+  int index = 0;
+  if (std::from_chars(name.data(), name.data() + name.size(), index).ec != std::errc{}) {
+    return std::nullopt;
+  }
+  return index;
+}
+
+bool send(TcpSocket::Connection &connection, MultiplayerCore::ClientMessage message) {
+  return connection.sendAll(MultiplayerCore::encode(message) + "\n");
+}
+
+struct Match {
+  int grid = 4;
+  std::vector<std::string> tiles;
+  std::vector<int> history;
+  std::vector<int> plan; // remaining auto-solver moves (solver players only)
+  std::size_t nextPlanned = 0;
+  int previousEmpty = -1;
+  std::optional<int> opponent;
+};
+
+// Deals the same board the server did and, for a solver player, plans the
+// solve from the scramble history (regenerated from the seed, exactly as
+// PuzzleCore::scrambled builds it).
+Match startMatch(const MultiplayerCore::Start &start, bool solver,
+                 const SolverClient::Client &planner) {
+  Match match;
+  match.grid = start.gridSize;
+  auto rng = Dependencies::RandomNumberGenerator::seeded(start.seed);
+  std::vector<int> scrambleHistory;
+  PuzzleCore::scramble(match.grid, rng, match.tiles, scrambleHistory,
+                       match.grid * match.grid * 10);
+  if (solver) {
+    if (auto plan = planner.plan(scrambleHistory, match.grid, SolverClient::PlanMode::fast, {},
+                                 {}, {});
+        plan.has_value()) {
+      match.plan = std::move(*plan);
+    }
+  }
+  match.opponent = playerIndex(start.opponentName);
+  return match;
+}
+
+// The next tap: the planned move if there is one, else a random legal slide
+// that doesn't immediately undo the last.
+std::optional<int> nextMove(Match &match, std::mt19937_64 &rng) {
+  if (match.nextPlanned < match.plan.size()) {
+    return match.plan[match.nextPlanned++];
+  }
+  const auto empty = PuzzleCore::emptyIndex(match.tiles);
+  if (!empty.has_value()) {
+    return std::nullopt;
+  }
+  auto options = PuzzleCore::neighbors(*empty, match.grid);
+  if (options.size() > 1) {
+    std::erase(options, match.previousEmpty);
+  }
+  return options[static_cast<std::size_t>(rng() % options.size())];
+}
+
+struct Player {
+  int index = 0;
+  bool solver = false;
+  SendClock clock;
+};
+
+void runPlayer(Player &self, std::span<Player> players, Totals &totals, const Options &options,
+               std::stop_token stop) {
+  auto connection = TcpSocket::Connection::connect(kHost, options.port);
+  if (!connection.has_value()) {
+    totals.connectFailures.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  totals.connected.fetch_add(1, std::memory_order_relaxed);
+
+  std::mt19937_64 rng(static_cast<std::uint64_t>(self.index) * 0x9E3779B97F4A7C15ULL + 1);
+  const SolverClient::Client planner = SolverClient::live();
+  const auto interval = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / std::max(options.rate, 0.001)));
+  const int grids = std::max(1, options.maxGrid - PuzzleCore::minGrid + 1);
+  const auto join = [&] {
+    const int grid = PuzzleCore::minGrid + static_cast<int>(rng() % static_cast<unsigned>(grids));
+    return send(*connection,
+                MultiplayerCore::Join{.name = playerName(self.index), .gridSize = grid});
+  };
+
+  std::optional<Match> match;
+  Clock::time_point nextMoveAt{};
+  bool open = join();
+
+  while (open && !stop.stop_requested()) {
+    // Block for the next server line, but no longer than until our next move.
+    const auto wait = match ? std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  nextMoveAt - Clock::now())
+                            : std::chrono::milliseconds(250);
+    connection->setReceiveTimeout(
+        std::clamp(wait, std::chrono::milliseconds(1), std::chrono::milliseconds(250)));
+    const auto read = connection->readLine();
+    if (read.status == TcpSocket::ReadStatus::closed) {
+      totals.dropped.fetch_add(1, std::memory_order_relaxed);
+      break;
+    }
+    if (read.status == TcpSocket::ReadStatus::line) {
+      const auto message = MultiplayerCore::decodeServerMessage(read.line);
+      if (!message.has_value()) {
+        continue;
+      }
+      if (const auto *start = std::get_if<MultiplayerCore::Start>(&*message)) {
+        match = startMatch(*start, self.solver, planner);
+        // Stagger the first move so a full lobby doesn't tick in lockstep.
+        nextMoveAt = Clock::now() + interval * static_cast<int>(rng() % 1000) / 1000;
+        totals.matchesStarted.fetch_add(1, std::memory_order_relaxed);
+      } else if (const auto *moved = std::get_if<MultiplayerCore::OpponentMoved>(&*message)) {
+        totals.relays.fetch_add(1, std::memory_order_relaxed);
+        if (match && match->opponent && *match->opponent < static_cast<int>(players.size())) {
+          const std::int64_t sent =
+              players[static_cast<std::size_t>(*match->opponent)].clock.sent(moved->moveCount);
+          if (sent > 0) {
+            totals.relayLatency.record(std::chrono::nanoseconds(nowNs() - sent));
+          }
+        }
+      } else if (std::holds_alternative<MultiplayerCore::MoveRejected>(*message)) {
+        totals.rejected.fetch_add(1, std::memory_order_relaxed);
+      } else if (const auto *finished = std::get_if<MultiplayerCore::Finished>(&*message)) {
+        if (finished->youWon) {
+          totals.matchesFinished.fetch_add(1, std::memory_order_relaxed);
+        }
+        match.reset();
+        open = join(); // straight back into the queue, on a fresh random grid
+      } else if (std::holds_alternative<MultiplayerCore::OpponentLeft>(*message)) {
+        totals.walkovers.fetch_add(1, std::memory_order_relaxed);
+        match.reset();
+        open = join();
+      } else if (std::holds_alternative<MultiplayerCore::ServerFull>(*message)) {
+        totals.refused.fetch_add(1, std::memory_order_relaxed);
+        break;
+      }
+    }
+
+    if (match && Clock::now() >= nextMoveAt) {
+      const auto empty = PuzzleCore::emptyIndex(match->tiles);
+      const auto tap = nextMove(*match, rng);
+      if (tap && PuzzleCore::slide(match->tiles, match->history, match->grid, *tap)) {
+        match->previousEmpty = empty.value_or(-1);
+        self.clock.stamp(static_cast<int>(match->history.size()));
+        open = send(*connection, MultiplayerCore::Move{.index = *tap});
+        totals.movesSent.fetch_add(1, std::memory_order_relaxed);
+      }
+      // Keep the cadence, but don't burst to catch up after a stall.
+      nextMoveAt = std::max(nextMoveAt + interval, Clock::now());
+    }
+  }
+
+  if (open) {
+    send(*connection, MultiplayerCore::Leave{});
+  }
+  connection->close();
+  totals.connected.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void runObserver(Totals &totals, const Options &options, std::stop_token stop) {
+  auto connection = TcpSocket::Connection::connect(kHost, options.port);
+  if (!connection.has_value() || !send(*connection, MultiplayerCore::Observe{})) {
+    totals.connectFailures.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  totals.connected.fetch_add(1, std::memory_order_relaxed);
+  connection->setReceiveTimeout(std::chrono::milliseconds(250));
+  while (!stop.stop_requested()) {
+    const auto read = connection->readLine();
+    if (read.status == TcpSocket::ReadStatus::closed) {
+      totals.dropped.fetch_add(1, std::memory_order_relaxed);
+      break;
+    }
+    if (read.status == TcpSocket::ReadStatus::line) {
+      totals.feedMessages.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  connection->close();
+  totals.connected.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// --- Reporting -------------------------------------------------------------------
+
+// Resident set size of `pid` (0 = this process) in bytes, from /proc. Nullopt
+// where /proc isn't available (macOS, Windows).
+std::optional<std::uint64_t> residentBytes(int pid) {
+  const std::string path =
+      pid == 0 ? std::string("/proc/self/status") : std::format("/proc/{}/status", pid);
+  std::ifstream status(path);
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.starts_with("VmRSS:")) {
+      std::uint64_t kilobytes = 0;
+      const auto digits = line.find_first_of("0123456789");
+      if (digits != std::string::npos &&
+          std::from_chars(line.data() + digits, line.data() + line.size(), kilobytes).ec ==
+              std::errc{}) {
+        return kilobytes * 1024;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::string formatMemory(std::optional<std::uint64_t> bytes) {
+  return bytes ? std::format("{:.1f} MiB", static_cast<double>(*bytes) / (1024.0 * 1024.0))
+               : std::string("n/a");
+}
+
+// The referee's per-scope allocation counters, read back from the metrics
+// scrape (`fifteen_allocations_total{scope="decode"} 123`).
+void printAllocationScopes(std::uint64_t movesSent) {
+  std::map<std::string, std::pair<std::uint64_t, std::uint64_t>> scopes; // allocs, bytes
+  std::istringstream scrape(Metrics::scrape());
+  for (std::string line; std::getline(scrape, line);) {
+    const bool allocations = line.starts_with("fifteen_allocations_total{scope=\"");
+    const bool bytes = line.starts_with("fifteen_allocated_bytes_total{scope=\"");
+    if (!allocations && !bytes) {
+      continue;
+    }
+    const std::size_t open = line.find('"') + 1;
+    const std::string scope = line.substr(open, line.find('"', open) - open);
+    const std::uint64_t value = std::stoull(line.substr(line.rfind(' ') + 1));
+    (allocations ? scopes[scope].first : scopes[scope].second) = value;
+  }
+  const double moves = static_cast<double>(std::max<std::uint64_t>(movesSent, 1));
+  std::println("server allocations by scope:");
+  for (const auto &[scope, totals] : scopes) {
+    std::println("  {:<8} {:>12} allocs ({:>7.2f}/move) {:>14} B ({:>9.1f}/move)", scope,
+                 totals.first, static_cast<double>(totals.first) / moves, totals.second,
+                 static_cast<double>(totals.second) / moves);
+  }
+}
+
+struct Sample {
+  double seconds = 0.0;
+  std::uint64_t movesSent = 0;
+  std::uint64_t relays = 0;
+  LatencyHistogram::Counts latency{};
+};
+
+Sample sample(const Totals &totals, Clock::time_point began) {
+  return Sample{.seconds = std::chrono::duration<double>(Clock::now() - began).count(),
+                .movesSent = totals.movesSent.load(std::memory_order_relaxed),
+                .relays = totals.relays.load(std::memory_order_relaxed),
+                .latency = totals.relayLatency.snapshot()};
+}
+
+void printInterval(const Totals &totals, const Sample &from, const Sample &to,
+                   std::optional<std::uint64_t> memory) {
+  const double span = std::max(1e-9, to.seconds - from.seconds);
+  const auto latency = LatencyHistogram::minus(to.latency, from.latency);
+  std::println("{:>7.1f}s  conns {:>6}  moves/s {:>9.0f}  relays/s {:>9.0f}  relay p50 {:>7.3f}ms "
+               "p99 {:>7.3f}ms  finished {:>6}  rss {}",
+               to.seconds, totals.connected.load(std::memory_order_relaxed),
+               static_cast<double>(to.movesSent - from.movesSent) / span,
+               static_cast<double>(to.relays - from.relays) / span,
+               LatencyHistogram::percentile(latency, 0.50) / 1000.0,
+               LatencyHistogram::percentile(latency, 0.99) / 1000.0,
+               totals.matchesFinished.load(std::memory_order_relaxed), formatMemory(memory));
+}
+
+struct Summary {
+  double seconds = 0.0;
+  double movesPerSecond = 0.0;
+  double relaysPerSecond = 0.0;
+  double p50Ms = 0.0, p90Ms = 0.0, p99Ms = 0.0, p999Ms = 0.0;
+  std::optional<std::uint64_t> peakMemory;
+  std::optional<std::uint64_t> finalMemory;
+};
+
+// {"load": {...}}: flat numbers, so two soak runs diff cleanly.
+std::string toJson(const Options &options, const Totals &totals, const Summary &summary) {
+  const auto memory = [](std::optional<std::uint64_t> bytes) {
+    return bytes ? std::to_string(*bytes) : std::string("null");
+  };
+  return std::format(
+      "{{\n  \"load\": {{\"players\": {}, \"observers\": {}, \"rate\": {:.2f}, "
+      "\"seconds\": {:.2f},\n    \"moves_per_second\": {:.1f}, \"relays_per_second\": {:.1f},\n"
+      "    \"relay_p50_ms\": {:.3f}, \"relay_p90_ms\": {:.3f}, \"relay_p99_ms\": {:.3f}, "
+      "\"relay_p999_ms\": {:.3f},\n    \"matches_started\": {}, \"matches_finished\": {}, "
+      "\"walkovers\": {}, \"rejected\": {},\n    \"connect_failures\": {}, \"refused\": {}, "
+      "\"dropped\": {}, \"feed_messages\": {},\n    \"peak_rss_bytes\": {}, "
+      "\"final_rss_bytes\": {}}}\n}}\n",
+      options.players, options.observers, options.rate, summary.seconds, summary.movesPerSecond,
+      summary.relaysPerSecond, summary.p50Ms, summary.p90Ms, summary.p99Ms, summary.p999Ms,
+      totals.matchesStarted.load() / 2, totals.matchesFinished.load(), totals.walkovers.load(),
+      totals.rejected.load(), totals.connectFailures.load(), totals.refused.load(),
+      totals.dropped.load(), totals.feedMessages.load(), memory(summary.peakMemory),
+      memory(summary.finalMemory));
+}
+
+std::optional<Options> parseOptions(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (!hasValue) {
+      return std::nullopt;
+    }
+    const char *value = argv[++i];
+    if (arg == "--players") {
+      options.players = std::max(0, std::atoi(value));
+    } else if (arg == "--observers") {
+      options.observers = std::max(0, std::atoi(value));
+    } else if (arg == "--rate") {
+      options.rate = std::atof(value);
+    } else if (arg == "--solvers") {
+      options.solvers = std::clamp(std::atof(value), 0.0, 1.0);
+    } else if (arg == "--max-grid") {
+      options.maxGrid = std::clamp(std::atoi(value), PuzzleCore::minGrid, PuzzleCore::maxGrid);
+    } else if (arg == "--connect-rate") {
+      options.connectRate = std::max(1, std::atoi(value));
+    } else if (arg == "--duration") {
+      options.duration = std::chrono::seconds(std::max(1, std::atoi(value)));
+    } else if (arg == "--report-every") {
+      options.reportEvery = std::chrono::seconds(std::max(1, std::atoi(value)));
+    } else if (arg == "--port") {
+      options.port = std::atoi(value);
+    } else if (arg == "--server-pid") {
+      options.serverPid = std::atoi(value);
+    } else if (arg == "--json") {
+      options.jsonPath = value;
+    } else {
+      return std::nullopt;
+    }
+  }
+  return options;
+}
+
+// Each connection is a socket here and (in-process) another on the server
+// side; the default soft limit of 1024 descriptors is well short of that.
+void raiseDescriptorLimit([[maybe_unused]] int wanted) {
+#if !defined(_WIN32)
+  rlimit limit{};
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < static_cast<rlim_t>(wanted)) {
+    limit.rlim_cur = std::min(limit.rlim_max, static_cast<rlim_t>(wanted));
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+#endif
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const auto parsed = parseOptions(argc, argv);
+  if (!parsed) {
+    std::println(std::cerr,
+                 "usage: FifteenLoadGenerator [--players N] [--observers N] [--rate <moves/s>] "
+                 "[--solvers <fraction>] [--max-grid G] [--connect-rate <conns/s>] "
+                 "[--duration <s>] [--report-every <s>] [--port P] [--server-pid <pid>] "
+                 "[--json <path>|-]");
+    return 2;
+  }
+  const Options options = *parsed;
+
+  signal(SIGINT, &onSignal);
+  signal(SIGTERM, &onSignal);
+#if defined(SIGPIPE)
+  signal(SIGPIPE, SIG_IGN);
+#endif
+  raiseDescriptorLimit(2 * (options.players + options.observers) + 64);
+
+  // In-process referee, wired like Sources/server/main.cpp but with no
+  // connection cap, and results and deals discarded (no database, no solver).
+  std::optional<std::jthread> server;
+  if (!options.serverPid) {
+    Dependencies::prepareDependencies([](Dependencies::DependencyValues &values) {
+      (void)values.get<Dependencies::DateGeneratorKey>();
+      (void)values.get<Dependencies::RandomNumberGeneratorKey>();
+    });
+    server.emplace([port = options.port](std::stop_token) {
+      if (!GameServer::run(
+              port, [](const SharedModels::ScoreSubmission &) {}, [](const GameServer::Deal &) {},
+              0, shutdownSource.get_token())) {
+        std::println(std::cerr, "FifteenLoadGenerator: could not bind port {}", port);
+        shutdownSource.request_stop();
+      }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100)); // let it bind
+  }
+  const int memoryPid = options.serverPid.value_or(0);
+
+  std::println("FifteenLoadGenerator: {} players ({:.0f}% solvers) + {} observers at {:.1f} "
+               "moves/s each, grids {}..{}, {}s on {}:{} ({})",
+               options.players, options.solvers * 100.0, options.observers, options.rate,
+               PuzzleCore::minGrid, options.maxGrid, options.duration.count(), kHost, options.port,
+               options.serverPid ? std::format("server pid {}", *options.serverPid)
+                                 : std::string("in-process referee"));
+
+  Totals totals;
+  std::vector<Player> players(static_cast<std::size_t>(options.players));
+  for (int i = 0; i < options.players; ++i) {
+    Player &player = players[static_cast<std::size_t>(i)];
+    player.index = i;
+    player.solver = static_cast<double>(i % 100) < options.solvers * 100.0;
+  }
+
+  const auto began = Clock::now();
+  const auto deadline = began + options.duration;
+  std::stop_source runStop;
+  std::stop_callback forward(shutdownSource.get_token(), [&runStop] { runStop.request_stop(); });
+
+  std::vector<std::jthread> threads;
+  threads.reserve(players.size() + static_cast<std::size_t>(options.observers));
+  for (int i = 0; i < options.observers; ++i) {
+    threads.emplace_back(
+        [&totals, &options, stop = runStop.get_token()] { runObserver(totals, options, stop); });
+  }
+
+  Sample previous = sample(totals, began);
+  auto nextReport = began + options.reportEvery;
+  std::optional<std::uint64_t> peakMemory;
+  const auto report = [&] {
+    const Sample current = sample(totals, began);
+    const auto memory = residentBytes(memoryPid);
+    if (memory) {
+      peakMemory = std::max(peakMemory.value_or(0), *memory);
+    }
+    printInterval(totals, previous, current, memory);
+    previous = current;
+  };
+
+  // Ramp up at `connectRate` (the listener's backlog is finite, and a real
+  // lobby fills over time too), reporting as we go.
+  const auto connectGap = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / options.connectRate));
+  auto nextConnect = Clock::now();
+  std::size_t launched = 0;
+  while (!runStop.stop_requested() && Clock::now() < deadline) {
+    const auto now = Clock::now();
+    while (launched < players.size() && nextConnect <= now) {
+      Player &player = players[launched++];
+      threads.emplace_back([&player, &players, &totals, &options, stop = runStop.get_token()] {
+        runPlayer(player, players, totals, options, stop);
+      });
+      nextConnect += connectGap;
+    }
+    if (now >= nextReport) {
+      report();
+      nextReport += options.reportEvery;
+    }
+    const bool ramping = launched < players.size();
+    std::this_thread::sleep_for(ramping ? std::min<Clock::duration>(connectGap,
+                                                                    std::chrono::milliseconds(10))
+                                        : Clock::duration{std::chrono::milliseconds(50)});
+  }
+
+  runStop.request_stop();
+  const Sample last = sample(totals, began);
+  const auto finalMemory = residentBytes(memoryPid);
+  threads.clear(); // joins; every player notices the stop within its receive timeout
+
+  shutdownSource.request_stop();
+  server.reset();
+
+  Summary summary{.seconds = last.seconds,
+                  .movesPerSecond = static_cast<double>(last.movesSent) / last.seconds,
+                  .relaysPerSecond = static_cast<double>(last.relays) / last.seconds,
+                  .p50Ms = LatencyHistogram::percentile(last.latency, 0.50) / 1000.0,
+                  .p90Ms = LatencyHistogram::percentile(last.latency, 0.90) / 1000.0,
+                  .p99Ms = LatencyHistogram::percentile(last.latency, 0.99) / 1000.0,
+                  .p999Ms = LatencyHistogram::percentile(last.latency, 0.999) / 1000.0,
+                  .peakMemory = peakMemory,
+                  .finalMemory = finalMemory};
+  if (finalMemory) {
+    summary.peakMemory = std::max(peakMemory.value_or(0), *finalMemory);
+  }
+
+  std::println("\n{:.1f}s: {:.0f} moves/s, {:.0f} relays/s; relay p50 {:.3f}ms p90 {:.3f}ms "
+               "p99 {:.3f}ms p99.9 {:.3f}ms",
+               summary.seconds, summary.movesPerSecond, summary.relaysPerSecond, summary.p50Ms,
+               summary.p90Ms, summary.p99Ms, summary.p999Ms);
+  std::println("matches {} started, {} finished, {} walkovers; {} rejected moves; {} connect "
+               "failures, {} refused, {} dropped; {} feed messages",
+               totals.matchesStarted.load() / 2, totals.matchesFinished.load(),
+               totals.walkovers.load(), totals.rejected.load(), totals.connectFailures.load(),
+               totals.refused.load(), totals.dropped.load(), totals.feedMessages.load());
+  std::println("rss peak {}, final {}", formatMemory(summary.peakMemory),
+               formatMemory(summary.finalMemory));
+  if (AllocationTracking::kEnabled && !options.serverPid) {
+    printAllocationScopes(last.movesSent);
+  }
+  Benchmark::printLatency("relay latency", last.latency);
+
+  if (options.jsonPath) {
+    const std::string json = toJson(options, totals, summary);
+    if (*options.jsonPath == "-") {
+      std::print("{}", json);
+    } else {
+      std::ofstream out(*options.jsonPath, std::ios::binary | std::ios::trunc);
+      if (!out) {
+        std::println(std::cerr, "cannot write {}", *options.jsonPath);
+        return 1;
+      }
+      out << json;
+    }
+  }
+  return totals.rejected.load() == 0 ? 0 : 1;
+}
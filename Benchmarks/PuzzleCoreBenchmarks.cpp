@@ -0,0 +1,99 @@
+// PuzzleCore kernels: dealing a board (scramble / scrambled) across the grid
+// range, and the per-move primitives the client and the referee run on every
+// tap (slide, isSolved, emptyIndex), plus what a solver does per node: update
+// the walking distance and probe or store in the transposition table.
+
+import std;
+import Benchmark;
+import Dependencies;
+import PuzzleCore;
+
+void registerPuzzleCoreBenchmarks(Benchmark::Suite &suite) {
+  for (const int grid : {4, 8, PuzzleCore::maxGrid}) {
+    suite.add(std::format("PuzzleCore.scrambled/{}", grid), [grid](std::uint64_t iterations) {
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        Benchmark::doNotOptimize(PuzzleCore::scrambled(grid, i));
+      }
+    });
+
+    suite.add(std::format("PuzzleCore.scramble/{}", grid), [grid](std::uint64_t iterations) {
+      auto rng = Dependencies::RandomNumberGenerator::seeded(42);
+      std::vector<std::string> tiles;
+      std::vector<int> history;
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        PuzzleCore::scramble(grid, rng, tiles, history, grid * grid * 10);
+        Benchmark::doNotOptimize(tiles);
+      }
+    });
+
+    // Shuttles the tile left of the hole back and forth; the history is reset
+    // periodically so it measures the move, not vector growth.
+    suite.add(std::format("PuzzleCore.slide/{}", grid), [grid](std::uint64_t iterations) {
+      auto tiles = PuzzleCore::solvedTiles(grid);
+      std::vector<int> history;
+      history.reserve(4096);
+      const int last = grid * grid - 1;
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        if (history.size() == 4096) {
+          history.clear();
+        }
+        Benchmark::doNotOptimize(
+            PuzzleCore::slide(tiles, history, grid, (i & 1) == 0 ? last - 1 : last));
+      }
+    });
+
+    // Solved is the worst case: every tile is compared.
+    suite.add(std::format("PuzzleCore.isSolved/{}", grid), [grid](std::uint64_t iterations) {
+      const auto tiles = PuzzleCore::solvedTiles(grid);
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        Benchmark::doNotOptimize(PuzzleCore::isSolved(tiles, grid));
+      }
+    });
+
+    // The hole of a solved board is the last cell: the longest scan.
+    suite.add(std::format("PuzzleCore.emptyIndex/{}", grid), [grid](std::uint64_t iterations) {
+      const auto tiles = PuzzleCore::solvedTiles(grid);
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        Benchmark::doNotOptimize(PuzzleCore::emptyIndex(tiles));
+      }
+    });
+  }
+
+  // The first call pays for generating the tables; this measures the one-off.
+  suite.add("PuzzleCore.walkingDistance.stateOf", [](std::uint64_t iterations) {
+    const auto &wd = PuzzleCore::WalkingDistance::tables();
+    const auto board = *PuzzleCore::boardFromTiles(PuzzleCore::scrambled(4, 42), 4);
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+      Benchmark::doNotOptimize(wd.stateOf(board));
+    }
+  });
+
+  // What an IDA* node costs: slide, update the state, read the bound.
+  suite.add("PuzzleCore.walkingDistance.afterSlide", [](std::uint64_t iterations) {
+    const auto &wd = PuzzleCore::WalkingDistance::tables();
+    auto board = *PuzzleCore::boardFromTiles(PuzzleCore::scrambled(4, 42), 4);
+    auto state = wd.stateOf(board);
+    const int home = board.blank;
+    const int other = home % 4 == 0 ? home + 1 : home - 1;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+      const int cell = board.blank == home ? other : home;
+      state = wd.afterSlide(state, board, cell);
+      PuzzleCore::slide(board, cell);
+      Benchmark::doNotOptimize(wd.distance(state));
+    }
+  });
+
+  // A table far bigger than the cache, as in a real search: mostly misses to
+  // memory. Keys are Zobrist hashes of a random walk.
+  suite.add("PuzzleCore.transpositionTable.storeProbe", [](std::uint64_t iterations) {
+    PuzzleCore::TranspositionTable table(std::size_t{64} << 20);
+    auto rng = Dependencies::RandomNumberGenerator::seeded(42);
+    auto board = PuzzleCore::solvedBoard(4);
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+      const auto options = PuzzleCore::neighbors(board.blank, 4);
+      PuzzleCore::slide(board, options[static_cast<std::size_t>(rng() % options.size())]);
+      table.store(board.hash, PuzzleCore::TranspositionTable::Entry{.bound = 1});
+      Benchmark::doNotOptimize(table.probe(board.hash ^ 1));
+    }
+  });
+}
@@ -0,0 +1,241 @@
+// FifteenSeedAnalyzer — offline analytics for dealt boards. For every seed in a
+// range and every grid size, it deals the board exactly as the server does
+// (`PuzzleCore::scrambled`) and measures how hard it is: the length of an
+// optimal solution where one can be proved, otherwise the best plan found and
+// a lower bound. Deals are spread over a pool of worker threads (one per core
+// by default) that share one live SolverClient, so a 64-core box works through
+// a range 64 deals at a time. Large grids are dealt out first, so no slow deal
+// is left running alone at the end.
+//
+// Per deal: a `hint` within `--hint-budget` (exact on most 4×4 deals; a lower
+// bound elsewhere), then, unless that was exact, a `search` within `--memory`
+// (optimal if its frontiers fit, near-optimal otherwise).
+//
+//   FifteenSeedAnalyzer [--grids G|G1-G2] [--first-seed S] [--seeds N] [--threads N]
+//                       [--hint-budget <ms>] [--memory <MB>] [--out <path>]
+//
+// The output file is columnar, little-endian, one row per deal in (grid, seed)
+// order:
+//
+//   "FSA1"  u64 rows
+//   seed    u64[rows]
+//   grid    u8[rows]
+//   length  u16[rows]   moves in the best plan found (0: none found)
+//   bound   u16[rows]   no solution is shorter than this
+//   optimal u8[rows]    1 when length == bound is proved
+//   nodes   u64[rows]   boards the searches expanded
+//   micros  u64[rows]   wall time for the deal
+//
+// A summary per grid (length percentiles, for difficulty bands) goes to stdout.
+
+import std;
+import PuzzleCore;
+import SolverClient;
+import SolverClientLive;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  int minGrid = PuzzleCore::minGrid;
+  int maxGrid = PuzzleCore::minGrid;
+  std::uint64_t firstSeed = 1;
+  std::uint64_t seeds = 1'000;
+  int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  std::chrono::milliseconds hintBudget{10'000};
+  std::size_t memory = std::size_t{128} << 20; // per worker
+  std::string outPath = "seeds.fsa";
+};
+
+struct Columns {
+  std::vector<std::uint64_t> seed;
+  std::vector<std::uint8_t> grid;
+  std::vector<std::uint16_t> length;
+  std::vector<std::uint16_t> bound;
+  std::vector<std::uint8_t> optimal;
+  std::vector<std::uint64_t> nodes;
+  std::vector<std::uint64_t> micros;
+
+  explicit Columns(std::size_t rows)
+      : seed(rows), grid(rows), length(rows), bound(rows), optimal(rows), nodes(rows),
+        micros(rows) {}
+};
+
+// Fills row `row` of `columns` (each worker writes only its own rows).
+void analyzeDeal(const SolverClient::Client &client, const Options &options, int grid,
+                 std::uint64_t seed, std::size_t row, Columns &columns) {
+  const auto start = Clock::now();
+  const auto tiles = PuzzleCore::scrambled(grid, seed);
+  int length = 0;
+  int bound = 0;
+  bool optimal = false;
+  std::uint64_t nodes = 0;
+  if (const auto hint = client.hint(tiles, grid, options.hintBudget, std::stop_token{})) {
+    bound = hint->distance;
+    optimal = hint->optimal;
+    length = optimal ? hint->distance : 0;
+    nodes += hint->nodes;
+  }
+  if (!optimal) {
+    if (const auto plan = client.search(tiles, grid, options.memory, std::stop_token{})) {
+      length = static_cast<int>(plan->moves.size());
+      optimal = plan->optimal;
+      bound = optimal ? length : bound;
+      nodes += plan->stats.nodes;
+    }
+  }
+  columns.seed[row] = seed;
+  columns.grid[row] = static_cast<std::uint8_t>(grid);
+  columns.length[row] = static_cast<std::uint16_t>(length);
+  columns.bound[row] = static_cast<std::uint16_t>(bound);
+  columns.optimal[row] = optimal ? 1 : 0;
+  columns.nodes[row] = nodes;
+  columns.micros[row] = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+}
+
+template <class T> void writeColumn(std::ofstream &out, const std::vector<T> &column) {
+  for (T value : column) {
+    if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1) {
+      value = std::byteswap(value);
+    }
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+}
+
+bool writeColumns(const std::string &path, const Columns &columns) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return false;
+  }
+  out.write("FSA1", 4);
+  writeColumn(out, std::vector<std::uint64_t>{columns.seed.size()});
+  writeColumn(out, columns.seed);
+  writeColumn(out, columns.grid);
+  writeColumn(out, columns.length);
+  writeColumn(out, columns.bound);
+  writeColumn(out, columns.optimal);
+  writeColumn(out, columns.nodes);
+  writeColumn(out, columns.micros);
+  return static_cast<bool>(out);
+}
+
+void printSummary(const Options &options, const Columns &columns) {
+  std::println("{:>5} {:>7} {:>8} {:>6} {:>6} {:>6} {:>6} {:>6} {:>9}", "grid", "deals",
+               "optimal", "min", "p10", "p50", "p90", "max", "mean ms");
+  for (int grid = options.minGrid; grid <= options.maxGrid; ++grid) {
+    std::vector<std::uint16_t> lengths;
+    std::size_t optimal = 0;
+    std::uint64_t micros = 0;
+    for (std::size_t row = 0; row < columns.grid.size(); ++row) {
+      if (columns.grid[row] == grid && columns.length[row] > 0) {
+        lengths.push_back(columns.length[row]);
+        optimal += columns.optimal[row];
+        micros += columns.micros[row];
+      }
+    }
+    if (lengths.empty()) {
+      continue;
+    }
+    std::ranges::sort(lengths);
+    const auto at = [&lengths](double q) {
+      return lengths[static_cast<std::size_t>(q * static_cast<double>(lengths.size() - 1))];
+    };
+    std::println("{:>5} {:>7} {:>8} {:>6} {:>6} {:>6} {:>6} {:>6} {:>9.1f}", grid,
+                 lengths.size(), optimal, lengths.front(), at(0.10), at(0.50), at(0.90),
+                 lengths.back(),
+                 static_cast<double>(micros) / 1000.0 / static_cast<double>(lengths.size()));
+  }
+}
+
+std::optional<Options> parseOptions(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (!hasValue) {
+      return std::nullopt;
+    }
+    const char *value = argv[++i];
+    if (arg == "--grids") {
+      const std::string_view range = value;
+      const auto dash = range.find('-');
+      options.minGrid = std::atoi(std::string(range.substr(0, dash)).c_str());
+      options.maxGrid = dash == std::string_view::npos
+                            ? options.minGrid
+                            : std::atoi(std::string(range.substr(dash + 1)).c_str());
+      if (options.minGrid < 2 || options.minGrid > options.maxGrid ||
+          options.maxGrid > PuzzleCore::maxGrid) {
+        return std::nullopt;
+      }
+    } else if (arg == "--first-seed") {
+      options.firstSeed = std::strtoull(value, nullptr, 10);
+    } else if (arg == "--seeds") {
+      options.seeds = std::max<std::uint64_t>(1, std::strtoull(value, nullptr, 10));
+    } else if (arg == "--threads") {
+      options.threads = std::max(1, std::atoi(value));
+    } else if (arg == "--hint-budget") {
+      options.hintBudget = std::chrono::milliseconds(std::max(1, std::atoi(value)));
+    } else if (arg == "--memory") {
+      options.memory = std::size_t{std::strtoull(value, nullptr, 10)} << 20;
+    } else if (arg == "--out") {
+      options.outPath = value;
+    } else {
+      return std::nullopt;
+    }
+  }
+  return options;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const auto parsed = parseOptions(argc, argv);
+  if (!parsed) {
+    std::println(std::cerr, "usage: FifteenSeedAnalyzer [--grids G|G1-G2] [--first-seed S] "
+                            "[--seeds N] [--threads N] [--hint-budget <ms>] [--memory <MB>] "
+                            "[--out <path>]");
+    return 2;
+  }
+  const Options options = *parsed;
+  const auto grids = static_cast<std::size_t>(options.maxGrid - options.minGrid + 1);
+  const std::size_t rows = grids * options.seeds;
+  std::println("FifteenSeedAnalyzer: grids {}–{}, seeds {}–{}, {} deals on {} threads",
+               options.minGrid, options.maxGrid, options.firstSeed,
+               options.firstSeed + options.seeds - 1, rows, options.threads);
+
+  const SolverClient::Client client = SolverClient::live(); // one shared hint table
+  Columns columns(rows);
+  std::atomic<std::size_t> next = 0;
+  std::atomic<std::size_t> done = 0;
+  const auto started = Clock::now();
+  {
+    std::vector<std::jthread> workers;
+    for (int t = 0; t < options.threads; ++t) {
+      workers.emplace_back([&] {
+        // Rows are in (grid, seed) order; take them from the end, largest grid first.
+        for (std::size_t taken = next++; taken < rows; taken = next++) {
+          const std::size_t row = rows - 1 - taken;
+          const int grid = options.minGrid + static_cast<int>(row / options.seeds);
+          analyzeDeal(client, options, grid, options.firstSeed + row % options.seeds, row,
+                      columns);
+          if (const std::size_t finished = ++done; finished % 100 == 0) {
+            std::println(std::cerr, "{}/{} deals", finished, rows);
+          }
+        }
+      });
+    }
+  }
+  const double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+  std::println("{} deals in {:.1f}s ({:.1f} deals/s)", rows, seconds,
+               static_cast<double>(rows) / seconds);
+  printSummary(options, columns);
+
+  if (!writeColumns(options.outPath, columns)) {
+    std::println(std::cerr, "cannot write {}", options.outPath);
+    return 1;
+  }
+  std::println("wrote {}", options.outPath);
+  return 0;
+}
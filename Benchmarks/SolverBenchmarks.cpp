@@ -0,0 +1,54 @@
+// Auto-solve planner kernels: the live planner on long recorded histories (a
+// 13×13 deal is 1690 moves; a long idle-scrambling session can be far more),
+// a 4×4 hint searched cold versus answered from the table, and the best-first
+// search on 4×4 and (falling back to weighted A*) 5×5.
+
+import std;
+import Benchmark;
+import Dependencies;
+import PuzzleCore;
+import SolverClient;
+import SolverClientLive;
+
+void registerSolverBenchmarks(Benchmark::Suite &suite) {
+  const SolverClient::Client client = SolverClient::live();
+  for (const int moves : {1'690, 100'000, 1'000'000}) {
+    auto rng = Dependencies::RandomNumberGenerator::seeded(7);
+    std::vector<std::string> tiles;
+    std::vector<int> history;
+    PuzzleCore::scramble(PuzzleCore::maxGrid, rng, tiles, history, moves);
+    suite.add(std::format("SolverClient.plan/{}", moves),
+              [client, history = std::move(history)](std::uint64_t iterations) {
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                  Benchmark::doNotOptimize(client.plan(history, PuzzleCore::maxGrid,
+                                                       SolverClient::PlanMode::fast, {}, {},
+                                                       std::stop_token{}));
+                }
+              });
+  }
+
+  const auto deal = PuzzleCore::scrambled(4, 102); // optimally 40 moves from solved
+  suite.add("SolverClient.hint/cold", [deal](std::uint64_t iterations) {
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+      const SolverClient::Client fresh = SolverClient::live(); // an empty table
+      Benchmark::doNotOptimize(fresh.hint(deal, 4, std::chrono::seconds(10), std::stop_token{}));
+    }
+  });
+  suite.add("SolverClient.hint/warm", [deal](std::uint64_t iterations) {
+    const SolverClient::Client warmed = SolverClient::live();
+    warmed.hint(deal, 4, std::chrono::seconds(10), std::stop_token{});
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+      Benchmark::doNotOptimize(warmed.hint(deal, 4, std::chrono::seconds(10), std::stop_token{}));
+    }
+  });
+
+  for (const int grid : {4, 5}) {
+    suite.add(std::format("SolverClient.search/{}x{}", grid, grid),
+              [client, grid, tiles = PuzzleCore::scrambled(grid, 2)](std::uint64_t iterations) {
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                  Benchmark::doNotOptimize(
+                      client.search(tiles, grid, std::size_t{64} << 20, std::stop_token{}));
+                }
+              });
+  }
+}
@@ -0,0 +1,416 @@
+// FifteenStateSpace — a breadth-first search of the 4×4 state space from
+// solved that keeps its frontiers on disk, as a reference for the solvers: the
+// number of boards at each distance is a fixed fact about the puzzle, so a
+// heuristic that overestimates, or a solver that finds a "shortest" plan that
+// is not, disagrees with it somewhere.
+//
+// A board packs into 64 bits, one nibble per cell (the tile, 0 for the blank).
+// Each depth is a file of sorted, distinct boards. Going one deeper:
+//
+//  1. expand: the frontier is read in chunks, each chunk split across the
+//     worker threads; every worker sorts and de-duplicates its successors and
+//     writes them as a run file, so memory holds one chunk and its successors;
+//  2. merge: the runs are merged, de-duplicated, and streamed against the
+//     depth before (a board's neighbours are all one closer or one further, so
+//     nothing else can be a repeat); what is left is the next depth. At most
+//     kMergeWays runs are open at once: a deep layer has thousands, so they are
+//     first merged in groups into fewer, longer runs, as many passes as needed.
+//
+// Only three depth files and one depth's runs exist at a time. Any read or
+// write that fails stops the search with an error rather than a short count.
+// The whole space is 16!/2 ≈ 10^13 boards, 80 moves deep, and its widest
+// depths alone would take terabytes this way, so the tool stops at
+// `--max-depth`; every prefix is exact.
+//
+//   FifteenStateSpace [--max-depth D] [--threads N] [--chunk <M boards>] [--dir <path>]
+//                     [--check]
+//
+// `--check` compares the counts with the published ones (OEIS A089473) as far
+// as both go, and exits non-zero on any difference.
+
+import std;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using State = std::uint64_t;
+
+constexpr int kGrid = 4;
+constexpr int kCells = kGrid * kGrid;
+constexpr std::size_t kMergeWays = 64; // runs merged at once; each holds a buffer
+
+// Boards at each distance from solved, blank in the corner (OEIS A089473).
+constexpr std::array<std::uint64_t, 23> kPublished = {
+    1,     2,      4,      10,     24,     54,     107,    212,     446,     946,     1948,   3938,
+    7808,  15544,  30821,  60842,  119000, 231844, 447342, 859744,  1637383, 3098270, 5802411};
+
+struct Options {
+  int maxDepth = 20;
+  int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  std::size_t chunk = std::size_t{4} << 20; // frontier boards expanded per round
+  std::filesystem::path dir = "fifteen-state-space";
+  bool check = false;
+};
+
+int tileAt(State state, int cell) { return static_cast<int>(state >> (cell * 4) & 0xF); }
+
+State solvedState() {
+  State state = 0;
+  for (int cell = 0; cell + 1 < kCells; ++cell) {
+    state |= static_cast<State>(cell + 1) << (cell * 4);
+  }
+  return state; // the last nibble, the blank, is 0
+}
+
+int blankOf(State state) {
+  for (int cell = 0; cell < kCells; ++cell) {
+    if (tileAt(state, cell) == 0) {
+      return cell;
+    }
+  }
+  return -1;
+}
+
+// Appends the boards one slide from `state` to `out`.
+void expandInto(State state, std::vector<State> &out) {
+  const int blank = blankOf(state);
+  const auto slideFrom = [&](int cell) {
+    const State tile = static_cast<State>(tileAt(state, cell));
+    out.push_back((state & ~(State{0xF} << (cell * 4))) | tile << (blank * 4));
+  };
+  if (blank >= kGrid) {
+    slideFrom(blank - kGrid);
+  }
+  if (blank < kCells - kGrid) {
+    slideFrom(blank + kGrid);
+  }
+  if (blank % kGrid > 0) {
+    slideFrom(blank - 1);
+  }
+  if (blank % kGrid < kGrid - 1) {
+    slideFrom(blank + 1);
+  }
+}
+
+// Sequential reads of a file of States through a buffer. A file that cannot be
+// opened or read reports `failed()` (and reads as ended), never as a short run.
+class StateReader {
+public:
+  explicit StateReader(const std::filesystem::path &path)
+      : in_(path, std::ios::binary), path_(path), buffer_(kBuffer), failed_(!in_.is_open()) {
+    if (failed_) {
+      std::println(std::cerr, "FifteenStateSpace: cannot open {}", path_.string());
+      return;
+    }
+    refill();
+  }
+
+  bool failed() const { return failed_; }
+  bool done() const { return position_ == size_; }
+  State peek() const { return buffer_[position_]; }
+  void pop() {
+    if (++position_ == size_) {
+      refill();
+    }
+  }
+
+  // Up to `count` states; empty at the end of the file.
+  std::vector<State> take(std::size_t count) {
+    std::vector<State> out;
+    while (out.size() < count && !done()) {
+      const std::size_t n = std::min(count - out.size(), size_ - position_);
+      out.insert(out.end(), buffer_.begin() + static_cast<std::ptrdiff_t>(position_),
+                 buffer_.begin() + static_cast<std::ptrdiff_t>(position_ + n));
+      position_ += n;
+      if (position_ == size_) {
+        refill();
+      }
+    }
+    return out;
+  }
+
+private:
+  static constexpr std::size_t kBuffer = 1 << 16;
+
+  void refill() {
+    position_ = 0;
+    size_ = 0;
+    if (failed_) {
+      return;
+    }
+    in_.read(reinterpret_cast<char *>(buffer_.data()),
+             static_cast<std::streamsize>(buffer_.size() * sizeof(State)));
+    const auto bytes = static_cast<std::size_t>(in_.gcount());
+    if (in_.bad() || bytes % sizeof(State) != 0) {
+      std::println(std::cerr, "FifteenStateSpace: cannot read {}", path_.string());
+      failed_ = true;
+      return;
+    }
+    size_ = bytes / sizeof(State);
+  }
+
+  std::ifstream in_;
+  std::filesystem::path path_;
+  std::vector<State> buffer_;
+  std::size_t position_ = 0;
+  std::size_t size_ = 0;
+  bool failed_ = false;
+};
+
+class StateWriter {
+public:
+  explicit StateWriter(const std::filesystem::path &path)
+      : out_(path, std::ios::binary | std::ios::trunc), path_(path) {
+    buffer_.reserve(kBuffer);
+  }
+
+  void push(State state) {
+    buffer_.push_back(state);
+    ++count_;
+    if (buffer_.size() == kBuffer) {
+      flush();
+    }
+  }
+  std::uint64_t count() const { return count_; }
+
+  // Writes what is buffered and closes the file; false if any write failed.
+  bool close() {
+    flush();
+    out_.close();
+    if (!out_) {
+      std::println(std::cerr, "FifteenStateSpace: cannot write {}", path_.string());
+      return false;
+    }
+    return true;
+  }
+
+private:
+  static constexpr std::size_t kBuffer = 1 << 16;
+
+  void flush() {
+    out_.write(reinterpret_cast<const char *>(buffer_.data()),
+               static_cast<std::streamsize>(buffer_.size() * sizeof(State)));
+    buffer_.clear();
+  }
+
+  std::ofstream out_;
+  std::filesystem::path path_;
+  std::vector<State> buffer_;
+  std::uint64_t count_ = 0;
+};
+
+std::filesystem::path depthFile(const Options &options, int depth) {
+  return options.dir / std::format("depth-{}.bin", depth);
+}
+
+// Step 1: the frontier's successors as sorted, distinct run files; nullopt if
+// a file could not be read or written.
+std::optional<std::vector<std::filesystem::path>> expandRuns(const Options &options, int depth) {
+  std::vector<std::filesystem::path> runs;
+  StateReader frontier(depthFile(options, depth));
+  for (std::vector<State> chunk = frontier.take(options.chunk); !chunk.empty();
+       chunk = frontier.take(options.chunk)) {
+    const auto workers = static_cast<std::size_t>(options.threads);
+    const std::size_t slice = (chunk.size() + workers - 1) / workers;
+    const std::size_t first = runs.size();
+    for (std::size_t w = 0; w < workers && w * slice < chunk.size(); ++w) {
+      runs.push_back(options.dir / std::format("run-{}.bin", runs.size()));
+    }
+    std::vector<char> written(runs.size() - first, 0);
+    {
+      std::vector<std::jthread> threads;
+      for (std::size_t w = 0; first + w < runs.size(); ++w) {
+        threads.emplace_back([&, w] {
+          const std::size_t begin = w * slice;
+          const std::size_t end = std::min(chunk.size(), begin + slice);
+          std::vector<State> successors;
+          successors.reserve((end - begin) * 4);
+          for (std::size_t i = begin; i < end; ++i) {
+            expandInto(chunk[i], successors);
+          }
+          std::ranges::sort(successors);
+          const auto [last, _] = std::ranges::unique(successors);
+          StateWriter run(runs[first + w]);
+          std::for_each(successors.begin(), last, [&run](State state) { run.push(state); });
+          written[w] = run.close() ? 1 : 0;
+        });
+      }
+    }
+    if (std::ranges::find(written, 0) != written.end()) {
+      return std::nullopt;
+    }
+  }
+  if (frontier.failed()) {
+    return std::nullopt;
+  }
+  return runs;
+}
+
+// Merges the sorted runs at `paths` into `out`, dropping repeats and, given
+// `previous`, every board it holds. False if any file failed.
+bool mergeInto(std::span<const std::filesystem::path> paths, StateWriter &out,
+               StateReader *previous) {
+  std::vector<std::unique_ptr<StateReader>> runs;
+  for (const auto &path : paths) {
+    runs.push_back(std::make_unique<StateReader>(path));
+  }
+  const auto later = [&runs](std::size_t a, std::size_t b) {
+    return runs[a]->peek() > runs[b]->peek();
+  };
+  std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(later)> heap(later);
+  for (std::size_t i = 0; i < runs.size(); ++i) {
+    if (!runs[i]->done()) {
+      heap.push(i);
+    }
+  }
+  const auto seenIn = [](StateReader &layer, State state) {
+    while (!layer.done() && layer.peek() < state) {
+      layer.pop();
+    }
+    return !layer.done() && layer.peek() == state;
+  };
+
+  std::optional<State> last;
+  while (!heap.empty()) {
+    const std::size_t run = heap.top();
+    heap.pop();
+    const State state = runs[run]->peek();
+    runs[run]->pop();
+    if (!runs[run]->done()) {
+      heap.push(run);
+    }
+    if (state == last) {
+      continue;
+    }
+    last = state;
+    if (previous == nullptr || !seenIn(*previous, state)) {
+      out.push(state);
+    }
+  }
+  return std::ranges::none_of(runs, [](const auto &run) { return run->failed(); }) &&
+         (previous == nullptr || !previous->failed());
+}
+
+// Step 2: merges the runs (deleting them) into the next depth, leaving out the
+// depth before `depth`. Returns the new depth's size; nullopt if a file failed.
+std::optional<std::uint64_t> mergeRuns(const Options &options, int depth,
+                                       std::vector<std::filesystem::path> runs) {
+  std::error_code error;
+  for (int pass = 0; runs.size() > kMergeWays; ++pass) {
+    std::vector<std::filesystem::path> merged;
+    for (std::size_t first = 0; first < runs.size(); first += kMergeWays) {
+      const auto group =
+          std::span(runs).subspan(first, std::min(kMergeWays, runs.size() - first));
+      merged.push_back(options.dir / std::format("merge-{}-{}.bin", pass, merged.size()));
+      StateWriter out(merged.back());
+      const bool ok = mergeInto(group, out, nullptr);
+      if (!out.close() || !ok) {
+        return std::nullopt;
+      }
+      for (const auto &run : group) {
+        std::filesystem::remove(run, error);
+      }
+    }
+    runs = std::move(merged);
+  }
+
+  std::optional<StateReader> previous;
+  if (depth > 0) {
+    previous.emplace(depthFile(options, depth - 1));
+  }
+  StateWriter next(depthFile(options, depth + 1));
+  const bool ok = mergeInto(runs, next, previous ? &*previous : nullptr);
+  if (!next.close() || !ok) {
+    return std::nullopt;
+  }
+  for (const auto &run : runs) {
+    std::filesystem::remove(run, error);
+  }
+  return next.count();
+}
+
+std::optional<Options> parseOptions(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    if (arg == "--check") {
+      options.check = true;
+      continue;
+    }
+    const bool hasValue = i + 1 < argc;
+    if (!hasValue) {
+      return std::nullopt;
+    }
+    const char *value = argv[++i];
+    if (arg == "--max-depth") {
+      options.maxDepth = std::max(0, std::atoi(value));
+    } else if (arg == "--threads") {
+      options.threads = std::max(1, std::atoi(value));
+    } else if (arg == "--chunk") {
+      options.chunk = std::max<std::size_t>(1, std::strtoull(value, nullptr, 10)) << 20;
+    } else if (arg == "--dir") {
+      options.dir = value;
+    } else {
+      return std::nullopt;
+    }
+  }
+  return options;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const auto parsed = parseOptions(argc, argv);
+  if (!parsed) {
+    std::println(std::cerr, "usage: FifteenStateSpace [--max-depth D] [--threads N] "
+                            "[--chunk <M boards>] [--dir <path>] [--check]");
+    return 2;
+  }
+  const Options options = *parsed;
+  std::error_code error;
+  std::filesystem::create_directories(options.dir, error);
+  StateWriter root(depthFile(options, 0));
+  root.push(solvedState());
+  if (!root.close()) {
+    return 1;
+  }
+  std::println("FifteenStateSpace: 4×4 to depth {} on {} threads in {}", options.maxDepth,
+               options.threads, options.dir.string());
+  std::println("{:>5} {:>14} {:>16} {:>9}", "depth", "boards", "total", "seconds");
+
+  const auto started = Clock::now();
+  std::vector<std::uint64_t> counts{1};
+  std::uint64_t total = 1;
+  std::println("{:>5} {:>14} {:>16} {:>9.1f}", 0, 1, 1, 0.0);
+  for (int depth = 0; depth < options.maxDepth && counts.back() > 0; ++depth) {
+    auto runs = expandRuns(options, depth);
+    const auto count = runs ? mergeRuns(options, depth, std::move(*runs)) : std::nullopt;
+    if (!count) {
+      return 1;
+    }
+    counts.push_back(*count);
+    total += counts.back();
+    if (depth > 0) {
+      std::filesystem::remove(depthFile(options, depth - 1), error);
+    }
+    std::println("{:>5} {:>14} {:>16} {:>9.1f}", depth + 1, counts.back(), total,
+                 std::chrono::duration<double>(Clock::now() - started).count());
+  }
+  const int deepest = static_cast<int>(counts.size()) - 1;
+  for (int depth = std::max(0, deepest - 1); depth <= deepest; ++depth) {
+    std::filesystem::remove(depthFile(options, depth), error);
+  }
+
+  if (options.check) {
+    const std::size_t compared = std::min(counts.size(), kPublished.size());
+    for (std::size_t depth = 0; depth < compared; ++depth) {
+      if (counts[depth] != kPublished[depth]) {
+        std::println(std::cerr, "depth {}: {} boards, expected {}", depth, counts[depth],
+                     kPublished[depth]);
+        return 1;
+      }
+    }
+    std::println("depths 0–{} match the published counts", compared - 1);
+  }
+  return 0;
+}
@@ -0,0 +1,56 @@
+// FifteenBenchmarks — micro-benchmarks for the pure cores (PuzzleCore, the
+// solver, the GameServer referee). Prints a table; `--json <path>` (or `--json -` for stdout) also
+// writes machine-readable results for regression tracking.
+//
+//   FifteenBenchmarks [--filter <substring>] [--min-time-ms <ms>] [--json <path>]
+
+import std;
+import Benchmark;
+
+void registerPuzzleCoreBenchmarks(Benchmark::Suite &suite);
+void registerSolverBenchmarks(Benchmark::Suite &suite);
+void registerGameServerBenchmarks(Benchmark::Suite &suite);
+
+int main(int argc, char **argv) {
+  Benchmark::Options options;
+  std::optional<std::string> jsonPath;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (arg == "--filter" && hasValue) {
+      options.filter = argv[++i];
+    } else if (arg == "--min-time-ms" && hasValue) {
+      options.minTime = std::chrono::milliseconds(std::atoi(argv[++i]));
+    } else if (arg == "--json" && hasValue) {
+      jsonPath = argv[++i];
+    } else {
+      std::println(std::cerr,
+                   "usage: FifteenBenchmarks [--filter <substring>] [--min-time-ms <ms>] "
+                   "[--json <path>|-]");
+      return 2;
+    }
+  }
+
+  Benchmark::Suite suite;
+  registerPuzzleCoreBenchmarks(suite);
+  registerSolverBenchmarks(suite);
+  registerGameServerBenchmarks(suite);
+
+  const auto results = suite.run(options);
+  Benchmark::printTable(results);
+
+  if (jsonPath) {
+    const std::string json = Benchmark::toJson(results);
+    if (*jsonPath == "-") {
+      std::print("{}", json);
+    } else {
+      std::ofstream out(*jsonPath, std::ios::binary | std::ios::trunc);
+      if (!out) {
+        std::println(std::cerr, "cannot write {}", *jsonPath);
+        return 1;
+      }
+      out << json;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,85 @@
+// Replacement global allocation functions that feed AllocationTracking's
+// per-thread counters. Replacement `operator new` must be declared outside any
+// module purview, so this is a plain translation unit using classic headers.
+//
+// It is built as an object library and linked only into executables that
+// count allocations: the benchmark tools always, FifteenServer with
+// FIFTEEN_ALLOCATION_TRACKING. Everything else keeps the default allocator.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// AllocationTracking.cpp: bumps the calling thread's counters.
+extern "C" void fifteenCountAllocation(std::size_t bytes) noexcept;
+
+namespace {
+
+void *allocate(std::size_t size) {
+  fifteenCountAllocation(size);
+  if (void *p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void *allocateAligned(std::size_t size, std::align_val_t align) {
+  fifteenCountAllocation(size);
+  const auto alignment = static_cast<std::size_t>(align);
+  // aligned_alloc wants a size that is a multiple of the alignment.
+  const std::size_t rounded =
+      (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment;
+#if defined(_WIN32)
+  void *p = _aligned_malloc(rounded, alignment);
+#else
+  void *p = std::aligned_alloc(alignment, rounded);
+#endif
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void releaseAligned(void *p) noexcept {
+#if defined(_WIN32)
+  _aligned_free(p);
+#else
+  std::free(p);
+#endif
+}
+
+} // namespace
+
+void *operator new(std::size_t size) { return allocate(size); }
+void *operator new[](std::size_t size) { return allocate(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+void *operator new(std::size_t size, std::align_val_t align) {
+  return allocateAligned(size, align);
+}
+void *operator new[](std::size_t size, std::align_val_t align) {
+  return allocateAligned(size, align);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { releaseAligned(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { releaseAligned(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { releaseAligned(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { releaseAligned(p); }
@@ -0,0 +1,26 @@
+module AllocationTracking; // implementation unit
+
+import std;
+
+namespace {
+
+// Trivially initialized, so the hooks may touch them from any allocation —
+// including the ones a thread makes before its dynamic thread_locals exist.
+thread_local std::uint64_t allocationCount = 0;
+thread_local std::uint64_t allocatedBytes = 0;
+
+} // namespace
+
+// Called by every replacement `operator new` (AllocationHooks.cpp).
+extern "C" void fifteenCountAllocation(std::size_t bytes) noexcept {
+  ++allocationCount;
+  allocatedBytes += bytes;
+}
+
+namespace AllocationTracking {
+
+Totals threadTotals() noexcept {
+  return Totals{.allocations = allocationCount, .bytes = allocatedBytes};
+}
+
+} // namespace AllocationTracking
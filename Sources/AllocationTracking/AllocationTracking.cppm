@@ -0,0 +1,89 @@
+export module AllocationTracking;
+
+import std;
+import Metrics;
+
+// Heap allocation counting, for the question "how much of the server's CPU is
+// the allocator?". The replacement `operator new` in AllocationHooks.cpp bumps
+// plain thread-local counters (no atomics, no locks); `threadTotals()` reads
+// the calling thread's. Executables that don't link the hooks allocate
+// normally and read zeros.
+//
+// A `Scope` attributes the allocations made inside it to a `Tag`, which
+// reports through Metrics as `fifteen_allocations_total{scope="..."}` and
+// `fifteen_allocated_bytes_total{scope="..."}`. Scopes are compiled in with the
+// FIFTEEN_ALLOCATION_TRACKING build option (which also links the hooks into
+// FifteenServer); without it `kEnabled` is false, tags register nothing and a
+// `Scope` is empty. The benchmark tools link the hooks regardless, for their
+// allocs/op columns.
+//
+//   const AllocationTracking::Tag decodeAllocations{"decode"};
+//   {
+//     const AllocationTracking::Scope scope(decodeAllocations);
+//     message = decode(line);
+//   }
+export namespace AllocationTracking {
+
+#if defined(FIFTEEN_ALLOCATION_TRACKING)
+inline constexpr bool kEnabled = true;
+#else
+inline constexpr bool kEnabled = false;
+#endif
+
+struct Totals {
+  std::uint64_t allocations = 0;
+  std::uint64_t bytes = 0;
+};
+
+// The calling thread's allocations since it started.
+Totals threadTotals() noexcept;
+
+// A named bucket of allocations (a metric label value; keep the set small).
+class Tag {
+public:
+  explicit Tag(const std::string &scope) {
+    if constexpr (kEnabled) {
+      allocations_.emplace("fifteen_allocations_total", "Heap allocations inside a tagged scope.",
+                           Metrics::Labels{{"scope", scope}});
+      bytes_.emplace("fifteen_allocated_bytes_total", "Heap bytes allocated inside a tagged scope.",
+                     Metrics::Labels{{"scope", scope}});
+    }
+  }
+
+  void add(const Totals &delta) const {
+    if (allocations_.has_value()) {
+      allocations_->inc(delta.allocations);
+      bytes_->inc(delta.bytes);
+    }
+  }
+
+private:
+  std::optional<Metrics::Counter> allocations_;
+  std::optional<Metrics::Counter> bytes_;
+};
+
+// Adds the allocations the current thread makes during this scope to `tag`.
+class Scope {
+public:
+  explicit Scope(const Tag &tag) {
+    if constexpr (kEnabled) {
+      tag_ = &tag;
+      start_ = threadTotals();
+    }
+  }
+  ~Scope() {
+    if constexpr (kEnabled) {
+      const Totals end = threadTotals();
+      tag_->add({.allocations = end.allocations - start_.allocations,
+                 .bytes = end.bytes - start_.bytes});
+    }
+  }
+  Scope(const Scope &) = delete;
+  Scope &operator=(const Scope &) = delete;
+
+private:
+  const Tag *tag_ = nullptr;
+  Totals start_;
+};
+
+} // namespace AllocationTracking
@@ -19,12 +19,23 @@ enum class ApiError : std::uint8_t {
   cancelled,     // the stop_token was tripped
 };
 
+using LeaderboardResult = std::expected<std::vector<SharedModels::LeaderboardEntry>, ApiError>;
+
 struct Client {
   // The top scores for a board size, as the server ranks them.
-  std::function<std::expected<std::vector<SharedModels::LeaderboardEntry>, ApiError>(
-      int /*gridSize*/, std::stop_token)>
-      fetchLeaderboard = [](int, std::stop_token) {
-        return std::expected<std::vector<SharedModels::LeaderboardEntry>, ApiError>{std::in_place};
+  std::function<LeaderboardResult(int /*gridSize*/, std::stop_token)> fetchLeaderboard =
+      [](int, std::stop_token) { return LeaderboardResult{std::in_place}; };
+
+  // Several boards at once (e.g. prefetching every size): the live client runs
+  // the requests concurrently, multiplexed over one connection where the
+  // server speaks HTTP/2. Each size gets its own result.
+  std::function<std::map<int, LeaderboardResult>(std::vector<int> /*gridSizes*/, std::stop_token)>
+      fetchLeaderboards = [](std::vector<int> gridSizes, std::stop_token) {
+        std::map<int, LeaderboardResult> results;
+        for (const int gridSize : gridSizes) {
+          results.emplace(gridSize, LeaderboardResult{std::in_place});
+        }
+        return results;
       };
 
   // Submits a completed game to the server.
@@ -32,6 +43,15 @@ struct Client {
       submitScore = [](SharedModels::ScoreSubmission, std::stop_token) {
         return std::expected<void, ApiError>{};
       };
+
+  // Submits several completed games in one request (at most
+  // `ServerRouter::maxBatchSize`). Success means the server has them all: it
+  // stores the valid ones in one transaction and drops any it rejects.
+  std::function<std::expected<void, ApiError>(std::vector<SharedModels::ScoreSubmission>,
+                                              std::stop_token)>
+      submitScores = [](std::vector<SharedModels::ScoreSubmission>, std::stop_token) {
+        return std::expected<void, ApiError>{};
+      };
 };
 
 struct Key : Dependencies::DependencyKey<Key, Client> {
@@ -42,12 +62,24 @@ struct Key : Dependencies::DependencyKey<Key, Client> {
   static Client testValue() {
     return Client{.fetchLeaderboard =
                       [](int, std::stop_token) {
-                        return std::expected<std::vector<SharedModels::LeaderboardEntry>, ApiError>{
-                            std::unexpected(ApiError::offline)};
+                        return LeaderboardResult{std::unexpected(ApiError::offline)};
+                      },
+                  .fetchLeaderboards =
+                      [](std::vector<int> gridSizes, std::stop_token) {
+                        std::map<int, LeaderboardResult> results;
+                        for (const int gridSize : gridSizes) {
+                          results.emplace(gridSize,
+                                          LeaderboardResult{std::unexpected(ApiError::offline)});
+                        }
+                        return results;
                       },
                   .submitScore =
                       [](SharedModels::ScoreSubmission, std::stop_token) {
                         return std::expected<void, ApiError>{std::unexpected(ApiError::offline)};
+                      },
+                  .submitScores =
+                      [](std::vector<SharedModels::ScoreSubmission>, std::stop_token) {
+                        return std::expected<void, ApiError>{std::unexpected(ApiError::offline)};
                       }};
   }
 };
@@ -24,8 +24,7 @@ constexpr std::string_view kDefaultBaseUrl = "http://localhost:8080";
 
 // Process-wide curl init/cleanup. curl_global_init is not thread-safe, so the
 // live client is built once on the main thread (from prepareDependencies)
-// before any background task runs. Held by shared_ptr so cleanup happens only
-// when the last client copy (and any in-flight task capture) is gone.
+// before any background task runs.
 class CurlGlobal {
 public:
   CurlGlobal() { curl_global_init(CURL_GLOBAL_DEFAULT); }
@@ -34,6 +33,89 @@ public:
   CurlGlobal &operator=(const CurlGlobal &) = delete;
 };
 
+// Idle easy handles kept for reuse; extra ones are cleaned up on release.
+constexpr std::size_t kMaxIdleHandles = 8;
+
+// The client's connection state: a CURLSH sharing the DNS cache, the
+// connection pool and TLS sessions between all of its handles, and a pool of
+// easy handles so a request reuses a warm handle instead of building one.
+// Libcurl easy handles are single-thread-only, so a handle belongs to one
+// request at a time; the share's own locks make the caches safe across
+// threads. Held by shared_ptr so cleanup happens only when the last client copy
+// (and any in-flight task capture) is gone.
+class Connections {
+public:
+  Connections() : share_(curl_share_init()) {
+    if (share_ == nullptr) {
+      return; // handles still work, just without the shared caches
+    }
+    curl_share_setopt(share_, CURLSHOPT_LOCKFUNC, &Connections::lock);
+    curl_share_setopt(share_, CURLSHOPT_UNLOCKFUNC, &Connections::unlock);
+    curl_share_setopt(share_, CURLSHOPT_USERDATA, this);
+    curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+  }
+
+  ~Connections() {
+    for (CURL *curl : idle_) {
+      curl_easy_cleanup(curl);
+    }
+    if (share_ != nullptr) {
+      curl_share_cleanup(share_);
+    }
+  }
+
+  Connections(const Connections &) = delete;
+  Connections &operator=(const Connections &) = delete;
+
+  // A handle with default options plus the share, or nullptr if curl is out
+  // of memory.
+  CURL *acquire() {
+    {
+      std::scoped_lock lock(idleMutex_);
+      if (!idle_.empty()) {
+        CURL *curl = idle_.back();
+        idle_.pop_back();
+        return curl;
+      }
+    }
+    CURL *curl = curl_easy_init();
+    if (curl != nullptr && share_ != nullptr) {
+      curl_easy_setopt(curl, CURLOPT_SHARE, share_);
+    }
+    return curl;
+  }
+
+  // curl_easy_reset keeps the share (and with it the live connections), so a
+  // released handle comes back ready for the next request.
+  void release(CURL *curl) {
+    curl_easy_reset(curl);
+    {
+      std::scoped_lock lock(idleMutex_);
+      if (idle_.size() < kMaxIdleHandles) {
+        idle_.push_back(curl);
+        return;
+      }
+    }
+    curl_easy_cleanup(curl);
+  }
+
+private:
+  static void lock(CURL *, curl_lock_data data, curl_lock_access, void *self) {
+    static_cast<Connections *>(self)->locks_[static_cast<std::size_t>(data)].lock();
+  }
+  static void unlock(CURL *, curl_lock_data data, void *self) {
+    static_cast<Connections *>(self)->locks_[static_cast<std::size_t>(data)].unlock();
+  }
+
+  CurlGlobal global_; // first member: initialized before, cleaned up after, the rest
+  std::array<std::mutex, CURL_LOCK_DATA_LAST> locks_;
+  CURLSH *share_ = nullptr;
+  std::mutex idleMutex_;
+  std::vector<CURL *> idle_;
+};
+
 std::string resolveBaseUrl(const std::string &explicitUrl) {
   if (!explicitUrl.empty()) {
     return explicitUrl;
@@ -63,107 +145,233 @@ struct Response {
   bool transportOk = false;
 };
 
-// Performs one route's request, rendered by the shared ServerRouter — the
-// client never hand-writes a path or body. One self-contained transfer with
-// its own easy handle (libcurl easy handles are single-thread-only, so
-// per-call handles are the safe pattern).
-Response perform(const std::string &baseUrl, const ServerRouter::Route &route,
-                 std::stop_token &stop) {
-  const ServerRouter::Request request = ServerRouter::print(route);
-  std::string url = baseUrl + request.path;
-  if (!request.query.empty()) {
-    url += "?" + request.query;
+// One route's request on a pooled handle, rendered by the shared ServerRouter —
+// the client never hand-writes a path or body. Owns everything curl reads or
+// writes until the transfer is done, and returns the handle on destruction.
+class Transfer {
+public:
+  Transfer(Connections &connections, const std::string &baseUrl,
+           const ServerRouter::Route &route, std::stop_token &stop)
+      : connections_(connections), curl_(connections.acquire()) {
+    if (curl_ == nullptr) {
+      return;
+    }
+    const ServerRouter::Request request = ServerRouter::print(route);
+    url_ = baseUrl + request.path;
+    if (!request.query.empty()) {
+      url_ += "?" + request.query;
+    }
+
+    curl_easy_setopt(curl_, CURLOPT_URL, url_.c_str());
+    curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, &writeBody);
+    curl_easy_setopt(curl_, CURLOPT_WRITEDATA, &response_.body);
+    curl_easy_setopt(curl_, CURLOPT_TIMEOUT, 10L);
+    curl_easy_setopt(curl_, CURLOPT_CONNECTTIMEOUT, 5L);
+    curl_easy_setopt(curl_, CURLOPT_NOSIGNAL, 1L); // thread-safe DNS timeouts
+    curl_easy_setopt(curl_, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(curl_, CURLOPT_XFERINFOFUNCTION, &onProgress);
+    curl_easy_setopt(curl_, CURLOPT_XFERINFODATA, &stop);
+    // HTTP/2 when TLS negotiates it (so requests can multiplex), HTTP/1.1 with
+    // keep-alive otherwise — which is what a plain-http FifteenServer speaks.
+    curl_easy_setopt(curl_, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+
+    if (request.method == "POST") {
+      headers_ = curl_slist_append(headers_, "Content-Type: application/json");
+      curl_easy_setopt(curl_, CURLOPT_HTTPHEADER, headers_);
+      curl_easy_setopt(curl_, CURLOPT_COPYPOSTFIELDS, request.body.c_str());
+    }
   }
 
-  Response response;
-  CURL *curl = curl_easy_init();
-  if (!curl) {
-    return response;
+  ~Transfer() {
+    if (curl_ != nullptr) {
+      connections_.release(curl_);
+    }
+    curl_slist_free_all(headers_);
+  }
+
+  Transfer(const Transfer &) = delete;
+  Transfer &operator=(const Transfer &) = delete;
+
+  // nullptr if no handle could be made; the request then reads as offline.
+  CURL *handle() const { return curl_; }
+
+  // The outcome once curl reports `code` for this transfer.
+  Response finish(CURLcode code) {
+    if (code == CURLE_OK) {
+      response_.transportOk = true;
+      curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &response_.status);
+    }
+    return std::move(response_);
+  }
+
+private:
+  Connections &connections_;
+  CURL *curl_ = nullptr;
+  std::string url_;
+  curl_slist *headers_ = nullptr;
+  Response response_;
+};
+
+Response perform(Connections &connections, const std::string &baseUrl,
+                 const ServerRouter::Route &route, std::stop_token &stop) {
+  Transfer transfer(connections, baseUrl, route, stop);
+  if (transfer.handle() == nullptr) {
+    return {};
   }
+  return transfer.finish(curl_easy_perform(transfer.handle()));
+}
 
-  curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &writeBody);
-  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response.body);
-  curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10L);
-  curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 5L);
-  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L); // thread-safe DNS timeouts
-  curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
-  curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, &onProgress);
-  curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &stop);
+// Runs every route concurrently on one multi handle and returns the responses
+// in route order. Over HTTP/2 the requests share a single connection
+// (PIPEWAIT holds the later ones until the first connection's protocol is
+// known); over HTTP/1.1 they each take a pooled connection.
+std::vector<Response> performAll(Connections &connections, const std::string &baseUrl,
+                                 const std::vector<ServerRouter::Route> &routes,
+                                 std::stop_token &stop) {
+  std::vector<Response> responses(routes.size());
+  CURLM *multi = curl_multi_init();
+  if (multi == nullptr) {
+    return responses;
+  }
+  curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
 
-  curl_slist *headers = nullptr;
-  if (request.method == "POST") {
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_COPYPOSTFIELDS, request.body.c_str());
+  std::vector<std::unique_ptr<Transfer>> transfers;
+  transfers.reserve(routes.size());
+  for (const ServerRouter::Route &route : routes) {
+    const auto &transfer =
+        transfers.emplace_back(std::make_unique<Transfer>(connections, baseUrl, route, stop));
+    if (transfer->handle() != nullptr) {
+      curl_easy_setopt(transfer->handle(), CURLOPT_PIPEWAIT, 1L);
+      curl_multi_add_handle(multi, transfer->handle());
+    }
   }
 
-  if (curl_easy_perform(curl) == CURLE_OK) {
-    response.transportOk = true;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response.status);
+  int running = 0;
+  do {
+    if (curl_multi_perform(multi, &running) != CURLM_OK) {
+      break;
+    }
+    if (running > 0) {
+      curl_multi_poll(multi, nullptr, 0, 100, nullptr);
+    }
+  } while (running > 0 && !stop.stop_requested());
+
+  int queued = 0;
+  while (const CURLMsg *message = curl_multi_info_read(multi, &queued)) {
+    if (message->msg != CURLMSG_DONE) {
+      continue;
+    }
+    for (std::size_t i = 0; i < transfers.size(); ++i) {
+      if (transfers[i]->handle() == message->easy_handle) {
+        responses[i] = transfers[i]->finish(message->data.result);
+      }
+    }
   }
 
-  if (headers != nullptr) {
-    curl_slist_free_all(headers);
+  for (const auto &transfer : transfers) {
+    if (transfer->handle() != nullptr) {
+      curl_multi_remove_handle(multi, transfer->handle());
+    }
   }
-  curl_easy_cleanup(curl);
-  return response;
+  curl_multi_cleanup(multi);
+  return responses;
 }
 
 bool isSuccess(long status) { return status >= 200 && status < 300; }
 
+LeaderboardResult decodeLeaderboard(const Response &response, int gridSize) {
+  if (!response.transportOk) {
+    return std::unexpected(ApiError::offline);
+  }
+  if (!isSuccess(response.status)) {
+    return std::unexpected(ApiError::httpError);
+  }
+  auto entries = ServerRouter::decodeLeaderboardEntries(response.body);
+  if (!entries.has_value()) {
+    return std::unexpected(ApiError::decodingError);
+  }
+  for (auto &entry : *entries) {
+    if (entry.gridSize == 0) {
+      entry.gridSize = gridSize; // implied by the request when a server omits it
+    }
+  }
+  return std::move(*entries);
+}
+
+// The outcome of a score upload that has no response body to decode.
+std::expected<void, ApiError> submitted(const Response &response, const std::stop_token &stop) {
+  if (stop.stop_requested()) {
+    return std::unexpected(ApiError::cancelled);
+  }
+  if (!response.transportOk) {
+    return std::unexpected(ApiError::offline);
+  }
+  if (!isSuccess(response.status)) {
+    return std::unexpected(ApiError::httpError);
+  }
+  return {};
+}
+
 } // namespace
 
 Client live(std::string explicitUrl) {
-  auto global = std::make_shared<CurlGlobal>();
+  auto connections = std::make_shared<Connections>();
   const std::string baseUrl = resolveBaseUrl(explicitUrl);
 
   return Client{
-      .fetchLeaderboard = [global, baseUrl](int gridSize, std::stop_token stop)
-          -> std::expected<std::vector<SharedModels::LeaderboardEntry>, ApiError> {
+      .fetchLeaderboard = [connections, baseUrl](int gridSize,
+                                                 std::stop_token stop) -> LeaderboardResult {
         if (stop.stop_requested()) {
           return std::unexpected(ApiError::cancelled);
         }
-        const Response response =
-            perform(baseUrl, ServerRouter::FetchLeaderboard{.gridSize = gridSize}, stop);
+        const Response response = perform(
+            *connections, baseUrl, ServerRouter::FetchLeaderboard{.gridSize = gridSize}, stop);
         if (stop.stop_requested()) {
           return std::unexpected(ApiError::cancelled);
         }
-        if (!response.transportOk) {
-          return std::unexpected(ApiError::offline);
-        }
-        if (!isSuccess(response.status)) {
-          return std::unexpected(ApiError::httpError);
-        }
-        auto entries = ServerRouter::decodeLeaderboardEntries(response.body);
-        if (!entries.has_value()) {
-          return std::unexpected(ApiError::decodingError);
+        return decodeLeaderboard(response, gridSize);
+      },
+      .fetchLeaderboards = [connections, baseUrl](std::vector<int> gridSizes,
+                                                  std::stop_token stop) {
+        std::vector<ServerRouter::Route> routes;
+        routes.reserve(gridSizes.size());
+        for (const int gridSize : gridSizes) {
+          routes.emplace_back(ServerRouter::FetchLeaderboard{.gridSize = gridSize});
         }
-        for (auto &entry : *entries) {
-          if (entry.gridSize == 0) {
-            entry.gridSize = gridSize; // implied by the request when a server omits it
-          }
+        const std::vector<Response> responses =
+            stop.stop_requested() ? std::vector<Response>(gridSizes.size())
+                                  : performAll(*connections, baseUrl, routes, stop);
+
+        std::map<int, LeaderboardResult> results;
+        for (std::size_t i = 0; i < gridSizes.size(); ++i) {
+          results.insert_or_assign(gridSizes[i],
+                                   stop.stop_requested()
+                                       ? LeaderboardResult{std::unexpected(ApiError::cancelled)}
+                                       : decodeLeaderboard(responses[i], gridSizes[i]));
         }
-        return std::move(*entries);
+        return results;
       },
-      .submitScore = [global, baseUrl](SharedModels::ScoreSubmission submission,
-                                       std::stop_token stop) -> std::expected<void, ApiError> {
+      .submitScore = [connections, baseUrl](SharedModels::ScoreSubmission submission,
+                                            std::stop_token stop) -> std::expected<void, ApiError> {
         if (stop.stop_requested()) {
           return std::unexpected(ApiError::cancelled);
         }
         const Response response =
-            perform(baseUrl, ServerRouter::SubmitScore{.submission = std::move(submission)}, stop);
-        if (stop.stop_requested()) {
-          return std::unexpected(ApiError::cancelled);
-        }
-        if (!response.transportOk) {
-          return std::unexpected(ApiError::offline);
-        }
-        if (!isSuccess(response.status)) {
-          return std::unexpected(ApiError::httpError);
-        }
-        return {};
-      }};
+            perform(*connections, baseUrl,
+                    ServerRouter::SubmitScore{.submission = std::move(submission)}, stop);
+        return submitted(response, stop);
+      },
+      .submitScores =
+          [connections, baseUrl](std::vector<SharedModels::ScoreSubmission> submissions,
+                                 std::stop_token stop) -> std::expected<void, ApiError> {
+            if (stop.stop_requested()) {
+              return std::unexpected(ApiError::cancelled);
+            }
+            const Response response =
+                perform(*connections, baseUrl,
+                        ServerRouter::SubmitScores{.submissions = std::move(submissions)}, stop);
+            return submitted(response, stop);
+          }};
 }
 
 } // namespace ApiClient
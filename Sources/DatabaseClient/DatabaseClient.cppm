@@ -17,19 +17,56 @@ enum class DbError : std::uint8_t {
   queryFailed, // a statement failed (migration, insert, or select)
 };
 
+// A score waiting in the outbox for upload; `id` orders the queue and names
+// the row to remove once the server has it.
+struct OutboxEntry {
+  std::int64_t id = 0;
+  SharedModels::ScoreSubmission submission;
+
+  bool operator==(const OutboxEntry &) const = default;
+};
+
 struct Client {
   // Creates the schema if needed (idempotent).
   std::function<std::expected<void, DbError>()> migrate = [] {
     return std::expected<void, DbError>{};
   };
-  // Persists a completed game.
+  // Persists a completed game; one whose `clientId` is already stored is
+  // skipped, so an upload sent twice is stored once.
   std::function<std::expected<void, DbError>(SharedModels::ScoreSubmission)> saveGame =
       [](SharedModels::ScoreSubmission) { return std::expected<void, DbError>{}; };
+  // Persists several games in one transaction: all of them or none (skipping,
+  // as `saveGame` does, any whose `clientId` is already stored).
+  std::function<std::expected<void, DbError>(std::vector<SharedModels::ScoreSubmission>)>
+      saveGames = [](std::vector<SharedModels::ScoreSubmission>) {
+        return std::expected<void, DbError>{};
+      };
+  // The outbox: a durable queue of scores the server has not acknowledged yet,
+  // so a win while offline is uploaded later instead of lost.
+  std::function<std::expected<void, DbError>(SharedModels::ScoreSubmission)> enqueueSubmission =
+      [](SharedModels::ScoreSubmission) { return std::expected<void, DbError>{}; };
+  // Up to `limit` queued scores, oldest first, each named by a `clientId`
+  // unique to its entry.
+  std::function<std::expected<std::vector<OutboxEntry>, DbError>(int /*limit*/)> fetchOutbox =
+      [](int) { return std::expected<std::vector<OutboxEntry>, DbError>{std::in_place}; };
+  // Drops uploaded entries from the outbox (unknown ids are ignored).
+  std::function<std::expected<void, DbError>(std::vector<std::int64_t>)> removeFromOutbox =
+      [](std::vector<std::int64_t>) { return std::expected<void, DbError>{}; };
   // The local top-N scores for a board size, fastest first.
   std::function<std::expected<std::vector<SharedModels::LeaderboardEntry>, DbError>(int)>
       fetchBestScores = [](int) {
         return std::expected<std::vector<SharedModels::LeaderboardEntry>, DbError>{std::in_place};
       };
+  // The top-N scores for a board size by moves per par move, fewest first (then
+  // fastest); only games on boards the server dealt and has a par for.
+  std::function<std::expected<std::vector<SharedModels::LeaderboardEntry>, DbError>(int)>
+      fetchBestScoresByPar = [](int) {
+        return std::expected<std::vector<SharedModels::LeaderboardEntry>, DbError>{std::in_place};
+      };
+  // Sets the par of every recorded game dealt as (grid, seed) that has none yet,
+  // for a par that was still being computed when the game was saved.
+  std::function<std::expected<void, DbError>(int /*grid*/, std::uint64_t /*seed*/, int /*par*/)>
+      recordPar = [](int, std::uint64_t, int) { return std::expected<void, DbError>{}; };
   // Aggregate stats across all recorded games.
   std::function<std::expected<SharedModels::Stats, DbError>()> fetchStats = [] {
     return std::expected<SharedModels::Stats, DbError>{std::in_place};
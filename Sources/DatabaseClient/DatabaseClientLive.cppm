@@ -35,6 +35,16 @@ struct Connection {
 
 SharedModels::LeaderboardEntry entryFromRow(const Sqlite::Row &row) {
   return SharedModels::LeaderboardEntry{
+      .name = std::get<std::string>(row[0]),
+      .gridSize = static_cast<int>(std::get<std::int64_t>(row[1])),
+      .moves = static_cast<int>(std::get<std::int64_t>(row[2])),
+      .duration = static_cast<int>(std::get<std::int64_t>(row[3])),
+      .playedAt = std::get<double>(row[4]),
+      .par = static_cast<int>(std::get<std::int64_t>(row[5]))};
+}
+
+SharedModels::ScoreSubmission submissionFromRow(const Sqlite::Row &row) {
+  return SharedModels::ScoreSubmission{
       .name = std::get<std::string>(row[0]),
       .gridSize = static_cast<int>(std::get<std::int64_t>(row[1])),
       .moves = static_cast<int>(std::get<std::int64_t>(row[2])),
@@ -42,6 +52,43 @@ SharedModels::LeaderboardEntry entryFromRow(const Sqlite::Row &row) {
       .playedAt = std::get<double>(row[4])};
 }
 
+// The (name, grid_size, moves, duration_seconds, played_at) bindings shared by
+// the games and outbox tables.
+std::vector<Sqlite::Datatype> submissionBindings(const SharedModels::ScoreSubmission &s) {
+  return {Sqlite::Datatype{s.name}, Sqlite::Datatype{static_cast<std::int64_t>(s.gridSize)},
+          Sqlite::Datatype{static_cast<std::int64_t>(s.moves)},
+          Sqlite::Datatype{static_cast<std::int64_t>(s.duration)}, Sqlite::Datatype{s.playedAt}};
+}
+
+// A game adds its deal: the seed (SQLite integers are signed, so its bits) and
+// the par; then the client id, NULL when there is none.
+std::vector<Sqlite::Datatype> gameBindings(const SharedModels::ScoreSubmission &s) {
+  auto bindings = submissionBindings(s);
+  bindings.emplace_back(std::bit_cast<std::int64_t>(s.seed));
+  bindings.emplace_back(static_cast<std::int64_t>(s.par));
+  bindings.push_back(s.clientId.empty() ? Sqlite::Datatype{} : Sqlite::Datatype{s.clientId});
+  return bindings;
+}
+
+// A game whose client id is already stored is the same upload sent again (its
+// acknowledgement was lost), so it is skipped rather than stored twice.
+constexpr const char *kInsertGame =
+    "INSERT INTO games (name, grid_size, moves, duration_seconds, played_at, seed, par, "
+    "client_id) VALUES (?, ?, ?, ?, ?, ?, ?, ?) ON CONFLICT DO NOTHING";
+
+// Runs `body` as one transaction: committed if it returns, rolled back (and
+// the exception rethrown) if it throws.
+template <typename Body> void inTransaction(Sqlite::Database &db, Body body) {
+  db.execute("BEGIN IMMEDIATE");
+  try {
+    body();
+  } catch (...) {
+    db.execute("ROLLBACK");
+    throw;
+  }
+  db.execute("COMMIT");
+}
+
 } // namespace
 
 Client live(std::string dbPath) {
@@ -74,6 +121,32 @@ Client live(std::string dbPath) {
                        "ON games(grid_size, duration_seconds)");
             db.execute("PRAGMA user_version = 1");
           }
+          if (version < 2) {
+            db.execute("CREATE TABLE IF NOT EXISTS outbox ("
+                       "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+                       "name TEXT NOT NULL,"
+                       "grid_size INTEGER NOT NULL,"
+                       "moves INTEGER NOT NULL,"
+                       "duration_seconds INTEGER NOT NULL,"
+                       "played_at REAL NOT NULL)");
+            db.execute("PRAGMA user_version = 2");
+          }
+          if (version < 3) {
+            // The deal behind a server-verified game, and its par (0: unknown).
+            db.execute("ALTER TABLE games ADD COLUMN seed INTEGER NOT NULL DEFAULT 0");
+            db.execute("ALTER TABLE games ADD COLUMN par INTEGER NOT NULL DEFAULT 0");
+            db.execute("CREATE INDEX IF NOT EXISTS idx_games_deal ON games(grid_size, seed)");
+            db.execute("PRAGMA user_version = 3");
+          }
+          if (version < 4) {
+            // A random id for this install, which names its outbox entries, and
+            // the client id a stored game was uploaded with (NULL: none).
+            db.execute("CREATE TABLE IF NOT EXISTS install (id TEXT NOT NULL)");
+            db.execute("INSERT INTO install (id) VALUES (lower(hex(randomblob(16))))");
+            db.execute("ALTER TABLE games ADD COLUMN client_id TEXT");
+            db.execute("CREATE UNIQUE INDEX IF NOT EXISTS idx_games_client_id ON games(client_id)");
+            db.execute("PRAGMA user_version = 4");
+          }
           return {};
         } catch (...) {
           return std::unexpected(DbError::queryFailed);
@@ -85,13 +158,83 @@ Client live(std::string dbPath) {
           return std::unexpected(DbError::openFailed);
         }
         try {
-          connection->database->run("INSERT INTO games (name, grid_size, moves, duration_seconds, "
-                                    "played_at) VALUES (?, ?, ?, ?, ?)",
-                                    {Sqlite::Datatype{s.name},
-                                     Sqlite::Datatype{static_cast<std::int64_t>(s.gridSize)},
-                                     Sqlite::Datatype{static_cast<std::int64_t>(s.moves)},
-                                     Sqlite::Datatype{static_cast<std::int64_t>(s.duration)},
-                                     Sqlite::Datatype{s.playedAt}});
+          connection->database->run(kInsertGame, gameBindings(s));
+          return {};
+        } catch (...) {
+          return std::unexpected(DbError::queryFailed);
+        }
+      },
+      .saveGames = [connection](std::vector<SharedModels::ScoreSubmission> submissions)
+          -> std::expected<void, DbError> {
+        std::scoped_lock lock(connection->mutex);
+        if (!connection->database) {
+          return std::unexpected(DbError::openFailed);
+        }
+        try {
+          // One transaction means one journal sync for the whole batch, not one
+          // per row.
+          auto &db = *connection->database;
+          inTransaction(db, [&] {
+            for (const auto &s : submissions) {
+              db.run(kInsertGame, gameBindings(s));
+            }
+          });
+          return {};
+        } catch (...) {
+          return std::unexpected(DbError::queryFailed);
+        }
+      },
+      .enqueueSubmission = [connection](
+                               SharedModels::ScoreSubmission s) -> std::expected<void, DbError> {
+        std::scoped_lock lock(connection->mutex);
+        if (!connection->database) {
+          return std::unexpected(DbError::openFailed);
+        }
+        try {
+          connection->database->run("INSERT INTO outbox (name, grid_size, moves, "
+                                    "duration_seconds, played_at) VALUES (?, ?, ?, ?, ?)",
+                                    submissionBindings(s));
+          return {};
+        } catch (...) {
+          return std::unexpected(DbError::queryFailed);
+        }
+      },
+      .fetchOutbox = [connection](int limit) -> std::expected<std::vector<OutboxEntry>, DbError> {
+        std::scoped_lock lock(connection->mutex);
+        if (!connection->database) {
+          return std::unexpected(DbError::openFailed);
+        }
+        try {
+          const auto rows = connection->database->run(
+              "SELECT name, grid_size, moves, duration_seconds, played_at, id, "
+              "(SELECT id FROM install) FROM outbox ORDER BY id ASC LIMIT ?",
+              {Sqlite::Datatype{static_cast<std::int64_t>(limit)}});
+          std::vector<OutboxEntry> entries;
+          entries.reserve(rows.size());
+          for (const auto &row : rows) {
+            const std::int64_t id = std::get<std::int64_t>(row[5]);
+            auto submission = submissionFromRow(row);
+            submission.clientId = std::format("{}-{}", std::get<std::string>(row[6]), id);
+            entries.push_back(OutboxEntry{.id = id, .submission = std::move(submission)});
+          }
+          return entries;
+        } catch (...) {
+          return std::unexpected(DbError::queryFailed);
+        }
+      },
+      .removeFromOutbox = [connection](
+                              std::vector<std::int64_t> ids) -> std::expected<void, DbError> {
+        std::scoped_lock lock(connection->mutex);
+        if (!connection->database) {
+          return std::unexpected(DbError::openFailed);
+        }
+        try {
+          auto &db = *connection->database;
+          inTransaction(db, [&] {
+            for (const std::int64_t id : ids) {
+              db.run("DELETE FROM outbox WHERE id = ?", {Sqlite::Datatype{id}});
+            }
+          });
           return {};
         } catch (...) {
           return std::unexpected(DbError::queryFailed);
@@ -105,7 +248,7 @@ Client live(std::string dbPath) {
         }
         try {
           const auto rows = connection->database->run(
-              "SELECT name, grid_size, moves, duration_seconds, played_at "
+              "SELECT name, grid_size, moves, duration_seconds, played_at, par "
               "FROM games WHERE grid_size = ? "
               "ORDER BY duration_seconds ASC, moves ASC LIMIT 10",
               {Sqlite::Datatype{static_cast<std::int64_t>(gridSize)}});
@@ -119,6 +262,45 @@ Client live(std::string dbPath) {
           return std::unexpected(DbError::queryFailed);
         }
       },
+      .fetchBestScoresByPar = [connection](int gridSize)
+          -> std::expected<std::vector<SharedModels::LeaderboardEntry>, DbError> {
+        std::scoped_lock lock(connection->mutex);
+        if (!connection->database) {
+          return std::unexpected(DbError::openFailed);
+        }
+        try {
+          const auto rows = connection->database->run(
+              "SELECT name, grid_size, moves, duration_seconds, played_at, par "
+              "FROM games WHERE grid_size = ? AND par > 0 "
+              "ORDER BY CAST(moves AS REAL) / par ASC, duration_seconds ASC LIMIT 10",
+              {Sqlite::Datatype{static_cast<std::int64_t>(gridSize)}});
+          std::vector<SharedModels::LeaderboardEntry> entries;
+          entries.reserve(rows.size());
+          for (const auto &row : rows) {
+            entries.push_back(entryFromRow(row));
+          }
+          return entries;
+        } catch (...) {
+          return std::unexpected(DbError::queryFailed);
+        }
+      },
+      .recordPar = [connection](int grid, std::uint64_t seed,
+                                int par) -> std::expected<void, DbError> {
+        std::scoped_lock lock(connection->mutex);
+        if (!connection->database) {
+          return std::unexpected(DbError::openFailed);
+        }
+        try {
+          connection->database->run(
+              "UPDATE games SET par = ? WHERE grid_size = ? AND seed = ? AND par = 0",
+              {Sqlite::Datatype{static_cast<std::int64_t>(par)},
+               Sqlite::Datatype{static_cast<std::int64_t>(grid)},
+               Sqlite::Datatype{std::bit_cast<std::int64_t>(seed)}});
+          return {};
+        } catch (...) {
+          return std::unexpected(DbError::queryFailed);
+        }
+      },
       .fetchStats = [connection]() -> std::expected<SharedModels::Stats, DbError> {
         std::scoped_lock lock(connection->mutex);
         if (!connection->database) {
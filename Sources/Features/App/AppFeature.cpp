@@ -12,6 +12,7 @@ import SavedGame;
 import SharedModels;
 import DatabaseClient;
 import ApiClient;
+import ScoreUploader;
 import Sharing;
 import AppSettings;
 
@@ -41,6 +42,14 @@ void restorePuzzle(PuzzleFeature::State &puzzle, const SavedGame::Game &saved, d
   puzzle.startDate = now - static_cast<double>(saved.secondsElapsed);
 }
 
+// Background work: uploads whatever the score outbox holds, retrying with
+// backoff while the server is unreachable (see ScoreUploader).
+void drainScoreOutbox(std::stop_token stop) {
+  Dependencies::Dependency<DatabaseClient::Key> db;
+  Dependencies::Dependency<ApiClient::Key> api;
+  (void)ScoreUploader::drainUntilEmpty(*db, *api, ScoreUploader::Backoff{}, std::move(stop));
+}
+
 } // namespace
 
 State initialState(Sharing::Shared<AppSettings::Settings> settings,
@@ -222,9 +231,12 @@ ComposableArchitecture::Feature<State, Action> body() {
                        Dependencies::Dependency<DatabaseClient::Key> db;
                        (void)db->saveGame(submission);
                      });
+                     // Queued before it is sent, so an upload that fails (offline) or
+                     // is cut short is retried by the next drain instead of lost.
                      store.addTask([submission](FeatureStore &, std::stop_token stop) {
-                       Dependencies::Dependency<ApiClient::Key> api;
-                       (void)api->submitScore(submission, std::move(stop));
+                       Dependencies::Dependency<DatabaseClient::Key> db;
+                       (void)db->enqueueSubmission(submission);
+                       drainScoreOutbox(std::move(stop));
                      });
                      // Clear the saved game off the main thread (win ends the session).
                      state.savedGame.set(std::nullopt);
@@ -238,6 +250,11 @@ ComposableArchitecture::Feature<State, Action> body() {
                                         .moves = static_cast<int>(state.puzzle.moveHistory.size())};
                    });
 
+  // Catch up on scores an earlier, offline session queued.
+  feature.onMount([](State &, FeatureStore &store) {
+    store.addTask([](FeatureStore &, std::stop_token stop) { drainScoreOutbox(std::move(stop)); });
+  });
+
   return feature;
 }
 
@@ -0,0 +1,266 @@
+module;
+
+#include <raylib.h>
+#include <rlgl.h>
+
+export module BoardView;
+
+import std;
+
+// A small raylib kit for drawing puzzle boards cheaply, shared by the solo
+// board, the multiplayer race board and the opponent preview (and any future
+// spectator grid). Three pieces:
+//
+//  - `TileAtlas`: every card (frame, body, label) for one grid, tile size and
+//    style, baked once into a texture laid out by tile id, so a frame never
+//    measures or rasterizes a label.
+//  - `BoardAnimation`: the sliding-tile state of ONE board, a flat array of
+//    animated cells indexed by tile id — no per-frame string hashing, and
+//    boards drawn in the same frame animate independently.
+//  - `drawQuads` / `drawBoard`: emit a whole board as a single run of textured
+//    quads against the atlas (one texture bind, one vertex run per board).
+//
+// Tile ids are the numbers printed on the tiles, 0 for the hole.
+export namespace BoardView {
+
+// How cards are baked. Compared on every `prepare`, so changing it (e.g. the
+// opponent preview turning green when solved) rebakes the atlas once.
+struct CardStyle {
+  Color frame = BLACK;
+  Color tile = ORANGE;
+  Color hole = DARKPURPLE;
+  Color label = BLACK;
+  float border = 2.0f;       // frame thickness in pixels
+  float labelScale = 0.5f;   // starting font size, as a fraction of the tile
+  float minLabelTile = 0.0f; // smaller tiles are drawn as plain color blocks
+};
+
+class TileAtlas {
+public:
+  TileAtlas() = default;
+  TileAtlas(const TileAtlas &) = delete;
+  TileAtlas &operator=(const TileAtlas &) = delete;
+
+  // Makes sure the atlas holds `grid`'s cards at `tile` pixels in `style`,
+  // rebaking only if any of them changed. Must run inside the frame (it may
+  // render into a texture). The texture is never unloaded explicitly: it lives
+  // until the GL context does, like the views that own atlases.
+  void prepare(int grid, float tile, const CardStyle &style = {});
+
+  // Texture coordinates of tile `id`'s card: {u0, vTop, u1, vBottom}.
+  Rectangle texCoords(int id) const;
+
+  const Texture2D &texture() const { return target_.texture; }
+
+private:
+  RenderTexture2D target_{};
+  int grid_ = -1;
+  int tilePx_ = 0;
+  int columns_ = 1;
+  int rows_ = 1;
+  CardStyle style_{};
+};
+
+// The sliding-tile animation of one board.
+class BoardAnimation {
+public:
+  // Advances one frame: each tile eases from where it was toward its cell in
+  // `tiles` (frame-rate independent, ~120ms to close the gap). The first frame
+  // and a grid change snap every tile into place.
+  void update(std::span<const std::string> tiles, int grid, float dt);
+
+  // Animated (column, row) of tile `id`, fractional mid-slide.
+  Vector2 cell(int id) const;
+
+private:
+  int grid_ = -1;
+  std::vector<Vector2> cells_; // indexed by tile id
+};
+
+// Tile id for a label: the number printed on it, 0 for the hole (or a label
+// that isn't a number).
+int tileId(std::string_view label);
+
+struct TileQuad {
+  int id = 0;
+  Rectangle rect{};
+  unsigned char alpha = 255;
+};
+
+// Draws `quads` from `atlas` in one textured-quad run, in order.
+void drawQuads(const TileAtlas &atlas, std::span<const TileQuad> quads);
+
+// Draws a whole board with its top-left cell at `origin` and `tile`-pixel
+// cells: the hole first, then every numbered tile at its animated cell (or its
+// resting cell without an `animation`).
+void drawBoard(const TileAtlas &atlas, std::span<const std::string> tiles, int grid,
+               Vector2 origin, float tile, const BoardAnimation *animation = nullptr);
+
+} // namespace BoardView
+
+// --- Implementation ----------------------------------------------------------
+
+namespace BoardView {
+
+namespace {
+
+bool sameColor(Color lhs, Color rhs) {
+  return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b && lhs.a == rhs.a;
+}
+
+bool sameStyle(const CardStyle &lhs, const CardStyle &rhs) {
+  return sameColor(lhs.frame, rhs.frame) && sameColor(lhs.tile, rhs.tile) &&
+         sameColor(lhs.hole, rhs.hole) && sameColor(lhs.label, rhs.label) &&
+         lhs.border == rhs.border && lhs.labelScale == rhs.labelScale &&
+         lhs.minLabelTile == rhs.minLabelTile;
+}
+
+void bakeCard(const std::string &text, Rectangle rect, const CardStyle &style) {
+  DrawRectangleRec(rect, style.frame);
+  const Rectangle body{rect.x + style.border, rect.y + style.border,
+                       rect.width - 2.0f * style.border, rect.height - 2.0f * style.border};
+  DrawRectangleRec(body, text.empty() ? style.hole : style.tile);
+
+  if (!text.empty() && rect.width >= style.minLabelTile) {
+    int fontSize = std::max(8, static_cast<int>(rect.height * style.labelScale));
+    // Shrink to fit wide labels on large boards (raylib fonts are
+    // integer-sized).
+    while (fontSize > 8 && MeasureText(text.c_str(), fontSize) > static_cast<int>(rect.width) - 8) {
+      --fontSize;
+    }
+    const int x = static_cast<int>(
+        rect.x + (rect.width - static_cast<float>(MeasureText(text.c_str(), fontSize))) / 2.0f);
+    const int y = static_cast<int>(rect.y + (rect.height - static_cast<float>(fontSize)) / 2.0f);
+    DrawText(text.c_str(), x, y, fontSize, style.label);
+  }
+}
+
+} // namespace
+
+void TileAtlas::prepare(int grid, float tile, const CardStyle &style) {
+  const int tilePx = std::max(1, static_cast<int>(std::ceil(tile)));
+  if (target_.id != 0 && grid_ == grid && tilePx_ == tilePx && sameStyle(style_, style)) {
+    return;
+  }
+  if (target_.id != 0) {
+    UnloadRenderTexture(target_);
+  }
+  const int count = grid * grid;
+  grid_ = grid;
+  tilePx_ = tilePx;
+  style_ = style;
+  columns_ = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+  rows_ = (count + columns_ - 1) / columns_;
+  target_ = LoadRenderTexture(columns_ * tilePx, rows_ * tilePx);
+  SetTextureFilter(target_.texture, TEXTURE_FILTER_BILINEAR);
+
+  BeginTextureMode(target_);
+  ClearBackground(BLANK);
+  for (int id = 0; id < count; ++id) {
+    const Rectangle cell{static_cast<float>((id % columns_) * tilePx),
+                         static_cast<float>((id / columns_) * tilePx), static_cast<float>(tilePx),
+                         static_cast<float>(tilePx)};
+    bakeCard(id == 0 ? std::string{} : std::to_string(id), cell, style_);
+  }
+  EndTextureMode();
+}
+
+Rectangle TileAtlas::texCoords(int id) const {
+  if (id < 0 || id >= grid_ * grid_) {
+    id = 0;
+  }
+  const float width = static_cast<float>(columns_);
+  const float height = static_cast<float>(rows_);
+  const float col = static_cast<float>(id % columns_);
+  const float row = static_cast<float>(id / columns_);
+  // Render textures are stored bottom-up, so rows count down from v = 1.
+  return {col / width, 1.0f - row / height, (col + 1.0f) / width, 1.0f - (row + 1.0f) / height};
+}
+
+void BoardAnimation::update(std::span<const std::string> tiles, int grid, float dt) {
+  const bool snap = grid != grid_ || cells_.size() != tiles.size();
+  if (snap) {
+    grid_ = grid;
+    cells_.assign(tiles.size(), Vector2{0.0f, 0.0f});
+  }
+  const float blend = snap ? 1.0f : 1.0f - std::exp(-dt * 18.0f);
+  for (std::size_t index = 0; index < tiles.size(); ++index) {
+    const int id = tileId(tiles[index]);
+    if (id <= 0 || static_cast<std::size_t>(id) >= cells_.size()) {
+      continue;
+    }
+    const Vector2 target{static_cast<float>(static_cast<int>(index) % grid),
+                         static_cast<float>(static_cast<int>(index) / grid)};
+    Vector2 &cell = cells_[static_cast<std::size_t>(id)];
+    cell.x += (target.x - cell.x) * blend;
+    cell.y += (target.y - cell.y) * blend;
+  }
+}
+
+Vector2 BoardAnimation::cell(int id) const {
+  if (id < 0 || static_cast<std::size_t>(id) >= cells_.size()) {
+    return {0.0f, 0.0f};
+  }
+  return cells_[static_cast<std::size_t>(id)];
+}
+
+int tileId(std::string_view label) {
+  int id = 0;
+  std::from_chars(label.data(), label.data() + label.size(), id);
+  return id;
+}
+
+void drawQuads(const TileAtlas &atlas, std::span<const TileQuad> quads) {
+  if (quads.empty() || atlas.texture().id == 0) {
+    return;
+  }
+  rlCheckRenderBatchLimit(4 * static_cast<int>(quads.size()));
+  rlSetTexture(atlas.texture().id);
+  rlBegin(RL_QUADS);
+  rlNormal3f(0.0f, 0.0f, 1.0f);
+  for (const TileQuad &quad : quads) {
+    const Rectangle uv = atlas.texCoords(quad.id);
+    const Rectangle &r = quad.rect;
+    rlColor4ub(255, 255, 255, quad.alpha);
+    rlTexCoord2f(uv.x, uv.y);
+    rlVertex2f(r.x, r.y);
+    rlTexCoord2f(uv.x, uv.height);
+    rlVertex2f(r.x, r.y + r.height);
+    rlTexCoord2f(uv.width, uv.height);
+    rlVertex2f(r.x + r.width, r.y + r.height);
+    rlTexCoord2f(uv.width, uv.y);
+    rlVertex2f(r.x + r.width, r.y);
+  }
+  rlEnd();
+  rlSetTexture(0);
+}
+
+void drawBoard(const TileAtlas &atlas, std::span<const std::string> tiles, int grid,
+               Vector2 origin, float tile, const BoardAnimation *animation) {
+  static std::vector<TileQuad> quads; // reused so a frame doesn't allocate
+  quads.clear();
+  const auto place = [&](int id, Vector2 cell) {
+    quads.push_back(TileQuad{.id = id,
+                             .rect = {origin.x + cell.x * tile, origin.y + cell.y * tile, tile,
+                                      tile},
+                             .alpha = 255});
+  };
+  for (int index = 0; index < static_cast<int>(tiles.size()); ++index) {
+    if (tiles[static_cast<std::size_t>(index)].empty()) {
+      place(0, {static_cast<float>(index % grid), static_cast<float>(index / grid)});
+    }
+  }
+  for (int index = 0; index < static_cast<int>(tiles.size()); ++index) {
+    const std::string &label = tiles[static_cast<std::size_t>(index)];
+    if (label.empty()) {
+      continue;
+    }
+    const int id = tileId(label);
+    place(id, animation != nullptr
+                  ? animation->cell(id)
+                  : Vector2{static_cast<float>(index % grid), static_cast<float>(index / grid)});
+  }
+  drawQuads(atlas, quads);
+}
+
+} // namespace BoardView
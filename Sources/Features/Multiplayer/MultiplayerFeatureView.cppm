@@ -5,6 +5,7 @@ module;
 export module MultiplayerFeatureView;
 
 import std;
+import BoardView;
 import MultiplayerFeature;
 import PuzzleCore;
 
@@ -51,23 +52,6 @@ Rectangle rectangleForIndex(int index, int grid) {
           layout.originY + static_cast<float>(row) * layout.tile, layout.tile, layout.tile};
 }
 
-void drawCard(const std::string &text, Rectangle rect) {
-  DrawRectangleRec(rect, BLACK);
-  const Rectangle body{rect.x + 2.0f, rect.y + 2.0f, rect.width - 4.0f, rect.height - 4.0f};
-  DrawRectangleRec(body, text.empty() ? DARKPURPLE : ORANGE);
-
-  if (!text.empty()) {
-    int fontSize = std::max(10, static_cast<int>(rect.height * 0.5f));
-    while (fontSize > 8 && MeasureText(text.c_str(), fontSize) > static_cast<int>(rect.width) - 8) {
-      --fontSize;
-    }
-    const int x = static_cast<int>(
-        rect.x + (rect.width - static_cast<float>(MeasureText(text.c_str(), fontSize))) / 2.0f);
-    const int y = static_cast<int>(rect.y + (rect.height - static_cast<float>(fontSize)) / 2.0f);
-    DrawText(text.c_str(), x, y, fontSize, BLACK);
-  }
-}
-
 // Tile that would slide into the empty cell for an arrow key (same feel as the
 // solo puzzle: Up moves the tile below the hole up, and so on).
 std::optional<int> movableTileIndex(const MultiplayerFeature::State &state, int keyPressed) {
@@ -176,29 +160,21 @@ void drawOpponentPreview(const MultiplayerFeature::State &state) {
   DrawRectangleRec({originX - 4.0f, originY - 4.0f, preview + 8.0f, preview + 8.0f},
                    Color{20, 20, 26, 230});
 
+  // Tiny tiles read better as color blocks, so labels are only baked when they
+  // fit; the atlas rebakes once in green when the opponent solves.
   const bool solved = PuzzleCore::isSolved(state.opponentTiles, grid);
-  for (int index = 0; index < static_cast<int>(state.opponentTiles.size()); ++index) {
-    const int row = index / grid;
-    const int col = index % grid;
-    const Rectangle cell{originX + static_cast<float>(col) * tile + 1.0f,
-                         originY + static_cast<float>(row) * tile + 1.0f, tile - 2.0f, tile - 2.0f};
-    if (state.opponentTiles[static_cast<std::size_t>(index)].empty()) {
-      DrawRectangleRec(cell, Color{40, 30, 55, 255}); // the hole
-    } else {
-      DrawRectangleRec(cell, solved ? GREEN : Color{200, 110, 40, 255});
-      // Tiny tiles read better as color blocks; label them when they fit.
-      if (tile >= 22.0f) {
-        const std::string &label = state.opponentTiles[static_cast<std::size_t>(index)];
-        const int font = std::max(8, static_cast<int>(tile * 0.45f));
-        DrawText(label.c_str(),
-                 static_cast<int>(
-                     cell.x +
-                     (cell.width - static_cast<float>(MeasureText(label.c_str(), font))) / 2.0f),
-                 static_cast<int>(cell.y + (cell.height - static_cast<float>(font)) / 2.0f), font,
-                 BLACK);
-      }
-    }
-  }
+  static BoardView::TileAtlas atlas;
+  atlas.prepare(grid, tile,
+                BoardView::CardStyle{.frame = BLANK,
+                                     .tile = solved ? GREEN : Color{200, 110, 40, 255},
+                                     .hole = Color{40, 30, 55, 255},
+                                     .label = BLACK,
+                                     .border = 1.0f,
+                                     .labelScale = 0.45f,
+                                     .minLabelTile = 22.0f});
+  static BoardView::BoardAnimation animation;
+  animation.update(state.opponentTiles, grid, GetFrameTime());
+  BoardView::drawBoard(atlas, state.opponentTiles, grid, {originX, originY}, tile, &animation);
 
   DrawText(state.opponentName.c_str(), static_cast<int>(originX),
            static_cast<int>(originY + preview + 8.0f), 14, ORANGE);
@@ -284,9 +260,12 @@ void draw(const MultiplayerFeature::State &state) {
   const BoardLayout layout = boardLayout(state.gridSize);
   const float board = layout.tile * static_cast<float>(state.gridSize);
   DrawRectangleRec({layout.originX, layout.originY, board, board}, DARKPURPLE);
-  for (int index = 0; index < static_cast<int>(state.tiles.size()); ++index) {
-    drawCard(state.tiles[index], rectangleForIndex(index, state.gridSize));
-  }
+  static BoardView::TileAtlas atlas;
+  atlas.prepare(state.gridSize, layout.tile);
+  static BoardView::BoardAnimation animation;
+  animation.update(state.tiles, state.gridSize, GetFrameTime());
+  BoardView::drawBoard(atlas, state.tiles, state.gridSize, {layout.originX, layout.originY},
+                       layout.tile, &animation);
   drawOpponentPreview(state);
 
   if (MultiplayerFeature::isBoardSolved(state)) {
@@ -23,6 +23,7 @@ using PuzzleCore::solvedTiles;
 using Dependencies::RandomNumberGenerator;
 
 constexpr std::string_view kSolverCancelId = "auto-solve";
+constexpr std::chrono::milliseconds kSolveDeadline{3'000}; // anytime plans stop improving
 
 void startNewGame(State &state, int grid, RandomNumberGenerator &rng) {
   state.grid = grid;
@@ -39,6 +40,19 @@ bool applySlide(State &state, int pos) {
   return PuzzleCore::slide(state.tiles, state.moveHistory, state.grid, pos);
 }
 
+// A plan from the board the auto-solve began on, as taps from the current
+// board: undo the moves played since, then follow it. Slides that cancel out
+// at the seam (the plan agreeing with what already played) are dropped.
+std::vector<int> planFromHere(const State &state, const std::vector<int> &plan) {
+  std::vector<int> taps;
+  for (std::size_t i = state.moveHistory.size(); i > state.solveFrom; --i) {
+    // Undoing the tap at i - 1 taps where the empty cell was before it.
+    taps.push_back(i >= 2 ? state.moveHistory[i - 2] : state.grid * state.grid - 1);
+  }
+  taps.insert(taps.end(), plan.begin(), plan.end());
+  return PuzzleCore::withoutBacktracks(taps, PuzzleCore::emptyIndex(state.tiles).value_or(0));
+}
+
 } // namespace
 
 State initialState(Sharing::Shared<AppSettings::Settings> settings) {
@@ -125,17 +139,21 @@ ComposableArchitecture::Feature<State, Action> body() {
                      stopSolving();
                    } else if (state.startDate.has_value() && !state.isGameOver) {
                      state.isSolving = true;
-                     // Run the (history-reversing) planner on a background
-                     // task; it reports the solution back as an action.
+                     state.solveFrom = state.moveHistory.size();
+                     // Run the planner on a background task; it reports each
+                     // plan it finds (shorter every time) back as an action.
                      // Cancellable by id.
                      store.addTask(
-                         [history = state.moveHistory, grid = state.grid](FeatureStore &store,
-                                                                          std::stop_token stop) {
+                         [history = state.moveHistory, grid = state.grid,
+                          mode = state.solveMode](FeatureStore &store, std::stop_token stop) {
                            Dependencies::Dependency<SolverClient::Key> solver;
-                           auto plan = solver->plan(history, grid, std::move(stop));
-                           if (plan.has_value()) {
-                             store.send(SolverSucceeded{std::move(*plan)});
-                           } else {
+                           auto plan = solver->plan(
+                               history, grid, mode, kSolveDeadline,
+                               [&store](const std::vector<int> &moves) {
+                                 store.send(SolverSucceeded{moves});
+                               },
+                               std::move(stop));
+                           if (!plan.has_value()) {
                              store.send(SolverFailed{plan.error()});
                            }
                          },
@@ -150,14 +168,20 @@ ComposableArchitecture::Feature<State, Action> body() {
                        [grid = value.grid](AppSettings::Settings &s) { s.lastBoardSize = grid; });
                    persistSettings();
                  } else if constexpr (std::is_same_v<Value, SolverSucceeded>) {
-                   if (state.isSolving) {
-                     state.pendingMoves = std::move(value.moves);
-                     state.nextMoveAt = date->now();
+                   // The first plan starts the animation; a later one takes
+                   // over only if it finishes sooner from where the board is.
+                   const bool first = state.pendingMoves.empty();
+                   std::vector<int> moves = planFromHere(state, value.moves);
+                   if (state.isSolving && (first || moves.size() < state.pendingMoves.size())) {
+                     state.pendingMoves = std::move(moves);
+                     if (first) {
+                       state.nextMoveAt = date->now();
+                     }
                      const double count =
                          static_cast<double>(std::max<std::size_t>(1, state.pendingMoves.size()));
                      state.solveInterval = std::clamp(4.0 / count, 0.0008, 0.10);
                      if (state.pendingMoves.empty()) {
-                       state.isSolving = false;
+                       stopSolving();
                      }
                    }
                  } else if constexpr (std::is_same_v<Value, SolverFailed>) {
@@ -217,7 +241,7 @@ ComposableArchitecture::Feature<State, Action> body() {
                        ++applied;
                      }
                      if (state.isSolving && state.pendingMoves.empty()) {
-                       state.isSolving = false;
+                       stopSolving(); // done: the planner need not improve on it
                      }
                    }
                  }
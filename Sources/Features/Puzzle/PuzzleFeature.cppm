@@ -48,6 +48,10 @@ struct State {
   double solveInterval = 0.05;
   std::vector<int> moveHistory;  // slides from solved that produced `tiles`
   std::vector<int> pendingMoves; // queued auto-solve moves to animate
+  // How hard auto-solve searches for a short plan. The planner reports plans
+  // from the board the solve began on (`moveHistory` was `solveFrom` long).
+  SolverClient::PlanMode solveMode = SolverClient::PlanMode::anytime;
+  std::size_t solveFrom = 0;
   int secondsElapsed = 0;
   std::optional<double> startDate;
   std::vector<std::string> tiles;
@@ -5,6 +5,7 @@ module;
 export module PuzzleFeatureView;
 
 import std;
+import BoardView;
 import PuzzleFeature;
 
 export namespace PuzzleFeatureView {
@@ -54,26 +55,6 @@ Rectangle rectangleForIndex(int index, int grid) {
           layout.originY + static_cast<float>(row) * layout.tile, layout.tile, layout.tile};
 }
 
-void drawCard(const std::string &text, Rectangle rect, unsigned char alpha = 255) {
-  const float fade = static_cast<float>(alpha) / 255.0f;
-  DrawRectangleRec(rect, Fade(BLACK, fade));
-  const Rectangle body{rect.x + 2.0f, rect.y + 2.0f, rect.width - 4.0f, rect.height - 4.0f};
-  DrawRectangleRec(body, Fade(text.empty() ? DARKPURPLE : ORANGE, fade));
-
-  if (!text.empty()) {
-    int fontSize = std::max(10, static_cast<int>(rect.height * 0.5f));
-    // Shrink to fit wide labels on large boards (raylib fonts are
-    // integer-sized).
-    while (fontSize > 8 && MeasureText(text.c_str(), fontSize) > static_cast<int>(rect.width) - 8) {
-      --fontSize;
-    }
-    const int x = static_cast<int>(
-        rect.x + (rect.width - static_cast<float>(MeasureText(text.c_str(), fontSize))) / 2.0f);
-    const int y = static_cast<int>(rect.y + (rect.height - static_cast<float>(fontSize)) / 2.0f);
-    DrawText(text.c_str(), x, y, fontSize, Fade(BLACK, fade));
-  }
-}
-
 float easeOutCubic(float t) {
   const float u = 1.0f - t;
   return 1.0f - u * u * u;
@@ -95,6 +76,20 @@ double boardAppearElapsed(const PuzzleFeature::State &state) {
   return GetTime() - animStart;
 }
 
+// The solo board's render state, owned by this view: its tile atlas and its
+// slide animation (flat, indexed by tile id). Any other board on screen owns
+// its own `BoardView::BoardAnimation`, so boards animate independently.
+struct GameBoard {
+  BoardView::TileAtlas atlas;
+  BoardView::BoardAnimation animation;
+  std::vector<BoardView::TileQuad> quads; // reused so a frame doesn't allocate
+};
+
+GameBoard &gameBoard() {
+  static GameBoard board;
+  return board;
+}
+
 void drawBoard(const PuzzleFeature::State &state, double appear) {
   const BoardLayout layout = boardLayout(state.grid);
   const float board = layout.tile * static_cast<float>(state.grid);
@@ -102,18 +97,13 @@ void drawBoard(const PuzzleFeature::State &state, double appear) {
 
   // Sliding tiles: each tile eases from where it was last frame toward its
   // current target cell, so a move (or a reshuffle) glides instead of
-  // teleporting. The animated positions live in a view-only cache keyed by tile
-  // label; a change in grid size resets it so a new board snaps into place. On
-  // top of the slide, freshly-appearing tiles fade+drop in (the intro feel).
-  static int cachedGrid = -1;
-  static std::unordered_map<std::string, Vector2> positions;
-  if (state.grid != cachedGrid) {
-    positions.clear();
-    cachedGrid = state.grid;
-  }
-  // Frame-rate-independent ease toward the target (~120ms to close the gap).
-  const float dt = GetFrameTime();
-  const float blend = 1.0f - std::exp(-dt * 18.0f);
+  // teleporting; a change in grid size snaps the new board into place. On top
+  // of the slide, freshly-appearing tiles fade+drop in (the intro feel). Cards
+  // come pre-rendered from the atlas and the board goes out as one quad run.
+  GameBoard &view = gameBoard();
+  view.atlas.prepare(state.grid, layout.tile);
+  view.animation.update(state.tiles, state.grid, GetFrameTime());
+  view.quads.clear();
 
   const int count = state.grid * state.grid;
   constexpr float spread = 0.3f;
@@ -121,32 +111,25 @@ void drawBoard(const PuzzleFeature::State &state, double appear) {
 
   // Draw the empty tile first so it always renders beneath numbered tiles
   if (auto it = std::ranges::find(state.tiles, std::string{}); it != state.tiles.end()) {
-    const int holeIndex = std::distance(state.tiles.begin(), it);
-    const Rectangle holeTarget = rectangleForIndex(holeIndex, state.grid);
-    drawCard(state.tiles[holeIndex], holeTarget);
+    const int holeIndex = static_cast<int>(std::distance(state.tiles.begin(), it));
+    view.quads.push_back(
+        {.id = 0, .rect = rectangleForIndex(holeIndex, state.grid), .alpha = 255});
   }
 
   for (int index = 0; index < static_cast<int>(state.tiles.size()); ++index) {
-    const Rectangle target = rectangleForIndex(index, state.grid);
-    if (state.tiles[index].empty()) {
+    const std::string &label = state.tiles[static_cast<std::size_t>(index)];
+    if (label.empty()) {
       continue; // already drawn
     }
-
-    const std::string &label = state.tiles[index];
-    Vector2 &pos = positions[label];
-    // First sight of this label: snap to the target (no slide from origin).
-    if (pos.x == 0.0f && pos.y == 0.0f) {
-      pos = {target.x, target.y};
-    } else {
-      pos.x += (target.x - pos.x) * blend;
-      pos.y += (target.y - pos.y) * blend;
-    }
+    const int id = BoardView::tileId(label);
+    const Vector2 cell = view.animation.cell(id);
 
     // Appear fade/drop, staggered by cell, only while the board is settling in.
     const float progress = std::clamp(
         static_cast<float>((appear - static_cast<double>(index) / count * spread) / duration), 0.0f,
         1.0f);
-    Rectangle rect{pos.x, pos.y, target.width, target.height};
+    Rectangle rect{layout.originX + cell.x * layout.tile, layout.originY + cell.y * layout.tile,
+                   layout.tile, layout.tile};
     unsigned char alpha = 255;
     if (progress < 1.0f) {
       const float eased = easeOutCubic(progress);
@@ -154,8 +137,9 @@ void drawBoard(const PuzzleFeature::State &state, double appear) {
       rect.y = startY + (rect.y - startY) * eased;
       alpha = static_cast<unsigned char>(255 * progress);
     }
-    drawCard(label, rect, alpha);
+    view.quads.push_back({.id = id, .rect = rect, .alpha = alpha});
   }
+  BoardView::drawQuads(view.atlas, view.quads);
 }
 
 // A small confetti burst for the victory overlay — view-only, seeded once per
@@ -1,11 +1,19 @@
+module;
+
+// JSON stays private to this implementation unit (see ServerRouter).
+#include <nlohmann/json.hpp>
+
 module GameServer; // implementation unit
 
 import std;
+import AllocationTracking;
 import Dependencies;
+import Metrics;
 import MultiplayerCore;
 import PuzzleCore;
 import SharedModels;
 import TcpSocket;
+import Tracing;
 
 namespace GameServer {
 
@@ -71,6 +79,7 @@ Output Engine::join(PlayerId player, std::string name, int gridSize) {
   room->boards[player] = Board{.name = name, .tiles = PuzzleCore::scrambled(grid, room->seed)};
   rooms_[opponent.player] = room;
   rooms_[player] = room;
+  ++activeRooms_;
 
   Output output{
       .messages = {
@@ -86,6 +95,7 @@ Output Engine::join(PlayerId player, std::string name, int gridSize) {
                                                              .playerA = opponent.name,
                                                              .playerB = name});
   broadcastToObservers(output, presence());
+  output.deals.push_back(Deal{.grid = grid, .seed = room->seed});
   return output;
 }
 
@@ -122,6 +132,7 @@ Output Engine::move(PlayerId player, int index) {
 Output Engine::finishRoom(Room &room, PlayerId winner) {
   Dependencies::Dependency<Dependencies::DateGeneratorKey> date;
   room.finished = true;
+  --activeRooms_;
 
   const Board &winnerBoard = room.boards[winner];
   const double now = date->now();
@@ -139,7 +150,8 @@ Output Engine::finishRoom(Room &room, PlayerId winner) {
                                                          .gridSize = room.grid,
                                                          .moves = moves,
                                                          .duration = duration,
-                                                         .playedAt = now});
+                                                         .playedAt = now,
+                                                         .seed = room.seed});
   // Announce the finish to the live feed.
   broadcastToObservers(output, MultiplayerCore::MatchEnded{.matchId = room.matchId,
                                                            .winnerName = winnerBoard.name,
@@ -203,6 +215,7 @@ Output Engine::leave(PlayerId player) {
   Output output;
   if (!room->finished) {
     room->finished = true; // a walkover ends the race; no result is recorded
+    --activeRooms_;
     std::string remainingName;
     for (const auto &[id, board] : room->boards) {
       if (id != player) {
@@ -222,24 +235,157 @@ Output Engine::leave(PlayerId player) {
   return output;
 }
 
+EngineSnapshot Engine::snapshot() const {
+  Dependencies::Dependency<Dependencies::DateGeneratorKey> date;
+  EngineSnapshot snapshot{.takenAt = date->now(), .observers = static_cast<int>(observers_.size())};
+  for (const auto &[grid, waiting] : waitingByGrid_) {
+    ++snapshot.queuedByGrid[grid];
+  }
+  std::set<const Room *> seen;
+  for (const auto &[id, room] : rooms_) {
+    if (!seen.insert(room.get()).second) {
+      continue; // both players point at the same room
+    }
+    RoomSnapshot entry{.matchId = room->matchId,
+                       .gridSize = room->grid,
+                       .ageSeconds = snapshot.takenAt - room->startedAt,
+                       .finished = room->finished};
+    for (const auto &[player, board] : room->boards) {
+      entry.moves.push_back(static_cast<int>(board.history.size()));
+      snapshot.boardBytes += board.tiles.capacity() * sizeof(std::string);
+      snapshot.historyBytes += board.history.capacity() * sizeof(int);
+    }
+    if (!room->finished) {
+      ++snapshot.roomsByGrid[room->grid];
+    }
+    snapshot.rooms.push_back(std::move(entry));
+  }
+  std::ranges::sort(snapshot.rooms, {}, &RoomSnapshot::matchId);
+  return snapshot;
+}
+
+std::string encodeSnapshot(const EngineSnapshot &snapshot) {
+  using nlohmann::json;
+  const auto byGrid = [](const std::map<int, int> &counts) {
+    json object = json::object();
+    for (const auto &[grid, count] : counts) {
+      object[std::to_string(grid)] = count;
+    }
+    return object;
+  };
+  json rooms = json::array();
+  for (const RoomSnapshot &room : snapshot.rooms) {
+    rooms.push_back({{"matchId", room.matchId},
+                     {"gridSize", room.gridSize},
+                     {"ageSeconds", room.ageSeconds},
+                     {"finished", room.finished},
+                     {"moves", room.moves}});
+  }
+  return json{{"takenAt", snapshot.takenAt},
+              {"roomsByGrid", byGrid(snapshot.roomsByGrid)},
+              {"queuedByGrid", byGrid(snapshot.queuedByGrid)},
+              {"observers", snapshot.observers},
+              {"boardBytes", snapshot.boardBytes},
+              {"historyBytes", snapshot.historyBytes},
+              {"rooms", std::move(rooms)}}
+      .dump();
+}
+
 // --- Socket shell --------------------------------------------------------------
 
 namespace {
 
+const Metrics::Counter connectionsAccepted{"fifteen_mp_connections_accepted_total",
+                                           "Multiplayer connections accepted."};
+const Metrics::Counter connectionsRefused{"fifteen_mp_connections_refused_total",
+                                          "Multiplayer connections refused with ServerFull."};
+const Metrics::Gauge connectionsActive{"fifteen_mp_connections_active",
+                                       "Multiplayer connections currently open."};
+const Metrics::Gauge roomsActive{"fifteen_mp_rooms_active", "Matches currently in progress."};
+const Metrics::Counter movesTotal{"fifteen_mp_moves_total", "Moves received from players."};
+const Metrics::Counter movesRejected{"fifteen_mp_moves_rejected_total",
+                                     "Moves the referee rejected as illegal."};
+const Metrics::Histogram moveRelaySeconds{
+    "fifteen_mp_move_relay_seconds",
+    "Move line read to every resulting message sent (opponent and observers)."};
+const Metrics::Histogram engineLockWaitSeconds{"fifteen_mp_engine_lock_wait_seconds",
+                                               "Time spent waiting for the engine mutex."};
+
+// Allocation scopes (FIFTEEN_ALLOCATION_TRACKING) for the per-message stages.
+const AllocationTracking::Tag decodeAllocations{"decode"};
+const AllocationTracking::Tag engineAllocations{"engine"};
+const AllocationTracking::Tag encodeAllocations{"encode"};
+
+// How stale a published snapshot may get while the engine is changing.
+constexpr auto kSnapshotInterval = std::chrono::seconds(1);
+
+// The latest published snapshot. Only the pointer copy is locked, so a poll of
+// GET /admin/engine never waits on the engine mutex.
+struct PublishedSnapshot {
+  std::mutex mutex;
+  std::shared_ptr<const EngineSnapshot> snapshot;
+};
+
+PublishedSnapshot &published() {
+  static PublishedSnapshot instance;
+  return instance;
+}
+
+bool rejectsMove(const Output &output) {
+  return std::ranges::any_of(output.messages, [](const Outbound &outbound) {
+    return std::holds_alternative<MultiplayerCore::MoveRejected>(outbound.message);
+  });
+}
+
 struct Shared {
   std::mutex mutex; // guards the engine and the connection table
   Engine engine;
   std::map<PlayerId, std::shared_ptr<TcpSocket::Connection>> connections;
   std::function<void(const SharedModels::ScoreSubmission &)> onResult;
+  std::function<void(const Deal &)> onDeal;
   // Live worker count, for the connection cap. Incremented on the accept
   // thread before a worker is spawned, decremented by the worker on exit.
   std::atomic<int> activeConnections{0};
+  int publishedRooms = 0; // engine.activeRooms() as last added to the gauge
+  // The engine changed since the last snapshot; lock-free hint for idle workers.
+  std::atomic<bool> snapshotStale{true};
+  std::atomic<std::chrono::steady_clock::rep> nextSnapshot{0};
+
+  bool snapshotDue() const {
+    return snapshotStale.load(std::memory_order_relaxed) &&
+           std::chrono::steady_clock::now().time_since_epoch().count() >=
+               nextSnapshot.load(std::memory_order_relaxed);
+  }
+
+  // Must be called with `mutex` held.
+  void publishSnapshot() {
+    auto snapshot = std::make_shared<const EngineSnapshot>(engine.snapshot());
+    snapshotStale.store(false, std::memory_order_relaxed);
+    const auto next = std::chrono::steady_clock::now() + kSnapshotInterval;
+    nextSnapshot.store(next.time_since_epoch().count(), std::memory_order_relaxed);
+    PublishedSnapshot &slot = published();
+    std::scoped_lock lock(slot.mutex);
+    slot.snapshot = std::move(snapshot);
+  }
 
   // Must be called with `mutex` held.
   void deliver(const Output &output) {
+    roomsActive.add(engine.activeRooms() - publishedRooms);
+    publishedRooms = engine.activeRooms();
+    snapshotStale.store(true, std::memory_order_relaxed);
+    if (snapshotDue()) {
+      publishSnapshot();
+    }
     for (const auto &outbound : output.messages) {
       if (const auto it = connections.find(outbound.player); it != connections.end()) {
-        it->second->sendAll(MultiplayerCore::encode(outbound.message) + "\n");
+        std::string line;
+        {
+          const Tracing::Span span("encode");
+          const AllocationTracking::Scope allocations(encodeAllocations);
+          line = MultiplayerCore::encode(outbound.message) + "\n";
+        }
+        const Tracing::Span span("sendAll");
+        it->second->sendAll(line);
       }
     }
     for (const auto &result : output.results) {
@@ -247,6 +393,11 @@ struct Shared {
         onResult(result);
       }
     }
+    for (const auto &deal : output.deals) {
+      if (onDeal) {
+        onDeal(deal);
+      }
+    }
   }
 };
 
@@ -257,34 +408,70 @@ void servePlayer(std::shared_ptr<Shared> shared, PlayerId player,
 
   while (!stop.stop_requested()) {
     const auto read = connection->readLine();
+    const auto received = std::chrono::steady_clock::now();
     if (read.status == TcpSocket::ReadStatus::timedOut) {
+      // Idle workers publish the last change once the interval has passed, so
+      // a quiet server's snapshot does not stay a second behind forever.
+      if (shared->snapshotDue()) {
+        std::scoped_lock lock(shared->mutex);
+        if (shared->snapshotDue()) {
+          shared->publishSnapshot();
+        }
+      }
       continue;
     }
     if (read.status == TcpSocket::ReadStatus::closed) {
       break;
     }
-    const auto message = MultiplayerCore::decodeClientMessage(read.line);
+    // One span per handled line, around the decode / engine / encode / sendAll
+    // spans it contains (the blocking read itself is not traced).
+    const Tracing::Span span("servePlayer");
+    std::optional<MultiplayerCore::ClientMessage> message;
+    {
+      const Tracing::Span decode("decode");
+      const AllocationTracking::Scope allocations(decodeAllocations);
+      message = MultiplayerCore::decodeClientMessage(read.line);
+    }
     if (!message.has_value()) {
       continue; // garbage line; ignore rather than kill the connection
     }
     bool left = false;
+    bool moved = false;
     {
+      const auto waiting = std::chrono::steady_clock::now();
       std::scoped_lock lock(shared->mutex);
-      std::visit(
-          [&](auto &&value) {
-            using V = std::decay_t<decltype(value)>;
-            if constexpr (std::is_same_v<V, MultiplayerCore::Join>) {
-              shared->deliver(shared->engine.join(player, value.name, value.gridSize));
-            } else if constexpr (std::is_same_v<V, MultiplayerCore::Move>) {
-              shared->deliver(shared->engine.move(player, value.index));
-            } else if constexpr (std::is_same_v<V, MultiplayerCore::Observe>) {
-              shared->deliver(shared->engine.observe(player));
-            } else if constexpr (std::is_same_v<V, MultiplayerCore::Leave>) {
-              shared->deliver(shared->engine.leave(player));
-              left = true;
-            }
-          },
-          *message);
+      engineLockWaitSeconds.observe(std::chrono::steady_clock::now() - waiting);
+      Output output;
+      {
+        const Tracing::Span engine("engine");
+        const AllocationTracking::Scope allocations(engineAllocations);
+        output = std::visit(
+            [&](auto &&value) -> Output {
+              using V = std::decay_t<decltype(value)>;
+              if constexpr (std::is_same_v<V, MultiplayerCore::Join>) {
+                return shared->engine.join(player, value.name, value.gridSize);
+              } else if constexpr (std::is_same_v<V, MultiplayerCore::Move>) {
+                moved = true;
+                return shared->engine.move(player, value.index);
+              } else if constexpr (std::is_same_v<V, MultiplayerCore::Observe>) {
+                return shared->engine.observe(player);
+              } else if constexpr (std::is_same_v<V, MultiplayerCore::Leave>) {
+                left = true;
+                return shared->engine.leave(player);
+              }
+            },
+            *message);
+      }
+      if (moved) {
+        movesTotal.inc();
+        if (rejectsMove(output)) {
+          movesRejected.inc();
+        }
+      }
+      shared->deliver(output);
+    }
+    if (moved) {
+      moveRelaySeconds.observe(std::chrono::steady_clock::now() - received);
     }
     if (left) {
       break;
@@ -295,15 +482,27 @@ void servePlayer(std::shared_ptr<Shared> shared, PlayerId player,
     std::scoped_lock lock(shared->mutex);
     shared->deliver(shared->engine.leave(player)); // no-op if the player already left
     shared->connections.erase(player);
+    if (shared->connections.empty()) {
+      // No worker is left to publish on a read timeout, and the accept loop
+      // blocks, so the last one out publishes whether or not it is due.
+      shared->publishSnapshot();
+    }
   }
   connection->close();
+  connectionsActive.dec();
   shared->activeConnections.fetch_sub(1, std::memory_order_release);
 }
 
 } // namespace
 
+std::shared_ptr<const EngineSnapshot> latestSnapshot() {
+  PublishedSnapshot &slot = published();
+  std::scoped_lock lock(slot.mutex);
+  return slot.snapshot;
+}
+
 bool run(int port, std::function<void(const SharedModels::ScoreSubmission &)> onResult,
-         int maxConnections, std::stop_token stop) {
+         std::function<void(const Deal &)> onDeal, int maxConnections, std::stop_token stop) {
   auto listener = TcpSocket::Listener::bind(port);
   if (!listener.has_value()) {
     return false;
@@ -312,6 +511,11 @@ bool run(int port, std::function<void(const SharedModels::ScoreSubmission &)> on
 
   auto shared = std::make_shared<Shared>();
   shared->onResult = std::move(onResult);
+  shared->onDeal = std::move(onDeal);
+  {
+    std::scoped_lock lock(shared->mutex);
+    shared->publishSnapshot(); // an empty engine, so /admin/engine answers at once
+  }
 
   // A worker plus a flag it raises when it returns, so the accept loop can
   // reap finished threads instead of letting the vector grow forever.
@@ -344,11 +548,14 @@ bool run(int port, std::function<void(const SharedModels::ScoreSubmission &)> on
           MultiplayerCore::encode(MultiplayerCore::ServerMessage{MultiplayerCore::ServerFull{}}) +
           "\n");
       connection->close();
+      connectionsRefused.inc();
       continue;
     }
 
     const PlayerId player = nextPlayer++;
     shared->activeConnections.fetch_add(1, std::memory_order_release);
+    connectionsAccepted.inc();
+    connectionsActive.inc();
     {
       std::scoped_lock lock(shared->mutex);
       shared->connections[player] = connection;
@@ -25,12 +25,46 @@ struct Outbound {
   MultiplayerCore::ServerMessage message;
 };
 
+// A board the engine dealt: both players of a match race the same one.
+struct Deal {
+  int grid = 4;
+  std::uint64_t seed = 0;
+
+  bool operator==(const Deal &) const = default;
+};
+
 struct Output {
   std::vector<Outbound> messages;
   // Server-verified finished games: the winner's row, ready for the
   // leaderboard database. (Verified because the engine itself replayed every
-  // move that produced it.)
+  // move that produced it.) `seed` names the deal; `par` is left to the shell.
   std::vector<SharedModels::ScoreSubmission> results;
+  // Boards dealt by this call, so their par can be worked out while the match
+  // is still being played.
+  std::vector<Deal> deals;
+};
+
+// A point-in-time view of the engine for GET /admin/engine. Built by
+// `Engine::snapshot` on whichever thread holds the engine, then published
+// read-only, so reading one never touches the live engine.
+struct RoomSnapshot {
+  int matchId = 0;
+  int gridSize = 4;
+  double ageSeconds = 0.0;
+  bool finished = false;  // won or walked over, but a player has not left yet
+  std::vector<int> moves; // per player, by player id
+};
+
+struct EngineSnapshot {
+  double takenAt = 0.0;            // DateGenerator time
+  std::map<int, int> roomsByGrid;  // matches in progress
+  std::map<int, int> queuedByGrid; // players waiting for an opponent
+  int observers = 0;
+  std::vector<RoomSnapshot> rooms; // every room still held, by match id
+  // Heap held by the referee's boards: tile vectors (labels fit in the
+  // small-string buffer) and move histories, by capacity.
+  std::size_t boardBytes = 0;
+  std::size_t historyBytes = 0;
 };
 
 class Engine {
@@ -43,6 +77,13 @@ public:
   // MatchStarted for every match already in progress.
   Output observe(PlayerId player);
 
+  // Matches in progress (started, not yet finished or walked over). O(1), for
+  // the server's metrics.
+  int activeRooms() const { return activeRooms_; }
+
+  // O(rooms); the socket shell calls it at most once per publish interval.
+  EngineSnapshot snapshot() const;
+
 private:
   struct Board {
     std::string name;
@@ -75,16 +116,27 @@ private:
   std::map<PlayerId, std::shared_ptr<Room>> rooms_; // both players point at the same room
   std::set<PlayerId> observers_;                    // subscribed to the live feed
   int nextMatchId_ = 1;
+  int activeRooms_ = 0;
 };
 
 // The socket shell: accepts connections on `port`, decodes line-JSON client
 // messages, drives a mutex-guarded Engine, and delivers its outbound messages.
 // `onResult` receives each server-verified result (the server main persists
-// them to the leaderboard database). `maxConnections` caps concurrent workers
-// (<= 0 means unbounded); connections over the cap get a typed `ServerFull`
-// and are closed. Finished worker threads are reaped as new ones arrive.
-// Returns false if the port cannot be bound; otherwise blocks until `stop`.
+// them to the leaderboard database) and `onDeal` each new deal (the server main
+// queues its par); both run with the engine locked, so neither may wait on a
+// solver. `maxConnections` caps concurrent workers (<= 0 means unbounded);
+// connections over the cap get a typed `ServerFull` and are closed. Finished
+// worker threads are reaped as new ones arrive. Returns false if the port
+// cannot be bound; otherwise blocks until `stop`.
 bool run(int port, std::function<void(const SharedModels::ScoreSubmission &)> onResult,
-         int maxConnections, std::stop_token stop);
+         std::function<void(const Deal &)> onDeal, int maxConnections, std::stop_token stop);
+
+// The snapshot `run` published last (at most a second old while anything is
+// happening), or nullptr before the first. Never waits on the engine: only a
+// pointer copy is locked.
+std::shared_ptr<const EngineSnapshot> latestSnapshot();
+
+// The JSON body of GET /admin/engine.
+std::string encodeSnapshot(const EngineSnapshot &snapshot);
 
 } // namespace GameServer
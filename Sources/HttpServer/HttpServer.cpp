@@ -1,6 +1,8 @@
 module HttpServer; // implementation unit
 
 import std;
+import AllocationTracking;
+import Metrics;
 import ServerRouter;
 import TcpSocket;
 
@@ -20,6 +22,8 @@ std::string_view statusText(int status) {
     return "Not Found";
   case 500:
     return "Internal Server Error";
+  case 503:
+    return "Service Unavailable";
   default:
     return "OK";
   }
@@ -91,6 +95,25 @@ std::optional<ServerRouter::Request> readRequest(TcpSocket::Connection &connecti
   return request;
 }
 
+// Request latency, accept to response written, one series per route.
+const Metrics::Histogram &requestSeconds(std::string_view route) {
+  static const auto series = [] {
+    std::map<std::string, Metrics::Histogram, std::less<>> series;
+    for (const std::string_view name :
+         {"leaderboard", "scores", "scores_batch", "metrics", "admin", "unknown"}) {
+      series.try_emplace(std::string(name), "fifteen_http_request_seconds",
+                         "HTTP request latency, accept to response written.",
+                         Metrics::Labels{{"route", std::string(name)}});
+    }
+    return series;
+  }();
+  const auto found = series.find(route);
+  return found != series.end() ? found->second : series.find("unknown")->second;
+}
+
+// Allocation scope (FIFTEEN_ALLOCATION_TRACKING): parse, handle and write.
+const AllocationTracking::Tag requestAllocations{"http_request"};
+
 void writeResponse(TcpSocket::Connection &connection, const ServerRouter::Response &response) {
   const std::string head = std::format(
       "HTTP/1.1 {} {}\r\nContent-Type: {}\r\nContent-Length: {}\r\n"
@@ -116,12 +139,19 @@ bool serve(int port, Handler handler, std::stop_token stop) {
     if (!connection.has_value()) {
       continue; // listener closed (shutdown) or transient accept failure
     }
+    const auto accepted = std::chrono::steady_clock::now();
     connection->setReceiveTimeout(std::chrono::seconds(5));
-    if (auto request = readRequest(*connection)) {
-      writeResponse(*connection, handler(*request));
-    } else {
-      writeResponse(*connection, ServerRouter::Response{.status = 400, .body = "{}"});
+    std::string_view route = "unknown";
+    {
+      const AllocationTracking::Scope allocations(requestAllocations);
+      if (auto request = readRequest(*connection)) {
+        route = ServerRouter::routeName(*request);
+        writeResponse(*connection, handler(*request));
+      } else {
+        writeResponse(*connection, ServerRouter::Response{.status = 400, .body = "{}"});
+      }
     }
+    requestSeconds(route).observe(std::chrono::steady_clock::now() - accepted);
     connection->close();
   }
   return true;
@@ -0,0 +1,184 @@
+module Metrics; // implementation unit
+
+import std;
+
+namespace Metrics {
+
+namespace {
+
+struct Descriptor {
+  Kind kind = Kind::counter;
+  std::string name;
+  std::string help;
+  Labels labels;
+  std::vector<double> bounds; // histograms only, in seconds
+  std::size_t slot = 0;
+};
+
+struct Registry {
+  std::mutex mutex; // guards everything below; never taken on a recording path
+  std::vector<Descriptor> metrics;
+  std::vector<const Shard *> shards;
+  std::array<std::uint64_t, kMaxSlots> retired{}; // folded in by exited threads
+  std::size_t nextSlot = 0;
+};
+
+// Leaked on purpose: shards of threads that outlive static destruction (or
+// exit during it) still fold into a live registry.
+Registry &registry() {
+  static Registry *instance = new Registry;
+  return *instance;
+}
+
+// Must be called with the registry mutex held.
+std::uint64_t sumLocked(const Registry &r, std::size_t slot) {
+  std::uint64_t sum = r.retired[slot];
+  for (const Shard *shard : r.shards) {
+    sum += shard->slots[slot].load(std::memory_order_relaxed);
+  }
+  return sum;
+}
+
+std::string escape(std::string_view value) {
+  std::string out;
+  for (const char c : value) {
+    if (c == '\\' || c == '"') {
+      out += '\\';
+      out += c;
+    } else if (c == '\n') {
+      out += "\\n";
+    } else {
+      out += c;
+    }
+  }
+  return out;
+}
+
+// `{a="x",b="y"}` (or nothing), with `extra` appended as the last label.
+std::string labelSet(const Labels &labels, std::string_view extraName = {},
+                     std::string_view extraValue = {}) {
+  std::string out;
+  const auto append = [&out](std::string_view name, std::string_view value) {
+    out += out.empty() ? "{" : ",";
+    out += std::format("{}=\"{}\"", name, escape(value));
+  };
+  for (const auto &[name, value] : labels) {
+    append(name, value);
+  }
+  if (!extraName.empty()) {
+    append(extraName, extraValue);
+  }
+  if (!out.empty()) {
+    out += '}';
+  }
+  return out;
+}
+
+std::string_view typeName(Kind kind) {
+  switch (kind) {
+  case Kind::counter:
+    return "counter";
+  case Kind::gauge:
+    return "gauge";
+  case Kind::histogram:
+    return "histogram";
+  }
+  return "untyped";
+}
+
+} // namespace
+
+Shard::Shard() {
+  Registry &r = registry();
+  std::scoped_lock lock(r.mutex);
+  r.shards.push_back(this);
+}
+
+Shard::~Shard() {
+  Registry &r = registry();
+  std::scoped_lock lock(r.mutex);
+  for (std::size_t i = 0; i < r.nextSlot; ++i) {
+    r.retired[i] += slots[i].load(std::memory_order_relaxed);
+  }
+  std::erase(r.shards, this);
+}
+
+std::size_t registerMetric(Kind kind, std::string name, std::string help, Labels labels,
+                           std::vector<double> bounds, std::size_t count) {
+  Registry &r = registry();
+  std::scoped_lock lock(r.mutex);
+  if (r.nextSlot + count > kMaxSlots) {
+    throw std::length_error("Metrics: out of slots registering " + name);
+  }
+  const std::size_t slot = r.nextSlot;
+  r.nextSlot += count;
+  r.metrics.push_back(Descriptor{.kind = kind,
+                                 .name = std::move(name),
+                                 .help = std::move(help),
+                                 .labels = std::move(labels),
+                                 .bounds = std::move(bounds),
+                                 .slot = slot});
+  return slot;
+}
+
+std::uint64_t total(std::size_t slot) {
+  Registry &r = registry();
+  std::scoped_lock lock(r.mutex);
+  return sumLocked(r, slot);
+}
+
+std::string scrape() {
+  Registry &r = registry();
+  std::scoped_lock lock(r.mutex);
+
+  // Group label variants under one HELP/TYPE header, in registration order.
+  std::vector<std::string_view> names;
+  for (const Descriptor &metric : r.metrics) {
+    if (std::ranges::find(names, metric.name) == names.end()) {
+      names.push_back(metric.name);
+    }
+  }
+
+  std::string out;
+  for (const std::string_view name : names) {
+    bool headed = false;
+    for (const Descriptor &metric : r.metrics) {
+      if (metric.name != name) {
+        continue;
+      }
+      if (!headed) {
+        out += std::format("# HELP {} {}\n# TYPE {} {}\n", name, metric.help, name,
+                           typeName(metric.kind));
+        headed = true;
+      }
+      switch (metric.kind) {
+      case Kind::counter:
+        out += std::format("{}{} {}\n", name, labelSet(metric.labels),
+                           sumLocked(r, metric.slot));
+        break;
+      case Kind::gauge:
+        out += std::format("{}{} {}\n", name, labelSet(metric.labels),
+                           static_cast<std::int64_t>(sumLocked(r, metric.slot)));
+        break;
+      case Kind::histogram: {
+        std::uint64_t cumulative = 0;
+        for (std::size_t i = 0; i <= metric.bounds.size(); ++i) {
+          cumulative += sumLocked(r, metric.slot + i);
+          const std::string le =
+              i < metric.bounds.size() ? std::format("{}", metric.bounds[i]) : "+Inf";
+          out += std::format("{}_bucket{} {}\n", name, labelSet(metric.labels, "le", le),
+                             cumulative);
+        }
+        const double sum =
+            static_cast<double>(sumLocked(r, metric.slot + metric.bounds.size() + 1)) / 1e9;
+        out += std::format("{}_sum{} {}\n", name, labelSet(metric.labels), sum);
+        out += std::format("{}_count{} {}\n", name, labelSet(metric.labels), cumulative);
+        break;
+      }
+      }
+    }
+  }
+  return out;
+}
+
+} // namespace Metrics
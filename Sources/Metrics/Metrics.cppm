@@ -0,0 +1,164 @@
+export module Metrics;
+
+import std;
+
+// Process-wide server metrics in the Prometheus text format, cheap enough for
+// the hot paths (every relayed move, every HTTP request, every DB call).
+//
+// Each metric owns a few slots in a fixed-size, per-thread shard. A thread
+// only ever writes its own shard, so recording is a relaxed load + store on a
+// thread-local cache line — no lock, no contended atomic read-modify-write.
+// `scrape()` sums the slots across every live shard (plus the totals folded in
+// by threads that have exited) and renders the exposition text; that is the
+// only place a mutex is taken. Rates (moves/sec, requests/sec) are left to the
+// scraper: `rate(fifteen_mp_moves_total[1m])`.
+//
+// Metrics are declared as statics next to the code they measure:
+//
+//   Metrics::Counter accepted{"fifteen_mp_connections_accepted_total", "..."};
+//   accepted.inc();
+export namespace Metrics {
+
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+// Latency buckets (seconds) for every histogram unless one passes its own:
+// 50µs to 2.5s, roughly 1-2.5-5 per decade.
+inline const std::vector<double> kLatencyBuckets{0.00005, 0.0001, 0.00025, 0.0005, 0.001,
+                                                 0.0025,  0.005,  0.01,    0.025,  0.05,
+                                                 0.1,     0.25,   0.5,     1.0,    2.5};
+
+} // namespace Metrics
+
+namespace Metrics {
+
+// Slots per thread shard; every metric reserves its slots once, at
+// registration. 512 covers a histogram per route with plenty to spare.
+constexpr std::size_t kMaxSlots = 512;
+
+// One thread's slots. Registers itself on first use and, at thread exit, folds
+// its values into the registry's retired totals so a reaped connection thread
+// never loses counts.
+struct Shard {
+  Shard();
+  ~Shard();
+  Shard(const Shard &) = delete;
+  Shard &operator=(const Shard &) = delete;
+
+  std::array<std::atomic<std::uint64_t>, kMaxSlots> slots{};
+};
+
+inline Shard &localShard() {
+  thread_local Shard shard;
+  return shard;
+}
+
+// Single-writer add: only the owning thread stores to its shard, so a plain
+// load + store is enough (scrapers read with relaxed loads). Unsigned
+// wrap-around makes negative gauge deltas sum correctly.
+inline void add(std::size_t slot, std::uint64_t delta) {
+  auto &value = localShard().slots[slot];
+  value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+enum class Kind : std::uint8_t { counter, gauge, histogram };
+
+// Reserves `count` slots for a metric and records how to render it.
+std::size_t registerMetric(Kind kind, std::string name, std::string help, Labels labels,
+                           std::vector<double> bounds, std::size_t count);
+
+// Sum of `slot` over every shard, live and retired.
+std::uint64_t total(std::size_t slot);
+
+} // namespace Metrics
+
+export namespace Metrics {
+
+// Monotonic count (`..._total`).
+class Counter {
+public:
+  Counter(std::string name, std::string help, Labels labels = {})
+      : slot_(registerMetric(Kind::counter, std::move(name), std::move(help), std::move(labels),
+                             {}, 1)) {}
+
+  void inc(std::uint64_t by = 1) const { add(slot_, by); }
+  std::uint64_t value() const { return total(slot_); }
+
+private:
+  std::size_t slot_;
+};
+
+// A value that goes up and down (active connections, active rooms). Sharded
+// like a counter, so it is adjusted by deltas; it cannot be `set`.
+class Gauge {
+public:
+  Gauge(std::string name, std::string help, Labels labels = {})
+      : slot_(registerMetric(Kind::gauge, std::move(name), std::move(help), std::move(labels), {},
+                             1)) {}
+
+  void add(std::int64_t delta) const { Metrics::add(slot_, static_cast<std::uint64_t>(delta)); }
+  void inc() const { add(1); }
+  void dec() const { add(-1); }
+  std::int64_t value() const { return static_cast<std::int64_t>(total(slot_)); }
+
+private:
+  std::size_t slot_;
+};
+
+// Durations in fixed buckets. Slots: one per bound, one for +Inf, then the sum
+// in nanoseconds; the count is the sum of the buckets.
+class Histogram {
+public:
+  Histogram(std::string name, std::string help, Labels labels = {},
+            const std::vector<double> &bounds = kLatencyBuckets)
+      : bounds_(toNanoseconds(bounds)),
+        slot_(registerMetric(Kind::histogram, std::move(name), std::move(help), std::move(labels),
+                             bounds, bounds.size() + 2)) {}
+
+  void observe(std::chrono::nanoseconds duration) const {
+    const auto ns = static_cast<std::uint64_t>(std::max<std::int64_t>(0, duration.count()));
+    const auto bucket = static_cast<std::size_t>(std::ranges::lower_bound(bounds_, ns) -
+                                                 bounds_.begin());
+    Metrics::add(slot_ + bucket, 1);
+    Metrics::add(slot_ + bounds_.size() + 1, ns);
+  }
+
+  std::uint64_t count() const {
+    std::uint64_t count = 0;
+    for (std::size_t i = 0; i <= bounds_.size(); ++i) {
+      count += total(slot_ + i);
+    }
+    return count;
+  }
+
+private:
+  static std::vector<std::uint64_t> toNanoseconds(const std::vector<double> &seconds) {
+    std::vector<std::uint64_t> out;
+    out.reserve(seconds.size());
+    for (const double bound : seconds) {
+      out.push_back(static_cast<std::uint64_t>(std::llround(bound * 1e9)));
+    }
+    return out;
+  }
+
+  std::vector<std::uint64_t> bounds_;
+  std::size_t slot_;
+};
+
+// Observes the lifetime of the scope into `histogram`.
+class Timer {
+public:
+  explicit Timer(const Histogram &histogram)
+      : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+  ~Timer() { histogram_.observe(std::chrono::steady_clock::now() - start_); }
+  Timer(const Timer &) = delete;
+  Timer &operator=(const Timer &) = delete;
+
+private:
+  const Histogram &histogram_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+// Every registered metric in the Prometheus text exposition format (0.0.4).
+std::string scrape();
+
+} // namespace Metrics
@@ -0,0 +1,123 @@
+module ParService; // implementation unit
+
+import std;
+import Metrics;
+import PuzzleCore;
+import SolverClient;
+
+namespace ParService {
+
+namespace {
+
+const Metrics::Counter parsComputed{"fifteen_par_computed_total", "Deals given a par."};
+const Metrics::Gauge parsPending{"fifteen_par_pending", "Deals queued or being solved for par."};
+const Metrics::Histogram parSeconds{"fifteen_par_seconds",
+                                    "Time to solve a deal for its par.",
+                                    {},
+                                    {0.001, 0.01, 0.1, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0, 60.0}};
+
+using Deal = std::pair<int, std::uint64_t>; // (grid, seed)
+
+} // namespace
+
+std::optional<Par> solve(const SolverClient::Client &solver, int grid, std::uint64_t seed,
+                         const Options &options, std::stop_token stop) {
+  const auto tiles = PuzzleCore::scrambled(grid, seed);
+  if (const auto hint = solver.hint(tiles, grid, options.hintBudget, stop);
+      hint.has_value() && hint->optimal) {
+    return Par{.moves = hint->distance, .optimal = true};
+  }
+  if (stop.stop_requested()) {
+    return std::nullopt;
+  }
+  const auto plan = solver.search(tiles, grid, options.searchBytes, stop);
+  if (!plan.has_value() || plan->moves.empty()) {
+    return std::nullopt;
+  }
+  return Par{.moves = static_cast<int>(plan->moves.size()), .optimal = plan->optimal};
+}
+
+struct Pool::State {
+  SolverClient::Client solver;
+  Options options;
+  std::function<void(int, std::uint64_t, Par)> onPar;
+
+  mutable std::mutex mutex; // guards everything below
+  std::condition_variable_any wake;
+  std::deque<Deal> queue;
+  std::set<Deal> pending;                   // queued or being solved
+  std::map<Deal, std::optional<Par>> cache; // nullopt: the solve found nothing
+  std::deque<Deal> cacheOrder;              // oldest first, for eviction
+
+  void work(std::stop_token stop) {
+    while (true) {
+      Deal deal;
+      {
+        std::unique_lock lock(mutex);
+        if (!wake.wait(lock, stop, [this] { return !queue.empty(); })) {
+          return;
+        }
+        deal = queue.front();
+        queue.pop_front();
+      }
+      const auto started = std::chrono::steady_clock::now();
+      const auto par = solve(solver, deal.first, deal.second, options, stop);
+      {
+        std::scoped_lock lock(mutex);
+        pending.erase(deal);
+        if (!stop.stop_requested() && cache.emplace(deal, par).second) {
+          cacheOrder.push_back(deal);
+          if (cache.size() > options.capacity) {
+            cache.erase(cacheOrder.front());
+            cacheOrder.pop_front();
+          }
+        }
+      }
+      parsPending.dec();
+      if (par.has_value()) {
+        parsComputed.inc();
+        parSeconds.observe(std::chrono::steady_clock::now() - started);
+        if (onPar) {
+          onPar(deal.first, deal.second, *par);
+        }
+      }
+    }
+  }
+};
+
+Pool::Pool(SolverClient::Client solver, Options options,
+           std::function<void(int, std::uint64_t, Par)> onPar)
+    : state_(std::make_shared<State>()) {
+  state_->solver = std::move(solver);
+  state_->options = options;
+  state_->onPar = std::move(onPar);
+  for (int i = 0; i < std::max(1, options.threads); ++i) {
+    workers_.emplace_back([state = state_](std::stop_token stop) { state->work(stop); });
+  }
+}
+
+void Pool::request(int grid, std::uint64_t seed) {
+  const Deal deal{grid, seed};
+  {
+    std::scoped_lock lock(state_->mutex);
+    if (state_->cache.contains(deal) || !state_->pending.insert(deal).second) {
+      return;
+    }
+    state_->queue.push_back(deal);
+  }
+  parsPending.inc();
+  state_->wake.notify_one();
+}
+
+std::optional<Par> Pool::lookup(int grid, std::uint64_t seed) const {
+  std::scoped_lock lock(state_->mutex);
+  const auto it = state_->cache.find(Deal{grid, seed});
+  return it == state_->cache.end() ? std::nullopt : it->second;
+}
+
+std::size_t Pool::pending() const {
+  std::scoped_lock lock(state_->mutex);
+  return state_->pending.size();
+}
+
+} // namespace ParService
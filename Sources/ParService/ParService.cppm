@@ -0,0 +1,63 @@
+export module ParService;
+
+import std;
+import SolverClient;
+
+// Par for multiplayer deals: the length of the shortest known solution of the
+// board the server dealt, so a leaderboard can rank a win by moves per par move
+// instead of raw moves, which mostly say how hard the deal was. A solve takes
+// from microseconds (a 4×4 hint) to seconds (a memory-bounded search on a big
+// board), so it never runs on the referee's thread: the engine reports each
+// deal as it is made, `request` queues it, and a pool of worker threads works
+// through the queue while the match is played. Pars are cached by (grid, seed),
+// so both players' results share one solve, and each is handed to `onPar` as
+// it is found, so a result stored before its par was ready can be filled in.
+export namespace ParService {
+
+struct Par {
+  int moves = 0;        // the shortest solution found
+  bool optimal = false; // proved shortest; otherwise near-optimal
+
+  bool operator==(const Par &) const = default;
+};
+
+struct Options {
+  int threads = 2;                                 // at least one
+  std::size_t capacity = 4096;                     // deals cached, oldest dropped first
+  std::chrono::milliseconds hintBudget{2'000};     // exact on most 4×4 deals within this
+  std::size_t searchBytes = std::size_t{64} << 20; // per worker, when the hint is not exact
+};
+
+// The par of the board `PuzzleCore::scrambled(grid, seed)` deals, as the pool
+// computes it: a hint (exact when its search finishes within the budget), else
+// a memory-bounded search (shortest if its frontiers fit, near-optimal if not).
+// Nullopt if neither found a solution or `stop` was requested.
+std::optional<Par> solve(const SolverClient::Client &solver, int grid, std::uint64_t seed,
+                         const Options &options, std::stop_token stop);
+
+// The worker pool and its cache. Destroying it stops the workers; solves in
+// flight are cancelled and never reported.
+class Pool {
+public:
+  // `onPar` runs on a worker thread with each deal's par once it is computed.
+  Pool(SolverClient::Client solver, Options options,
+       std::function<void(int /*grid*/, std::uint64_t /*seed*/, Par)> onPar);
+
+  // Queues the deal unless it is already queued or solved — a solve that found
+  // no par is cached too, so a deal too big to solve is not tried again. Takes
+  // a brief lock, never a solve, so the referee can call it holding its own.
+  void request(int grid, std::uint64_t seed);
+
+  // The deal's par if it has been computed and is still cached.
+  std::optional<Par> lookup(int grid, std::uint64_t seed) const;
+
+  // Deals queued or being solved.
+  std::size_t pending() const;
+
+private:
+  struct State;
+  std::shared_ptr<State> state_;
+  std::vector<std::jthread> workers_; // after state_: joined before it is released
+};
+
+} // namespace ParService
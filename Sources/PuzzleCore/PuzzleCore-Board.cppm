@@ -0,0 +1,141 @@
+export module PuzzleCore:Board;
+
+import std;
+
+// The board as a search wants it. The game's `tiles` (labels "1".."N²-1" and ""
+// for the hole) are convenient for views and the wire, but a solver expanding
+// millions of nodes needs a board that is cheap to copy, compare and slide:
+// `cells[i]` is the tile number at cell i, 0 for the blank, so tile t belongs
+// at cell t - 1 and the blank at the last cell (the layout of `solvedTiles`).
+//
+// Boards carry their Zobrist hash: the XOR of one key per (cell, tile) plus one
+// for the grid, so a slide updates it in O(1) by moving one tile's key, and
+// boards of different sizes never share a hash by construction. The keys are
+// computed (splitmix64 of the pair) rather than looked up in a 512 KB table,
+// and are the same on every platform.
+export namespace PuzzleCore {
+
+struct Board {
+  int grid = 4;
+  std::vector<std::uint8_t> cells; // tile numbers fit a byte up to 16×16
+  int blank = 0;                   // the blank's cell
+  std::uint64_t hash = 0;          // zobristHash(*this), kept current by `slide`
+
+  bool operator==(const Board &) const = default;
+};
+
+inline std::uint64_t splitMix64(std::uint64_t value) {
+  std::uint64_t z = (value + 1) * 0x9E3779B97F4A7C15;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+  return z ^ (z >> 31);
+}
+
+inline std::uint64_t zobristKey(int cell, int tile) {
+  return splitMix64(static_cast<std::uint64_t>(cell) << 8 | static_cast<std::uint64_t>(tile));
+}
+
+// From scratch; O(cells). The blank has no key: the tiles place it.
+inline std::uint64_t zobristHash(const Board &board) {
+  std::uint64_t hash = splitMix64(std::uint64_t{1} << 16 | static_cast<std::uint64_t>(board.grid));
+  for (std::size_t cell = 0; cell < board.cells.size(); ++cell) {
+    if (board.cells[cell] != 0) {
+      hash ^= zobristKey(static_cast<int>(cell), board.cells[cell]);
+    }
+  }
+  return hash;
+}
+
+inline Board solvedBoard(int grid) {
+  Board board{.grid = grid,
+              .cells = std::vector<std::uint8_t>(static_cast<std::size_t>(grid * grid))};
+  for (std::size_t i = 0; i + 1 < board.cells.size(); ++i) {
+    board.cells[i] = static_cast<std::uint8_t>(i + 1);
+  }
+  board.blank = grid * grid - 1;
+  board.hash = zobristHash(board);
+  return board;
+}
+
+// The compact form of a `tiles` board, or nullopt if `tiles` is not a
+// permutation of `solvedTiles(grid)`.
+inline std::optional<Board> boardFromTiles(const std::vector<std::string> &tiles, int grid) {
+  const int count = grid * grid;
+  if (grid < 2 || grid > 16 || static_cast<int>(tiles.size()) != count) {
+    return std::nullopt;
+  }
+  Board board{.grid = grid, .cells = std::vector<std::uint8_t>(tiles.size())};
+  std::vector<bool> seen(tiles.size());
+  for (int i = 0; i < count; ++i) {
+    const std::string &label = tiles[static_cast<std::size_t>(i)];
+    int tile = 0;
+    if (!label.empty()) {
+      const auto [ptr, ec] = std::from_chars(label.data(), label.data() + label.size(), tile);
+      if (ec != std::errc{} || ptr != label.data() + label.size() || tile < 1 || tile >= count) {
+        return std::nullopt;
+      }
+    }
+    if (seen[static_cast<std::size_t>(tile)]) {
+      return std::nullopt;
+    }
+    seen[static_cast<std::size_t>(tile)] = true;
+    board.cells[static_cast<std::size_t>(i)] = static_cast<std::uint8_t>(tile);
+    if (tile == 0) {
+      board.blank = i;
+    }
+  }
+  board.hash = zobristHash(board);
+  return board;
+}
+
+inline bool isSolved(const Board &board) {
+  for (std::size_t i = 0; i + 1 < board.cells.size(); ++i) {
+    if (board.cells[i] != i + 1) {
+      return false;
+    }
+  }
+  return board.cells.back() == 0;
+}
+
+// Whether slides can take `board` to solved. Every slide is a transposition of
+// the blank with a tile and moves the blank one cell, so the parity of the
+// permutation must match the parity of the blank's distance from its home.
+inline bool isSolvable(const Board &board) {
+  const std::size_t count = board.cells.size();
+  std::vector<bool> visited(count);
+  std::size_t transpositions = 0;
+  for (std::size_t start = 0; start < count; ++start) {
+    std::size_t length = 0;
+    for (std::size_t cell = start; !visited[cell]; ++length) {
+      visited[cell] = true;
+      const std::uint8_t tile = board.cells[cell];
+      cell = tile == 0 ? count - 1 : tile - 1u; // the cell this cell's tile belongs in
+    }
+    transpositions += length > 0 ? length - 1 : 0;
+  }
+  const int home = board.grid - 1;
+  const int blankDistance =
+      std::abs(home - board.blank / board.grid) + std::abs(home - board.blank % board.grid);
+  return transpositions % 2 == static_cast<std::size_t>(blankDistance % 2);
+}
+
+// Slides the tile at `cell` into the blank if they are adjacent. Returns
+// whether the board changed.
+inline bool slide(Board &board, int cell) {
+  const int grid = board.grid;
+  const int distance = std::abs(cell - board.blank);
+  const bool adjacent =
+      cell >= 0 && cell < grid * grid &&
+      ((distance == 1 && cell / grid == board.blank / grid) || distance == grid);
+  if (!adjacent) {
+    return false;
+  }
+  const int tile = board.cells[static_cast<std::size_t>(cell)];
+  board.hash ^= zobristKey(cell, tile) ^ zobristKey(board.blank, tile);
+  std::swap(board.cells[static_cast<std::size_t>(cell)],
+            board.cells[static_cast<std::size_t>(board.blank)]);
+  board.blank = cell;
+  return true;
+}
+
+} // namespace PuzzleCore
@@ -0,0 +1,195 @@
+module PuzzleCore; // implementation unit for :Endgame
+
+import std;
+
+namespace PuzzleCore {
+
+namespace {
+
+// Bits set in each 9-bit mask. std::popcount is a library call on baseline
+// x86-64 (no POPCNT), which made generating the 3×3 table twice as slow.
+constexpr auto kBitCount = [] {
+  std::array<std::uint8_t, 512> counts{};
+  for (std::size_t mask = 1; mask < counts.size(); ++mask) {
+    counts[mask] = static_cast<std::uint8_t>(counts[mask >> 1] + (mask & 1));
+  }
+  return counts;
+}();
+
+// The cells next to `cell` in a rows×cols block; returns how many.
+int blockNeighbors(int cell, int rows, int cols, std::array<int, 4> &out) {
+  int count = 0;
+  if (cell >= cols) {
+    out[count++] = cell - cols;
+  }
+  if (cell < (rows - 1) * cols) {
+    out[count++] = cell + cols;
+  }
+  if (cell % cols > 0) {
+    out[count++] = cell - 1;
+  }
+  if (cell % cols < cols - 1) {
+    out[count++] = cell + 1;
+  }
+  return count;
+}
+
+} // namespace
+
+const EndgameTable &EndgameTable::twoByThree() {
+  static const EndgameTable instance(2, 3);
+  return instance;
+}
+
+const EndgameTable &EndgameTable::threeByThree() {
+  static const EndgameTable instance(3, 3);
+  return instance;
+}
+
+EndgameTable::EndgameTable(int rows, int cols)
+    : rows_(rows), cols_(cols), cells_(rows * cols), states_(1) {
+  for (int n = 3; n <= cells_; ++n) {
+    states_ *= static_cast<std::size_t>(n);
+  }
+  Block solved;
+  for (int i = 0; i < cells_; ++i) {
+    solved.cells[static_cast<std::size_t>(i)] = static_cast<std::uint8_t>(i);
+  }
+  solved.blank = cells_ - 1;
+  solvedIndex_ = indexOf(solved);
+
+  // Breadth-first from solved, a layer at a time; moves are reversible, so a
+  // state's depth is its distance to solved. The full distances are only
+  // needed while building.
+  constexpr std::uint8_t kUnseen = std::numeric_limits<std::uint8_t>::max();
+  std::vector<std::uint8_t> distance(states_, kUnseen);
+  std::vector<Block> queue{solved};
+  queue.reserve(states_);
+  distance[solvedIndex_] = 0;
+  std::uint8_t depth = 0;
+  for (std::size_t i = 0, layerEnd = 1; i < queue.size(); ++i) {
+    if (i == layerEnd) {
+      ++depth;
+      layerEnd = queue.size();
+    }
+    const Block block = queue[i];
+    maxDistance_ = depth;
+    std::array<int, 4> moves{};
+    const int count = blockNeighbors(block.blank, rows_, cols_, moves);
+    for (int m = 0; m < count; ++m) {
+      Block next = block;
+      const int cell = moves[static_cast<std::size_t>(m)];
+      std::swap(next.cells[static_cast<std::size_t>(cell)],
+                next.cells[static_cast<std::size_t>(block.blank)]);
+      next.blank = cell;
+      if (std::uint8_t &seen = distance[indexOf(next)]; seen == kUnseen) {
+        seen = static_cast<std::uint8_t>(depth + 1);
+        queue.push_back(next);
+      }
+    }
+  }
+
+  packed_.assign((states_ + 3) / 4, 0);
+  for (std::size_t index = 0; index < states_; ++index) {
+    packed_[index / 4] |= static_cast<std::uint8_t>(distance[index] % 3 << (index % 4 * 2));
+  }
+}
+
+bool EndgameTable::covers(const Board &board) const {
+  const int grid = board.grid;
+  if (grid < rows_ || grid < cols_) {
+    return false;
+  }
+  for (int cell = 0; cell < grid * grid; ++cell) {
+    const bool inBlock = cell / grid >= grid - rows_ && cell % grid >= grid - cols_;
+    if (!inBlock && board.cells[static_cast<std::size_t>(cell)] != cell + 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+EndgameTable::Block EndgameTable::blockOf(const Board &board) const {
+  const int grid = board.grid;
+  const int top = grid - rows_;
+  const int left = grid - cols_;
+  Block block;
+  for (int cell = 0; cell < cells_; ++cell) {
+    const int global = (top + cell / cols_) * grid + left + cell % cols_;
+    const int tile = board.cells[static_cast<std::size_t>(global)];
+    if (tile == 0) {
+      block.blank = cell;
+      block.cells[static_cast<std::size_t>(cell)] = static_cast<std::uint8_t>(cells_ - 1);
+    } else {
+      const int home = tile - 1;
+      block.cells[static_cast<std::size_t>(cell)] =
+          static_cast<std::uint8_t>((home / grid - top) * cols_ + home % grid - left);
+    }
+  }
+  return block;
+}
+
+// The blank's cell, then the tiles in reading order in mixed radix, leaving
+// out the last two: each digit is how many of the tiles not yet seen are
+// smaller, so the digit for the i-th tile is below tiles-i. With the blank
+// fixed, swapping the last two tiles flips solvability, so they add nothing.
+std::size_t EndgameTable::indexOf(const Block &block) const {
+  const int tiles = cells_ - 1;
+  std::size_t index = static_cast<std::size_t>(block.blank);
+  unsigned used = 0;
+  int seen = 0;
+  for (int cell = 0; cell < cells_ && seen + 2 < tiles; ++cell) {
+    const unsigned value = block.cells[static_cast<std::size_t>(cell)];
+    if (cell == block.blank) {
+      continue;
+    }
+    const int smaller = kBitCount[~used & ((1u << value) - 1)];
+    index = index * static_cast<std::size_t>(tiles - seen) + static_cast<std::size_t>(smaller);
+    used |= 1u << value;
+    ++seen;
+  }
+  return index;
+}
+
+int EndgameTable::stepTowardSolved(const Block &block) const {
+  const std::size_t index = indexOf(block);
+  if (index == solvedIndex_) {
+    return -1;
+  }
+  const int closer = (phase(index) + 2) % 3;
+  std::array<int, 4> moves{};
+  const int count = blockNeighbors(block.blank, rows_, cols_, moves);
+  for (int m = 0; m < count; ++m) {
+    Block next = block;
+    const int cell = moves[static_cast<std::size_t>(m)];
+    std::swap(next.cells[static_cast<std::size_t>(cell)],
+              next.cells[static_cast<std::size_t>(block.blank)]);
+    next.blank = cell;
+    if (phase(indexOf(next)) == closer) {
+      return cell;
+    }
+  }
+  return -1; // unreachable for a covered board
+}
+
+int EndgameTable::distance(const Board &board) const {
+  Block block = blockOf(board);
+  int distance = 0;
+  for (int cell = stepTowardSolved(block); cell >= 0; cell = stepTowardSolved(block)) {
+    std::swap(block.cells[static_cast<std::size_t>(cell)],
+              block.cells[static_cast<std::size_t>(block.blank)]);
+    block.blank = cell;
+    ++distance;
+  }
+  return distance;
+}
+
+std::optional<int> EndgameTable::nextMove(const Board &board) const {
+  const int cell = stepTowardSolved(blockOf(board));
+  if (cell < 0) {
+    return std::nullopt;
+  }
+  return (board.grid - rows_ + cell / cols_) * board.grid + board.grid - cols_ + cell % cols_;
+}
+
+} // namespace PuzzleCore
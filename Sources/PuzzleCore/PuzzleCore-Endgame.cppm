@@ -0,0 +1,73 @@
+export module PuzzleCore:Endgame;
+
+import std;
+import :Board;
+
+// Complete distance tables for the last corner of a board. Once every tile
+// outside the bottom-right rows×cols block is home, what is left is a small
+// puzzle of its own, and a breadth-first search from solved over all of its
+// (rows·cols)!/2 solvable states gives every position's distance: 360 states
+// for 2×3, 181,440 for 3×3. A lookup answers the shortest way to finish
+// without disturbing the solved part, and the next move along it, in O(1) —
+// no search. (That is optimal for the corner; with the rest of the board free
+// to move, a shorter solution may leave it.)
+//
+// A state is the block's cells as goal indices, ranked by the blank's cell and
+// the order of all but the last two tiles (solvability fixes those). A state's
+// neighbours are all exactly one closer or one further from solved, so the
+// distance mod 3 is enough to tell the step toward solved from the steps away:
+// two bits a state, 45 KB for 3×3. The distance itself is the length of that
+// walk, at most 31 steps.
+//
+// Each table is generated once, on first use: about 20 ms for 3×3, which the
+// first hint pays on its background thread.
+export namespace PuzzleCore {
+
+class EndgameTable {
+public:
+  // The shared tables (thread-safe; generated on the first call).
+  static const EndgameTable &twoByThree();
+  static const EndgameTable &threeByThree();
+
+  int rows() const { return rows_; }
+  int cols() const { return cols_; }
+  std::size_t stateCount() const { return states_; }
+  int maxDistance() const { return maxDistance_; }
+
+  // Whether every tile outside the bottom-right block is home, so the board
+  // is this table's subproblem.
+  bool covers(const Board &board) const;
+
+  // Slides to solved without leaving the block. The board must be covered.
+  int distance(const Board &board) const;
+
+  // The cell to tap first on such a solution; nullopt once solved.
+  std::optional<int> nextMove(const Board &board) const;
+
+private:
+  EndgameTable(int rows, int cols);
+
+  static constexpr std::size_t kMaxCells = 9;
+  // The block's cells, each holding where its tile belongs within the block
+  // (the blank belongs in the last cell), and the blank's block cell.
+  struct Block {
+    std::array<std::uint8_t, kMaxCells> cells{};
+    int blank = 0;
+  };
+
+  Block blockOf(const Board &board) const;
+  std::size_t indexOf(const Block &block) const;
+  int phase(std::size_t index) const { return packed_[index / 4] >> (index % 4 * 2) & 3; }
+  // The blank's move (a block cell) toward solved; -1 if solved.
+  int stepTowardSolved(const Block &block) const;
+
+  int rows_;
+  int cols_;
+  int cells_;
+  std::size_t states_;
+  std::size_t solvedIndex_ = 0;
+  int maxDistance_ = 0;
+  std::vector<std::uint8_t> packed_; // distance mod 3, four states a byte
+};
+
+} // namespace PuzzleCore
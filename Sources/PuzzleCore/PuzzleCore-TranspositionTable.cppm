@@ -0,0 +1,117 @@
+export module PuzzleCore:TranspositionTable;
+
+import std;
+
+// A fixed-size table of what searches have learned about boards, keyed by
+// `Board::hash` and shared between threads without locks.
+//
+// A bucket is one cache line of four slots. A slot is two atomic words: the
+// packed entry, and the key XOR the entry. Two threads storing into one slot
+// can interleave their words, but a torn slot then fails the key check on read
+// and is simply a miss (Hyatt and Mann's lockless hashing), so neither side
+// ever takes a lock or sees half of someone else's entry. Losing an entry only
+// costs search time: everything stored is a true fact about its board.
+export namespace PuzzleCore {
+
+class TranspositionTable {
+public:
+  struct Entry {
+    std::uint16_t bound = 0; // the moves to solved are at least this
+    std::int16_t next = -1;  // with `exact`: the cell to tap first
+    bool exact = false;      // `bound` is the distance
+    std::uint8_t depth = 0;  // how much search the entry stands for
+
+    bool operator==(const Entry &) const = default;
+  };
+
+  // `bytes` is rounded down to a power-of-two number of buckets (at least one).
+  explicit TranspositionTable(std::size_t bytes)
+      : buckets_(std::bit_floor(std::max(bytes / sizeof(Bucket), std::size_t{1}))),
+        mask_(buckets_.size() - 1) {}
+
+  std::optional<Entry> probe(std::uint64_t key) const {
+    for (const Slot &slot : buckets_[static_cast<std::size_t>(key & mask_)].slots) {
+      const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+      if (data != 0 && (slot.check.load(std::memory_order_relaxed) ^ data) == key) {
+        return unpack(data);
+      }
+    }
+    return std::nullopt;
+  }
+
+  // Overwrites the key's slot if it has one, otherwise the least valuable slot
+  // in its bucket: one from an older generation first, then an inexact one,
+  // then the shallowest.
+  void store(std::uint64_t key, Entry entry) {
+    const std::uint8_t generation = generation_.load(std::memory_order_relaxed);
+    Slot *victim = nullptr;
+    int lowest = std::numeric_limits<int>::max();
+    for (Slot &slot : buckets_[static_cast<std::size_t>(key & mask_)].slots) {
+      const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+      if (data == 0 || (slot.check.load(std::memory_order_relaxed) ^ data) == key) {
+        victim = &slot;
+        break;
+      }
+      const Entry held = unpack(data);
+      const int value = (generationOf(data) == generation ? 512 : 0) + (held.exact ? 256 : 0) +
+                        held.depth;
+      if (value < lowest) {
+        lowest = value;
+        victim = &slot;
+      }
+    }
+    const std::uint64_t data = pack(entry, generation);
+    victim->data.store(data, std::memory_order_relaxed);
+    victim->check.store(key ^ data, std::memory_order_relaxed);
+  }
+
+  // Marks everything stored so far as first in line for replacement. A search
+  // calls this when it starts, so its own entries displace older ones.
+  void age() { generation_.fetch_add(1, std::memory_order_relaxed); }
+
+  // Not safe while other threads use the table.
+  void clear() {
+    for (Bucket &bucket : buckets_) {
+      for (Slot &slot : bucket.slots) {
+        slot.data.store(0, std::memory_order_relaxed);
+        slot.check.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  std::size_t capacity() const { return buckets_.size() * kSlots; }
+
+private:
+  static constexpr std::size_t kSlots = 4;
+  static constexpr std::uint64_t kOccupied = std::uint64_t{1} << 63; // no entry packs to 0
+
+  struct Slot {
+    std::atomic<std::uint64_t> check{0};
+    std::atomic<std::uint64_t> data{0};
+  };
+  struct alignas(64) Bucket {
+    std::array<Slot, kSlots> slots;
+  };
+
+  // bound | next << 16 | exact << 32 | depth << 40 | generation << 48
+  static std::uint64_t pack(Entry entry, std::uint8_t generation) {
+    return kOccupied | entry.bound | std::uint64_t{static_cast<std::uint16_t>(entry.next)} << 16 |
+           std::uint64_t{entry.exact} << 32 | std::uint64_t{entry.depth} << 40 |
+           std::uint64_t{generation} << 48;
+  }
+  static Entry unpack(std::uint64_t data) {
+    return Entry{.bound = static_cast<std::uint16_t>(data),
+                 .next = static_cast<std::int16_t>(static_cast<std::uint16_t>(data >> 16)),
+                 .exact = ((data >> 32) & 1) != 0,
+                 .depth = static_cast<std::uint8_t>(data >> 40)};
+  }
+  static std::uint8_t generationOf(std::uint64_t data) {
+    return static_cast<std::uint8_t>(data >> 48);
+  }
+
+  std::vector<Bucket> buckets_;
+  std::uint64_t mask_;
+  std::atomic<std::uint8_t> generation_{0};
+};
+
+} // namespace PuzzleCore
@@ -0,0 +1,111 @@
+module PuzzleCore; // implementation unit for :WalkingDistance
+
+import std;
+
+namespace PuzzleCore {
+
+namespace {
+
+constexpr int kLines = walkingDistanceGrid;
+constexpr std::uint16_t kNoState = std::numeric_limits<std::uint16_t>::max();
+
+// A row (or column) state unpacked: counts[line][goal] tiles in `line` belong
+// in line `goal`; the blank sits in line `blank`.
+struct Counts {
+  std::array<std::array<int, kLines>, kLines> counts{};
+  int blank = 0;
+
+  std::uint64_t key() const {
+    std::uint64_t key = 0;
+    for (const auto &line : counts) {
+      for (const int count : line) {
+        key = key << 3 | static_cast<std::uint64_t>(count);
+      }
+    }
+    return key << 2 | static_cast<std::uint64_t>(blank);
+  }
+
+  static Counts fromKey(std::uint64_t key) {
+    Counts state;
+    state.blank = static_cast<int>(key & 3);
+    key >>= 2;
+    for (int line = kLines - 1; line >= 0; --line) {
+      for (int goal = kLines - 1; goal >= 0; --goal) {
+        state.counts[line][goal] = static_cast<int>(key & 7);
+        key >>= 3;
+      }
+    }
+    return state;
+  }
+};
+
+Counts solvedCounts() {
+  Counts solved;
+  for (int line = 0; line < kLines; ++line) {
+    solved.counts[line][line] = line == kLines - 1 ? kLines - 1 : kLines;
+  }
+  solved.blank = kLines - 1;
+  return solved;
+}
+
+} // namespace
+
+const WalkingDistance &WalkingDistance::tables() {
+  static const WalkingDistance instance;
+  return instance;
+}
+
+WalkingDistance::WalkingDistance() {
+  // Breadth-first from solved. Moves are reversible, so a state's depth is its
+  // distance to solved. Each state is recorded with its index on discovery;
+  // the transitions are filled in as it is expanded.
+  std::vector<Key> keys{solvedCounts().key()};
+  index_.emplace(keys.front(), 0);
+  distance_.push_back(0);
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    const Counts state = Counts::fromKey(keys[i]);
+    auto &transitions = next_.emplace_back();
+    for (int toward = 0; toward < 2; ++toward) {
+      const int from = state.blank + (toward == 0 ? -1 : 1); // the line the tile comes from
+      for (int goal = 0; goal < kLines; ++goal) {
+        transitions[toward][goal] = kNoState;
+        if (from < 0 || from >= kLines || state.counts[from][goal] == 0) {
+          continue;
+        }
+        Counts moved = state;
+        --moved.counts[from][goal];
+        ++moved.counts[state.blank][goal];
+        moved.blank = from;
+        const auto [it, inserted] =
+            index_.try_emplace(moved.key(), static_cast<std::uint16_t>(keys.size()));
+        if (inserted) {
+          keys.push_back(moved.key());
+          distance_.push_back(static_cast<std::uint8_t>(distance_[i] + 1));
+        }
+        transitions[toward][goal] = it->second;
+      }
+    }
+  }
+}
+
+std::uint16_t WalkingDistance::indexOf(Key key) const { return index_.at(key); }
+
+WalkingDistance::State WalkingDistance::stateOf(const Board &board) const {
+  Counts rows;
+  Counts cols;
+  for (int cell = 0; cell < kLines * kLines; ++cell) {
+    const int tile = board.cells[static_cast<std::size_t>(cell)];
+    const int row = cell / kLines;
+    const int col = cell % kLines;
+    if (tile == 0) {
+      rows.blank = row;
+      cols.blank = col;
+      continue;
+    }
+    ++rows.counts[row][(tile - 1) / kLines];
+    ++cols.counts[col][(tile - 1) % kLines];
+  }
+  return State{.rows = indexOf(rows.key()), .cols = indexOf(cols.key())};
+}
+
+} // namespace PuzzleCore
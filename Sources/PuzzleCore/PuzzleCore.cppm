@@ -2,6 +2,10 @@ export module PuzzleCore;
 
 import std;
 import Dependencies;
+export import :Board;
+export import :Endgame;
+export import :TranspositionTable;
+export import :WalkingDistance;
 
 // The pure sliding-puzzle rules, shared by the client (PuzzleFeature,
 // MultiplayerFeature) and the server (GameServer) — the analog of isowords'
@@ -87,6 +91,26 @@ inline bool slide(std::vector<std::string> &tiles, std::vector<int> &history, in
   return false;
 }
 
+// `taps` (played from a board whose empty cell is `empty`) without the pairs
+// that cancel out — a tile slid and, at once or after other cancelled pairs,
+// slid straight back. The result leaves the board exactly where `taps` do.
+// `scramble` never steps back, but players do, and so can a spliced plan.
+inline std::vector<int> withoutBacktracks(const std::vector<int> &taps, int empty) {
+  std::vector<int> kept;
+  std::vector<int> emptyBefore; // emptyBefore[i]: the empty cell before kept[i]
+  for (const int pos : taps) {
+    if (!emptyBefore.empty() && pos == emptyBefore.back()) {
+      kept.pop_back();
+      emptyBefore.pop_back();
+    } else {
+      kept.push_back(pos);
+      emptyBefore.push_back(empty);
+    }
+    empty = pos;
+  }
+  return kept;
+}
+
 // Uniform-enough index in [0, count) that is identical on every platform
 // (bias from the modulo is irrelevant for shuffling, determinism is not).
 inline std::size_t nextIndex(Dependencies::RandomNumberGenerator &rng, std::size_t count) {
@@ -0,0 +1,78 @@
+module ScoreUploader; // implementation unit
+
+import std;
+import ApiClient;
+import DatabaseClient;
+import ServerRouter;
+import SharedModels;
+
+namespace ScoreUploader {
+
+namespace {
+std::mutex drainMutex;     // one drain at a time (see drainOutbox)
+std::atomic_flag retrying; // set while a drainUntilEmpty is retrying
+} // namespace
+
+Report drainOutbox(const DatabaseClient::Client &database, const ApiClient::Client &api,
+                   std::stop_token stop) {
+  std::scoped_lock lock(drainMutex);
+  Report report;
+  while (!stop.stop_requested()) {
+    auto batch = database.fetchOutbox(static_cast<int>(ServerRouter::maxBatchSize));
+    if (!batch.has_value()) {
+      return report;
+    }
+    if (batch->empty()) {
+      report.drained = true;
+      return report;
+    }
+
+    std::vector<SharedModels::ScoreSubmission> submissions;
+    std::vector<std::int64_t> ids;
+    submissions.reserve(batch->size());
+    ids.reserve(batch->size());
+    for (auto &entry : *batch) {
+      submissions.push_back(std::move(entry.submission));
+      ids.push_back(entry.id);
+    }
+    if (!api.submitScores(std::move(submissions), stop).has_value()) {
+      return report;
+    }
+    // The server has the batch. If the removal fails it is sent again on the
+    // next drain, and the server skips the entries by their client ids.
+    if (!database.removeFromOutbox(ids).has_value()) {
+      return report;
+    }
+    report.uploaded += static_cast<int>(ids.size());
+  }
+  return report;
+}
+
+Report drainUntilEmpty(const DatabaseClient::Client &database, const ApiClient::Client &api,
+                       Backoff backoff, std::stop_token stop) {
+  Report report = drainOutbox(database, api, stop);
+  if (report.drained || retrying.test_and_set()) {
+    return report;
+  }
+  std::mutex mutex;
+  std::condition_variable_any wake; // never notified: only `stop` cuts a wait short
+  auto delay = backoff.first;
+  while (!report.drained) {
+    {
+      std::unique_lock lock(mutex);
+      (void)wake.wait_for(lock, stop, delay, [] { return false; });
+    }
+    if (stop.stop_requested()) {
+      break;
+    }
+    const Report attempt = drainOutbox(database, api, stop);
+    report.uploaded += attempt.uploaded;
+    report.drained = attempt.drained;
+    // Progress means the server is back: the next wait starts short again.
+    delay = attempt.uploaded > 0 ? backoff.first : std::min(delay * 2, backoff.longest);
+  }
+  retrying.clear();
+  return report;
+}
+
+} // namespace ScoreUploader
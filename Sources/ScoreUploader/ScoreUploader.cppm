@@ -0,0 +1,41 @@
+export module ScoreUploader;
+
+import std;
+import ApiClient;
+import DatabaseClient;
+
+// The sending half of the offline outbox. A won game is queued in the local
+// database first (`DatabaseClient::enqueueSubmission`), so losing the network
+// never loses the score; `drainOutbox` then uploads whatever is queued,
+// oldest first, in `POST /scores/batch` requests. Call `drainUntilEmpty` from
+// a background task after queueing and at launch, so a backlog from an offline
+// session catches up as soon as the server is reachable again. Each entry goes
+// up with its own client id, so the server stores a re-sent entry once.
+export namespace ScoreUploader {
+
+struct Report {
+  int uploaded = 0;     // submissions the server acknowledged (now out of the outbox)
+  bool drained = false; // false if a failure or cancellation left some queued
+};
+
+// How long `drainUntilEmpty` waits after a drain that left scores queued:
+// `first`, then twice as long after each further failure, up to `longest`.
+struct Backoff {
+  std::chrono::milliseconds first{2'000};
+  std::chrono::milliseconds longest{5 * 60'000};
+};
+
+// Uploads the outbox in batches of up to `ServerRouter::maxBatchSize`,
+// removing each batch once the server acknowledges it. Stops at the first
+// failure and leaves the rest queued for the next drain. Drains are serialized
+// process-wide, so overlapping calls never send the same entry twice.
+Report drainOutbox(const DatabaseClient::Client &database, const ApiClient::Client &api,
+                   std::stop_token stop);
+
+// Drains, and while that leaves scores queued waits out `backoff` and drains
+// again, until the outbox is empty or `stop` is requested. Only one call
+// retries at a time; while it does, others drain once and leave it to retry.
+Report drainUntilEmpty(const DatabaseClient::Client &database, const ApiClient::Client &api,
+                       Backoff backoff, std::stop_token stop);
+
+} // namespace ScoreUploader
@@ -3,6 +3,7 @@ export module ServerBootstrap;
 import std;
 import DatabaseClient;
 import DatabaseClientLive;
+import Metrics;
 import SiteMiddleware;
 
 // Boots the server environment — the (much smaller) analog of isowords'
@@ -14,6 +15,7 @@ struct EnvVars {
   int httpPort = 8080;                                 // FIFTEEN_SERVER_PORT
   int multiplayerPort = 8091;                          // FIFTEEN_SERVER_MP_PORT
   int maxConnections = 256;                            // FIFTEEN_SERVER_MAX_CONN (<=0 = unbounded)
+  int parThreads = 2;                                  // FIFTEEN_SERVER_PAR_THREADS (at least 1)
   std::string databasePath = "fifteen-server.sqlite3"; // FIFTEEN_SERVER_DATABASE
 };
 
@@ -37,22 +39,63 @@ inline EnvVars readEnvVars() {
   env.httpPort = readInt("FIFTEEN_SERVER_PORT", env.httpPort);
   env.multiplayerPort = readInt("FIFTEEN_SERVER_MP_PORT", env.multiplayerPort);
   env.maxConnections = readInt("FIFTEEN_SERVER_MAX_CONN", env.maxConnections);
+  env.parThreads = std::max(1, readInt("FIFTEEN_SERVER_PAR_THREADS", env.parThreads));
   if (const char *path = std::getenv("FIFTEEN_SERVER_DATABASE"); path && *path) {
     env.databasePath = path;
   }
   return env;
 }
 
+// Decorates `database` so every insert and query is timed into the
+// `fifteen_db_seconds` histogram (by `op`); behavior is otherwise unchanged.
+inline DatabaseClient::Client instrumented(DatabaseClient::Client database) {
+  static const Metrics::Histogram inserts{"fifteen_db_seconds", "Database call latency.",
+                                          {{"op", "insert"}}};
+  static const Metrics::Histogram queries{"fifteen_db_seconds", "Database call latency.",
+                                          {{"op", "query"}}};
+  static const Metrics::Histogram updates{"fifteen_db_seconds", "Database call latency.",
+                                          {{"op", "update"}}};
+  database.saveGame = [inner = std::move(database.saveGame)](SharedModels::ScoreSubmission s) {
+    const Metrics::Timer timer(inserts);
+    return inner(std::move(s));
+  };
+  database.saveGames = [inner = std::move(database.saveGames)](
+                           std::vector<SharedModels::ScoreSubmission> submissions) {
+    const Metrics::Timer timer(inserts);
+    return inner(std::move(submissions));
+  };
+  database.fetchBestScores = [inner = std::move(database.fetchBestScores)](int gridSize) {
+    const Metrics::Timer timer(queries);
+    return inner(gridSize);
+  };
+  database.fetchBestScoresByPar = [inner = std::move(database.fetchBestScoresByPar)](int gridSize) {
+    const Metrics::Timer timer(queries);
+    return inner(gridSize);
+  };
+  database.recordPar = [inner = std::move(database.recordPar)](int grid, std::uint64_t seed,
+                                                                int par) {
+    const Metrics::Timer timer(updates);
+    return inner(grid, seed, par);
+  };
+  database.fetchStats = [inner = std::move(database.fetchStats)] {
+    const Metrics::Timer timer(queries);
+    return inner();
+  };
+  return database;
+}
+
 // Opens (creating if needed) and migrates the database. Nullopt when the
 // database cannot be opened or migrated — the server should refuse to boot
 // rather than serve errors.
 inline std::optional<Environment> bootstrap() {
   const EnvVars envVars = readEnvVars();
-  auto database = DatabaseClient::live(envVars.databasePath);
+  auto database = instrumented(DatabaseClient::live(envVars.databasePath));
   if (!database.migrate().has_value()) {
     return std::nullopt;
   }
-  return Environment{.envVars = envVars, .site = SiteMiddleware::Environment{.database = database}};
+  return Environment{
+      .envVars = envVars,
+      .site = SiteMiddleware::Environment{.database = database, .metrics = Metrics::scrape}};
 }
 
 } // namespace ServerBootstrap
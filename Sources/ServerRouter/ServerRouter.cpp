@@ -39,6 +39,27 @@ std::optional<int> parseInt(std::string_view text) {
   return value;
 }
 
+json submissionJson(const SharedModels::ScoreSubmission &submission) {
+  json doc = {{"name", submission.name},
+              {"gridSize", submission.gridSize},
+              {"moves", submission.moves},
+              {"duration", submission.duration},
+              {"playedAt", submission.playedAt}};
+  if (!submission.clientId.empty()) {
+    doc["clientId"] = submission.clientId;
+  }
+  return doc;
+}
+
+SharedModels::ScoreSubmission submissionFromJson(const json &doc) {
+  return SharedModels::ScoreSubmission{.name = doc.at("name").get<std::string>(),
+                                       .gridSize = doc.at("gridSize").get<int>(),
+                                       .moves = doc.at("moves").get<int>(),
+                                       .duration = doc.at("duration").get<int>(),
+                                       .playedAt = doc.value("playedAt", 0.0),
+                                       .clientId = doc.value("clientId", std::string{})};
+}
+
 } // namespace
 
 std::optional<Route> match(const Request &request) {
@@ -51,6 +72,13 @@ std::optional<Route> match(const Request &request) {
       }
       route.gridSize = *gridSize;
     }
+    if (const auto rank = queryValue(request.query, "rank")) {
+      if (*rank == "par") {
+        route.ranking = Ranking::par;
+      } else if (*rank != "time") {
+        return std::nullopt;
+      }
+    }
     return Route{route};
   }
   if (request.method == "POST" && request.path == "/scores") {
@@ -60,6 +88,19 @@ std::optional<Route> match(const Request &request) {
     }
     return Route{SubmitScore{std::move(*submission)}};
   }
+  if (request.method == "POST" && request.path == "/scores/batch") {
+    auto submissions = decodeScoreSubmissions(request.body);
+    if (!submissions.has_value()) {
+      return std::nullopt;
+    }
+    return Route{SubmitScores{std::move(*submissions)}};
+  }
+  if (request.method == "GET" && request.path == "/metrics") {
+    return Route{FetchMetrics{}};
+  }
+  if (request.method == "GET" && request.path == "/admin/engine") {
+    return Route{FetchEngineState{}};
+  }
   return std::nullopt;
 }
 
@@ -70,15 +111,44 @@ Request print(const Route &route) {
         if constexpr (std::is_same_v<V, FetchLeaderboard>) {
           return Request{.method = "GET",
                          .path = "/leaderboard",
-                         .query = std::format("size={}", value.gridSize)};
+                         .query = value.ranking == Ranking::par
+                                      ? std::format("size={}&rank=par", value.gridSize)
+                                      : std::format("size={}", value.gridSize)};
         } else if constexpr (std::is_same_v<V, SubmitScore>) {
           return Request{
               .method = "POST", .path = "/scores", .body = encodeScoreSubmission(value.submission)};
+        } else if constexpr (std::is_same_v<V, SubmitScores>) {
+          return Request{.method = "POST",
+                         .path = "/scores/batch",
+                         .body = encodeScoreSubmissions(value.submissions)};
+        } else if constexpr (std::is_same_v<V, FetchMetrics>) {
+          return Request{.method = "GET", .path = "/metrics"};
+        } else if constexpr (std::is_same_v<V, FetchEngineState>) {
+          return Request{.method = "GET", .path = "/admin/engine"};
         }
       },
       route);
 }
 
+std::string_view routeName(const Request &request) {
+  if (request.method == "GET" && request.path == "/leaderboard") {
+    return "leaderboard";
+  }
+  if (request.method == "POST" && request.path == "/scores") {
+    return "scores";
+  }
+  if (request.method == "POST" && request.path == "/scores/batch") {
+    return "scores_batch";
+  }
+  if (request.method == "GET" && request.path == "/metrics") {
+    return "metrics";
+  }
+  if (request.method == "GET" && request.path == "/admin/engine") {
+    return "admin";
+  }
+  return "unknown";
+}
+
 std::string encodeLeaderboardEntries(const std::vector<SharedModels::LeaderboardEntry> &entries) {
   json doc = json::array();
   for (const auto &entry : entries) {
@@ -86,7 +156,8 @@ std::string encodeLeaderboardEntries(const std::vector<SharedModels::Leaderboard
                    {"gridSize", entry.gridSize},
                    {"moves", entry.moves},
                    {"duration", entry.duration},
-                   {"playedAt", entry.playedAt}});
+                   {"playedAt", entry.playedAt},
+                   {"par", entry.par}});
   }
   return doc.dump();
 }
@@ -102,7 +173,8 @@ decodeLeaderboardEntries(std::string_view text) {
                                                        .gridSize = item.value("gridSize", 0),
                                                        .moves = item.at("moves").get<int>(),
                                                        .duration = item.at("duration").get<int>(),
-                                                       .playedAt = item.value("playedAt", 0.0)});
+                                                       .playedAt = item.value("playedAt", 0.0),
+                                                       .par = item.value("par", 0)});
     }
     return entries;
   } catch (const json::exception &) {
@@ -111,22 +183,38 @@ decodeLeaderboardEntries(std::string_view text) {
 }
 
 std::string encodeScoreSubmission(const SharedModels::ScoreSubmission &submission) {
-  const json doc = {{"name", submission.name},
-                    {"gridSize", submission.gridSize},
-                    {"moves", submission.moves},
-                    {"duration", submission.duration},
-                    {"playedAt", submission.playedAt}};
-  return doc.dump();
+  return submissionJson(submission).dump();
 }
 
 std::optional<SharedModels::ScoreSubmission> decodeScoreSubmission(std::string_view text) {
+  try {
+    return submissionFromJson(json::parse(text));
+  } catch (const json::exception &) {
+    return std::nullopt;
+  }
+}
+
+std::string encodeScoreSubmissions(const std::vector<SharedModels::ScoreSubmission> &submissions) {
+  json doc = json::array();
+  for (const auto &submission : submissions) {
+    doc.push_back(submissionJson(submission));
+  }
+  return doc.dump();
+}
+
+std::optional<std::vector<SharedModels::ScoreSubmission>>
+decodeScoreSubmissions(std::string_view text) {
   try {
     const json doc = json::parse(text);
-    return SharedModels::ScoreSubmission{.name = doc.at("name").get<std::string>(),
-                                         .gridSize = doc.at("gridSize").get<int>(),
-                                         .moves = doc.at("moves").get<int>(),
-                                         .duration = doc.at("duration").get<int>(),
-                                         .playedAt = doc.value("playedAt", 0.0)};
+    if (!doc.is_array()) {
+      return std::nullopt;
+    }
+    std::vector<SharedModels::ScoreSubmission> submissions;
+    submissions.reserve(doc.size());
+    for (const auto &item : doc) {
+      submissions.push_back(submissionFromJson(item));
+    }
+    return submissions;
   } catch (const json::exception &) {
     return std::nullopt;
   }
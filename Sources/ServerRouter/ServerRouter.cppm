@@ -15,9 +15,16 @@ import SharedModels;
 // of the reachable interface (it would clash with `import std`).
 export namespace ServerRouter {
 
-// GET /leaderboard?size={gridSize} — the top scores for a board size.
+// How a leaderboard orders its scores.
+enum class Ranking : std::uint8_t {
+  time, // fastest first, then fewest moves
+  par,  // fewest moves per par move first (games on server-dealt boards only)
+};
+
+// GET /leaderboard?size={gridSize}[&rank=par] — the top scores for a board size.
 struct FetchLeaderboard {
   int gridSize = 4;
+  Ranking ranking = Ranking::time;
   bool operator==(const FetchLeaderboard &) const = default;
 };
 
@@ -27,7 +34,29 @@ struct SubmitScore {
   bool operator==(const SubmitScore &) const = default;
 };
 
-using Route = std::variant<FetchLeaderboard, SubmitScore>;
+// The most submissions one POST /scores/batch may carry; the uploader sends
+// larger outboxes in several batches.
+inline constexpr std::size_t maxBatchSize = 100;
+
+// POST /scores/batch — submit several completed games at once (the offline
+// outbox catching up).
+struct SubmitScores {
+  std::vector<SharedModels::ScoreSubmission> submissions;
+  bool operator==(const SubmitScores &) const = default;
+};
+
+// GET /metrics — the server's Prometheus metrics (text exposition format).
+struct FetchMetrics {
+  bool operator==(const FetchMetrics &) const = default;
+};
+
+// GET /admin/engine — the multiplayer engine's latest published snapshot.
+struct FetchEngineState {
+  bool operator==(const FetchEngineState &) const = default;
+};
+
+using Route =
+    std::variant<FetchLeaderboard, SubmitScore, SubmitScores, FetchMetrics, FetchEngineState>;
 
 // A transport-neutral HTTP request/response pair. `HttpServer` parses raw
 // HTTP/1.1 into a `Request`; `ApiClientLive` renders a `Request` into a curl
@@ -56,11 +85,19 @@ std::optional<Route> match(const Request &request);
 // Client side: render a route as the request the server will match.
 Request print(const Route &route);
 
+// A short, bounded name for the route `request` is aimed at — "leaderboard",
+// "scores", "scores_batch", "metrics", "admin" or "unknown" — from the method
+// and path alone (no body decoding), for labelling per-route metrics.
+std::string_view routeName(const Request &request);
+
 // Wire codecs (shared shapes for both directions).
 std::string encodeLeaderboardEntries(const std::vector<SharedModels::LeaderboardEntry> &entries);
 std::optional<std::vector<SharedModels::LeaderboardEntry>>
 decodeLeaderboardEntries(std::string_view json);
 std::string encodeScoreSubmission(const SharedModels::ScoreSubmission &submission);
 std::optional<SharedModels::ScoreSubmission> decodeScoreSubmission(std::string_view json);
+std::string encodeScoreSubmissions(const std::vector<SharedModels::ScoreSubmission> &submissions);
+std::optional<std::vector<SharedModels::ScoreSubmission>>
+decodeScoreSubmissions(std::string_view json);
 
 } // namespace ServerRouter
@@ -17,18 +17,26 @@ struct LeaderboardEntry {
   int moves = 0;
   int duration = 0; // seconds
   double playedAt = 0.0;
+  int par = 0; // the deal's shortest known solution; 0 when unknown
 
   bool operator==(const LeaderboardEntry &) const = default;
 };
 
-// A completed game to persist locally and/or submit remotely. Same fields as a
-// leaderboard row — a submission becomes an entry once it is stored.
+// A completed game to persist locally and/or submit remotely. The fields of a
+// leaderboard row plus the deal — a submission becomes an entry once stored.
 struct ScoreSubmission {
   std::string name;
   int gridSize = 0;
   int moves = 0;
   int duration = 0; // seconds
   double playedAt = 0.0;
+  // Names the outbox entry it was uploaded from (the install's id and the
+  // entry's row id), so a batch sent again is stored once; empty otherwise.
+  std::string clientId;
+  // Server-side only, never taken from a client: the scramble seed of a board
+  // the server dealt (0 otherwise) and that deal's par, once known.
+  std::uint64_t seed = 0;
+  int par = 0;
 
   bool operator==(const ScoreSubmission &) const = default;
 };
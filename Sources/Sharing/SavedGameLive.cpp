@@ -5,6 +5,7 @@ module;
 module SavedGameLive; // implementation unit
 
 import std;
+import PuzzleCore;
 import Sharing;
 import SavedGame;
 
@@ -37,49 +38,393 @@ std::optional<Game> decode(std::string_view text) {
   }
 }
 
+// Reads and decodes the JSON snapshot at `path`. A missing or corrupt file
+// reads as "absent".
+std::optional<Game> readSnapshot(const std::filesystem::path &path) {
+  std::error_code ec;
+  if (!std::filesystem::exists(path, ec)) {
+    return std::nullopt;
+  }
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return std::nullopt;
+  }
+  const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  return decode(text);
+}
+
+// Writes the snapshot via temp-file + rename, so a crash mid-write can't leave
+// a torn file. Returns whether the snapshot was replaced.
+bool writeSnapshot(const std::filesystem::path &path, const Game &game) {
+  std::error_code ec;
+  try {
+    if (path.has_parent_path()) {
+      std::filesystem::create_directories(path.parent_path(), ec);
+    }
+    const std::string text = encode(game);
+    const std::filesystem::path tmp = std::filesystem::path(path).concat(".tmp");
+    {
+      std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+      if (!out) {
+        return false;
+      }
+      out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+    std::filesystem::rename(tmp, path, ec);
+    return !ec;
+  } catch (...) {
+    return false;
+  }
+}
+
+// --- journal -------------------------------------------------------------------
+//
+// One text line per save that extended the game:
+//
+//   <snapshot> <base> <secondsElapsed> <pos> <pos> ...\n
+//
+// `snapshot` identifies the snapshot the record was written against (a hash of
+// its JSON, in hex) and `base` is the length of the move history the record
+// continues from, so a record only ever applies on top of exactly the state it
+// was written against. That makes compaction crash-safe: the snapshot is
+// replaced first and the journal truncated second, and if the process dies in
+// between, every surviving record names the old snapshot and is skipped on
+// replay — even when the new snapshot is a new deal, whose history is as long
+// as the last one's. A torn final line (no trailing '\n') is ignored the same
+// way.
+
+// The checksum `mmapStorage` uses, over the snapshot's JSON: stable across
+// builds and platforms, since it ends up on disk.
+std::uint64_t snapshotId(const Game &game) {
+  const std::string text = encode(game);
+  return Sharing::fnv1a(std::as_bytes(std::span(text)));
+}
+
+struct JournalRecord {
+  std::uint64_t snapshot = 0;
+  std::size_t base = 0;
+  int secondsElapsed = 0;
+  std::vector<int> moves;
+};
+
+std::optional<JournalRecord> parseRecord(std::string_view line) {
+  JournalRecord record;
+  const auto next = [&line]() -> std::optional<long long> {
+    while (!line.empty() && line.front() == ' ') {
+      line.remove_prefix(1);
+    }
+    if (line.empty()) {
+      return std::nullopt;
+    }
+    long long value = 0;
+    const auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), value);
+    if (ec != std::errc{}) {
+      return std::nullopt;
+    }
+    line.remove_prefix(static_cast<std::size_t>(ptr - line.data()));
+    return value;
+  };
+  const auto [end, ec] =
+      std::from_chars(line.data(), line.data() + line.size(), record.snapshot, 16);
+  if (ec != std::errc{}) {
+    return std::nullopt;
+  }
+  line.remove_prefix(static_cast<std::size_t>(end - line.data()));
+  const auto base = next();
+  const auto seconds = next();
+  if (!base || !seconds || *base < 0) {
+    return std::nullopt;
+  }
+  record.base = static_cast<std::size_t>(*base);
+  record.secondsElapsed = static_cast<int>(*seconds);
+  while (const auto pos = next()) {
+    record.moves.push_back(static_cast<int>(*pos));
+  }
+  if (!line.empty()) {
+    return std::nullopt; // trailing garbage: not a record we wrote
+  }
+  return record;
+}
+
+std::string formatRecord(std::uint64_t snapshot, std::size_t base, int secondsElapsed,
+                         std::span<const int> moves) {
+  std::string line = std::format("{:016x} {} {}", snapshot, base, secondsElapsed);
+  for (const int pos : moves) {
+    line += std::format(" {}", pos);
+  }
+  line += '\n';
+  return line;
+}
+
+struct Replay {
+  int applied = 0;   // records folded into the game
+  bool clean = true; // false if anything was dropped (torn tail, gap, bad slide)
+};
+
+// Replays every applicable journal record onto `game` (the snapshot) through
+// the shared PuzzleCore move rule, stopping at the first record that does not
+// line up or contains an illegal slide.
+Replay replayJournal(const std::filesystem::path &journal, Game &game) {
+  Replay replay;
+  const std::uint64_t snapshot = snapshotId(game);
+  std::ifstream in(journal, std::ios::binary);
+  if (!in) {
+    return replay;
+  }
+  const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  std::string_view rest = text;
+  while (!rest.empty()) {
+    const std::size_t newline = rest.find('\n');
+    const auto record =
+        newline == std::string_view::npos ? std::nullopt : parseRecord(rest.substr(0, newline));
+    if (!record) {
+      replay.clean = false;
+      break;
+    }
+    rest.remove_prefix(newline + 1);
+    if (record->snapshot != snapshot || record->base < game.moveHistory.size()) {
+      continue; // written against an earlier snapshot, by now replaced
+    }
+    if (record->base > game.moveHistory.size()) {
+      replay.clean = false; // a gap: nothing after this can be trusted
+      break;
+    }
+    Game next = game;
+    const bool legal = std::ranges::all_of(record->moves, [&next](int pos) {
+      return PuzzleCore::slide(next.tiles, next.moveHistory, next.grid, pos);
+    });
+    if (!legal) {
+      replay.clean = false;
+      break;
+    }
+    next.secondsElapsed = record->secondsElapsed;
+    game = std::move(next);
+    ++replay.applied;
+  }
+  return replay;
+}
+
+// What is durably on disk (snapshot + journal), so each save can append only
+// the difference. Saves arrive on background tasks, hence the mutex.
+struct Journal {
+  std::mutex mutex;
+  std::filesystem::path snapshotPath;
+  std::filesystem::path journalPath;
+  int compactEvery = 0;
+  std::optional<Game> persisted;
+  std::uint64_t snapshot = 0; // snapshotId of the snapshot on disk
+  int records = 0;            // journal records since the last snapshot
+
+  void compact(const Game &game) {
+    if (!writeSnapshot(snapshotPath, game)) {
+      persisted = std::nullopt; // unknown on-disk state: next save snapshots again
+      return;
+    }
+    std::error_code ec;
+    std::filesystem::remove(journalPath, ec);
+    persisted = game;
+    snapshot = snapshotId(game);
+    records = 0;
+  }
+
+  // Appends the moves `game` made since `persisted`, if it is a continuation of
+  // it whose replay reproduces `game` exactly. Returns false when the caller
+  // must fall back to a snapshot.
+  bool append(const Game &game) {
+    if (!persisted || persisted->grid != game.grid ||
+        game.moveHistory.size() < persisted->moveHistory.size() ||
+        !std::ranges::equal(std::span(game.moveHistory).first(persisted->moveHistory.size()),
+                            persisted->moveHistory)) {
+      return false;
+    }
+    const auto moves = std::span(game.moveHistory).subspan(persisted->moveHistory.size());
+    Game next = *persisted;
+    for (const int pos : moves) {
+      if (!PuzzleCore::slide(next.tiles, next.moveHistory, next.grid, pos)) {
+        return false;
+      }
+    }
+    if (next.tiles != game.tiles) {
+      return false;
+    }
+    const std::string line =
+        formatRecord(snapshot, persisted->moveHistory.size(), game.secondsElapsed, moves);
+    std::ofstream out(journalPath, std::ios::binary | std::ios::app);
+    if (!out || !out.write(line.data(), static_cast<std::streamsize>(line.size())).flush()) {
+      return false;
+    }
+    next.secondsElapsed = game.secondsElapsed;
+    persisted = std::move(next);
+    ++records;
+    return true;
+  }
+};
+
+// --- mapped layout ---------------------------------------------------------------
+//
+// Tile labels are the numbers 1..grid²-1 ("" = the empty cell, stored as 0) and
+// move positions are < grid², so with grid ≤ 13 both fit a byte.
+
+struct PackedGame {
+  std::uint8_t present = 0;
+  std::uint8_t grid = 0;
+  std::uint16_t historyLength = 0;
+  std::int32_t secondsElapsed = 0;
+  std::array<std::uint8_t, PuzzleCore::maxGrid * PuzzleCore::maxGrid> tiles{};
+  std::array<std::uint8_t, kMappedHistoryCapacity> history{};
+};
+
+// Bump whenever PackedGame's layout changes.
+constexpr std::uint32_t kPackedLayoutVersion = 1;
+
+std::optional<PackedGame> pack(const Game &game) {
+  const auto cells = static_cast<std::size_t>(game.grid) * static_cast<std::size_t>(game.grid);
+  if (game.grid < 2 || game.grid > PuzzleCore::maxGrid || game.tiles.size() != cells ||
+      game.moveHistory.size() > kMappedHistoryCapacity) {
+    return std::nullopt;
+  }
+  PackedGame packed;
+  packed.present = 1;
+  packed.grid = static_cast<std::uint8_t>(game.grid);
+  packed.historyLength = static_cast<std::uint16_t>(game.moveHistory.size());
+  packed.secondsElapsed = game.secondsElapsed;
+  for (std::size_t i = 0; i < cells; ++i) {
+    const std::string &label = game.tiles[i];
+    unsigned value = 0;
+    if (!label.empty()) {
+      const auto [ptr, ec] = std::from_chars(label.data(), label.data() + label.size(), value);
+      if (ec != std::errc{} || ptr != label.data() + label.size() || value == 0 || value >= cells) {
+        return std::nullopt;
+      }
+    }
+    packed.tiles[i] = static_cast<std::uint8_t>(value);
+  }
+  for (std::size_t i = 0; i < game.moveHistory.size(); ++i) {
+    const int pos = game.moveHistory[i];
+    if (pos < 0 || static_cast<std::size_t>(pos) >= cells) {
+      return std::nullopt;
+    }
+    packed.history[i] = static_cast<std::uint8_t>(pos);
+  }
+  return packed;
+}
+
+std::optional<Game> unpack(const PackedGame &packed) {
+  if (packed.present == 0 || packed.grid < 2 || packed.grid > PuzzleCore::maxGrid ||
+      packed.historyLength > kMappedHistoryCapacity) {
+    return std::nullopt;
+  }
+  const auto cells = static_cast<std::size_t>(packed.grid) * packed.grid;
+  Game game;
+  game.grid = packed.grid;
+  game.secondsElapsed = packed.secondsElapsed;
+  game.tiles.reserve(cells);
+  for (std::size_t i = 0; i < cells; ++i) {
+    game.tiles.push_back(packed.tiles[i] == 0 ? std::string{} : std::to_string(packed.tiles[i]));
+  }
+  game.moveHistory.assign(packed.history.begin(), packed.history.begin() + packed.historyLength);
+  return game;
+}
+
 } // namespace
 
 Sharing::PersistenceStrategy<std::optional<Game>> savedGameFileStorage(std::filesystem::path path) {
   return Sharing::PersistenceStrategy<std::optional<Game>>{
       .load = [path]() -> std::optional<std::optional<Game>> {
-        std::error_code ec;
-        if (!std::filesystem::exists(path, ec)) {
-          return std::nullopt;
+        auto game = readSnapshot(path);
+        if (!game) {
+          return std::nullopt; // missing or corrupt → treat as absent
         }
-        std::ifstream in(path, std::ios::binary);
-        if (!in) {
+        return std::optional<Game>(std::move(*game));
+      },
+      .save =
+          [path](const std::optional<Game> &value) {
+            std::error_code ec;
+            if (!value) {
+              std::filesystem::remove(path, ec); // clear-on-win
+              return;
+            }
+            (void)writeSnapshot(path, *value);
+          }};
+}
+
+Sharing::PersistenceStrategy<std::optional<Game>>
+savedGameJournalStorage(std::filesystem::path path, int compactEvery) {
+  auto journal = std::make_shared<Journal>();
+  journal->journalPath = std::filesystem::path(path).concat(".journal");
+  journal->snapshotPath = std::move(path);
+  journal->compactEvery = std::max(1, compactEvery);
+
+  return Sharing::PersistenceStrategy<std::optional<Game>>{
+      .load = [journal]() -> std::optional<std::optional<Game>> {
+        std::scoped_lock lock(journal->mutex);
+        auto game = readSnapshot(journal->snapshotPath);
+        if (!game) {
+          journal->persisted = std::nullopt;
           return std::nullopt;
         }
-        const std::string text((std::istreambuf_iterator<char>(in)),
-                               std::istreambuf_iterator<char>());
-        auto game = decode(text);
+        journal->snapshot = snapshotId(*game);
+        const Replay replay = replayJournal(journal->journalPath, *game);
+        journal->records = replay.applied;
+        // Never append after a dropped record (e.g. onto a torn line): leaving
+        // `persisted` unset makes the next save compact instead.
+        journal->persisted = replay.clean ? std::optional<Game>(*game) : std::nullopt;
+        return std::optional<Game>(std::move(*game));
+      },
+      .save =
+          [journal](const std::optional<Game> &value) {
+            std::scoped_lock lock(journal->mutex);
+            std::error_code ec;
+            if (!value) {
+              // Clear-on-win removes both halves of the saved game.
+              std::filesystem::remove(journal->snapshotPath, ec);
+              std::filesystem::remove(journal->journalPath, ec);
+              journal->persisted = std::nullopt;
+              journal->records = 0;
+              return;
+            }
+            if (journal->persisted == value) {
+              return; // nothing new to persist
+            }
+            if (!journal->append(*value) || journal->records >= journal->compactEvery) {
+              journal->compact(*value);
+            }
+          }};
+}
+
+Sharing::PersistenceStrategy<std::optional<Game>>
+savedGameMappedStorage(std::filesystem::path path) {
+  auto overflow = std::filesystem::path(path).concat(".json");
+  auto storage = Sharing::mmapStorage<PackedGame>(std::move(path), kPackedLayoutVersion);
+  return Sharing::PersistenceStrategy<std::optional<Game>>{
+      .load = [storage, overflow]() -> std::optional<std::optional<Game>> {
+        const auto packed = storage.load();
+        auto game = packed && packed->present != 0 ? unpack(*packed) : readSnapshot(overflow);
         if (!game) {
-          return std::nullopt; // corrupt → treat as absent
+          return std::nullopt;
         }
         return std::optional<Game>(std::move(*game));
       },
       .save =
-          [path](const std::optional<Game> &value) {
+          [storage, overflow](const std::optional<Game> &value) {
             std::error_code ec;
             if (!value) {
-              std::filesystem::remove(path, ec); // clear-on-win
+              // Clear-on-win; the overflow first, so a crash can't leave it
+              // behind an empty slot.
+              std::filesystem::remove(overflow, ec);
+              storage.save(PackedGame{});
+              return;
+            }
+            if (const auto packed = pack(*value)) {
+              storage.save(*packed);
+              std::filesystem::remove(overflow, ec);
               return;
             }
-            try {
-              if (path.has_parent_path()) {
-                std::filesystem::create_directories(path.parent_path(), ec);
-              }
-              const std::string text = encode(*value);
-              const std::filesystem::path tmp = std::filesystem::path(path).concat(".tmp");
-              {
-                std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
-                if (!out) {
-                  return;
-                }
-                out.write(text.data(), static_cast<std::streamsize>(text.size()));
-              }
-              std::filesystem::rename(tmp, path, ec);
-            } catch (...) {
+            // Past the layout (a long solve on a big board): the JSON snapshot
+            // holds the game and the empty slot defers to it. If the snapshot
+            // can't be written, the last good save stays.
+            if (writeSnapshot(overflow, *value)) {
+              storage.save(PackedGame{});
             }
           }};
 }
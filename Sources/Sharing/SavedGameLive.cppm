@@ -12,4 +12,27 @@ export namespace SavedGame {
 
 Sharing::PersistenceStrategy<std::optional<Game>> savedGameFileStorage(std::filesystem::path path);
 
+// Journal mode: the JSON snapshot lives at `path` and every save that merely
+// extends the game appends its new moves (a few bytes) to `path + ".journal"`
+// instead of rewriting the snapshot. Loading replays the journal tail onto the
+// snapshot through `PuzzleCore::slide`, skipping records written against an
+// earlier snapshot and dropping a torn final line. After `compactEvery` records — or
+// whenever a save is not a continuation (a new game or grid) — the
+// snapshot is rewritten and the journal truncated. Saving `std::nullopt`
+// removes both files.
+Sharing::PersistenceStrategy<std::optional<Game>>
+savedGameJournalStorage(std::filesystem::path path, int compactEvery = 256);
+
+// Memory-mapped mode: the game is packed into a fixed binary layout (one byte
+// per tile and per move, up to `kMappedHistoryCapacity` moves) and persisted
+// with `Sharing::mmapStorage`, so loads are a checksum plus a copy and saves
+// update the mapping in place. A game that does not fit the layout (a hand
+// solve past the history capacity on a big board) is written as a JSON
+// snapshot to `path + ".json"` instead, behind an empty slot; if that write
+// fails, the last good save stays. Saving `std::nullopt` removes both.
+inline constexpr std::size_t kMappedHistoryCapacity = 8192;
+
+Sharing::PersistenceStrategy<std::optional<Game>>
+savedGameMappedStorage(std::filesystem::path path);
+
 } // namespace SavedGame
@@ -0,0 +1,160 @@
+module;
+
+// Platform mapping headers live in this implementation unit's global module
+// fragment, so they never reach importers (<windows.h> in particular must not
+// meet `import std` in a reachable interface).
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+module Sharing; // implementation unit for :MappedFile
+
+import std;
+
+namespace Sharing {
+
+namespace {
+
+#if defined(_WIN32)
+HANDLE nativeHandle(std::intptr_t handle) { return reinterpret_cast<HANDLE>(handle); }
+#else
+// msync needs a page-aligned start address.
+std::size_t pageSize() {
+  static const std::size_t size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return size;
+}
+#endif
+
+} // namespace
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+      file_(std::exchange(other.file_, -1)), mapping_(std::exchange(other.mapping_, -1)) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    close();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    file_ = std::exchange(other.file_, -1);
+    mapping_ = std::exchange(other.mapping_, -1);
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() { close(); }
+
+#if defined(_WIN32)
+
+std::optional<MappedFile> MappedFile::open(const std::filesystem::path &path, std::size_t size) {
+  const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return std::nullopt;
+  }
+  // A mapping larger than the file extends it with zeros.
+  const auto wide = static_cast<std::uint64_t>(size);
+  const HANDLE mapping =
+      CreateFileMappingW(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(wide >> 32),
+                         static_cast<DWORD>(wide & 0xffffffffu), nullptr);
+  if (mapping == nullptr) {
+    CloseHandle(file);
+    return std::nullopt;
+  }
+  void *view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  if (view == nullptr) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return std::nullopt;
+  }
+  MappedFile mapped;
+  mapped.data_ = static_cast<std::byte *>(view);
+  mapped.size_ = size;
+  mapped.file_ = reinterpret_cast<std::intptr_t>(file);
+  mapped.mapping_ = reinterpret_cast<std::intptr_t>(mapping);
+  return mapped;
+}
+
+bool MappedFile::flush(std::size_t offset, std::size_t length) const {
+  if (!valid() || offset + length > size_) {
+    return false;
+  }
+  return FlushViewOfFile(data_ + offset, length) != 0 &&
+         FlushFileBuffers(nativeHandle(file_)) != 0;
+}
+
+void MappedFile::close() {
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_ != -1) {
+    CloseHandle(nativeHandle(mapping_));
+  }
+  if (file_ != -1) {
+    CloseHandle(nativeHandle(file_));
+  }
+  data_ = nullptr;
+  size_ = 0;
+  file_ = -1;
+  mapping_ = -1;
+}
+
+#else
+
+std::optional<MappedFile> MappedFile::open(const std::filesystem::path &path, std::size_t size) {
+  const int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+  struct stat info {};
+  // Touching pages past EOF of a shorter file would SIGBUS, so grow it first.
+  if (fstat(fd, &info) != 0 ||
+      (static_cast<std::size_t>(info.st_size) < size &&
+       ftruncate(fd, static_cast<off_t>(size)) != 0)) {
+    ::close(fd);
+    return std::nullopt;
+  }
+  void *view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (view == MAP_FAILED) {
+    ::close(fd);
+    return std::nullopt;
+  }
+  MappedFile mapped;
+  mapped.data_ = static_cast<std::byte *>(view);
+  mapped.size_ = size;
+  mapped.file_ = fd;
+  return mapped;
+}
+
+bool MappedFile::flush(std::size_t offset, std::size_t length) const {
+  if (!valid() || offset + length > size_) {
+    return false;
+  }
+  const std::size_t start = offset / pageSize() * pageSize();
+  return msync(data_ + start, offset + length - start, MS_SYNC) == 0;
+}
+
+void MappedFile::close() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+  if (file_ != -1) {
+    ::close(static_cast<int>(file_));
+  }
+  data_ = nullptr;
+  size_ = 0;
+  file_ = -1;
+  mapping_ = -1;
+}
+
+#endif
+
+} // namespace Sharing
@@ -0,0 +1,190 @@
+export module Sharing:MappedFile;
+
+import std;
+import :Strategy;
+
+// A memory-mapped, fixed-layout persistence strategy. Where `fileStorage`
+// reads the whole file into a string and rewrites it through a temp file on
+// every save, `mmapStorage<T>` maps a small file once and copies a trivially
+// copyable `T` straight in and out of it: a load is a checksum plus a memcpy,
+// a save is an in-place update of a few pages.
+//
+// Crash safety comes from two slots and an atomic header flip. A save writes
+// the INACTIVE slot, flushes it, then bumps the header's `sequence` (whose low
+// bit selects the active slot) and flushes the header. A crash before the flip
+// leaves the previous slot active and intact; a torn slot fails its checksum
+// and the other slot is used instead. The platform mapping calls (POSIX mmap /
+// Win32 file mappings) are confined to the implementation unit.
+export namespace Sharing {
+
+class MappedFile {
+public:
+  MappedFile() = default;
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile();
+
+  // Opens (creating if needed) `path` and maps its first `size` bytes
+  // read/write, growing the file to `size` if it is shorter. New bytes read as
+  // zero. Nullopt if the file cannot be opened or mapped.
+  static std::optional<MappedFile> open(const std::filesystem::path &path, std::size_t size);
+
+  bool valid() const { return data_ != nullptr; }
+
+  std::span<std::byte> bytes() const { return {data_, size_}; }
+
+  // Writes the mapped range [offset, offset + length) back to the file and
+  // waits for it, so a later write can be ordered after it. False on error.
+  bool flush(std::size_t offset, std::size_t length) const;
+
+  void close();
+
+private:
+  std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+  std::intptr_t file_ = -1;
+  std::intptr_t mapping_ = -1; // Win32 mapping object; unused on POSIX
+};
+
+// FNV-1a over a byte range: cheap, and plenty to tell a torn slot from a
+// complete one (this guards against crashes, not adversaries).
+inline std::uint64_t fnv1a(std::span<const std::byte> bytes) {
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const std::byte b : bytes) {
+    hash = (hash ^ static_cast<std::uint64_t>(b)) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// The on-disk header. `layoutVersion` and `valueSize` pin the layout of `T`,
+// so a file written by an incompatible build reads as "absent" (and is
+// reinitialised by the next save) instead of being reinterpreted.
+struct MappedHeader {
+  std::uint32_t magic = 0;
+  std::uint32_t layoutVersion = 0;
+  std::uint64_t valueSize = 0;
+  std::uint64_t sequence = 0; // flipped atomically; low bit = active slot
+  std::uint64_t checksums[2] = {0, 0};
+};
+
+inline constexpr std::uint32_t kMappedMagic = 0x4d463135; // "15FM"
+
+// The two-slot cell behind `mmapStorage`: header, then two slots, each
+// aligned for `T`. The mapping is opened lazily and kept open.
+template <typename T>
+  requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+class MappedSlots {
+public:
+  MappedSlots(std::filesystem::path path, std::uint32_t layoutVersion)
+      : path_(std::move(path)), layoutVersion_(layoutVersion) {}
+
+  std::optional<T> read() {
+    if (!ensureOpen() || !headerMatches()) {
+      return std::nullopt;
+    }
+    const MappedHeader &h = header();
+    const std::uint64_t sequence =
+        std::atomic_ref<std::uint64_t>(header().sequence).load(std::memory_order_acquire);
+    // The active slot first; the other one only if the active slot is torn.
+    for (const std::uint64_t index : {sequence, sequence - 1}) {
+      if (index == 0) {
+        continue; // sequence 0 = initialised but never saved
+      }
+      const auto bytes = slot(index);
+      if (fnv1a(bytes) == h.checksums[index & 1]) {
+        T value;
+        std::memcpy(&value, bytes.data(), sizeof(T));
+        return value;
+      }
+    }
+    return std::nullopt;
+  }
+
+  void write(const T &value) {
+    if (!ensureOpen()) {
+      return;
+    }
+    MappedHeader &h = header();
+    if (!headerMatches()) {
+      h = MappedHeader{.magic = kMappedMagic,
+                       .layoutVersion = layoutVersion_,
+                       .valueSize = sizeof(T),
+                       .sequence = 0,
+                       .checksums = {0, 0}};
+      (void)file_.flush(0, sizeof(MappedHeader));
+    }
+    std::atomic_ref<std::uint64_t> sequence(h.sequence);
+    const std::uint64_t next = sequence.load(std::memory_order_relaxed) + 1;
+    const auto bytes = slot(next);
+    std::memcpy(bytes.data(), &value, sizeof(T));
+    h.checksums[next & 1] = fnv1a(bytes);
+    if (!file_.flush(kSlotOffset + (next & 1) * kSlotStride, sizeof(T))) {
+      return; // the old slot stays active
+    }
+    sequence.store(next, std::memory_order_release);
+    (void)file_.flush(0, sizeof(MappedHeader));
+  }
+
+private:
+  static constexpr std::size_t alignUp(std::size_t n) {
+    return (n + alignof(T) - 1) / alignof(T) * alignof(T);
+  }
+  static constexpr std::size_t kSlotStride = alignUp(sizeof(T));
+  static constexpr std::size_t kSlotOffset = alignUp(sizeof(MappedHeader));
+  static constexpr std::size_t kFileSize = kSlotOffset + 2 * kSlotStride;
+
+  bool ensureOpen() {
+    if (!file_.valid()) {
+      std::error_code ec;
+      if (path_.has_parent_path()) {
+        std::filesystem::create_directories(path_.parent_path(), ec);
+      }
+      if (auto opened = MappedFile::open(path_, kFileSize)) {
+        file_ = std::move(*opened);
+      }
+    }
+    return file_.valid();
+  }
+
+  MappedHeader &header() { return *reinterpret_cast<MappedHeader *>(file_.bytes().data()); }
+
+  bool headerMatches() {
+    const MappedHeader &h = header();
+    return h.magic == kMappedMagic && h.layoutVersion == layoutVersion_ &&
+           h.valueSize == sizeof(T);
+  }
+
+  std::span<std::byte> slot(std::uint64_t index) {
+    return file_.bytes().subspan(kSlotOffset + (index & 1) * kSlotStride, sizeof(T));
+  }
+
+  std::filesystem::path path_;
+  std::uint32_t layoutVersion_ = 1;
+  MappedFile file_;
+};
+
+// A strategy for a trivially copyable `T` backed by `MappedSlots`. Bump
+// `layoutVersion` whenever `T`'s layout changes. Saves are serialised by a
+// mutex (they already arrive on background tasks).
+template <typename T>
+PersistenceStrategy<T> mmapStorage(std::filesystem::path path, std::uint32_t layoutVersion = 1) {
+  struct Cell {
+    Cell(std::filesystem::path path, std::uint32_t version) : slots(std::move(path), version) {}
+    std::mutex mutex;
+    MappedSlots<T> slots;
+  };
+  auto cell = std::make_shared<Cell>(std::move(path), layoutVersion);
+  return PersistenceStrategy<T>{.load = [cell]() -> std::optional<T> {
+                                  std::scoped_lock lock(cell->mutex);
+                                  return cell->slots.read();
+                                },
+                                .save =
+                                    [cell](const T &value) {
+                                      std::scoped_lock lock(cell->mutex);
+                                      cell->slots.write(value);
+                                    }};
+}
+
+} // namespace Sharing
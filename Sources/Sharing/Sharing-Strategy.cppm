@@ -5,7 +5,8 @@ import std;
 // A C++ port of the persistence half of Point-Free's `Sharing` library. A
 // `PersistenceStrategy<T>` is a type-erased pair of closures (load / save) that
 // back a `Shared<T>` value with some store. Concrete strategies: `inMemory`
-// (here, for tests/previews) and `fileStorage` (JSON, in `SharingLive`).
+// (here, for tests/previews), `fileStorage` (JSON, in `SharingLive`) and
+// `mmapStorage` (fixed-layout binary, in :MappedFile).
 export namespace Sharing {
 
 template <typename T> struct PersistenceStrategy {
@@ -5,6 +5,7 @@ import DatabaseClient;
 import PuzzleCore;
 import ServerRouter;
 import SharedModels;
+import Tracing;
 
 // The server's request handler — the C++ port of isowords' `SiteMiddleware`.
 // It is pure "Request in, Response out" against an explicit `Environment`
@@ -19,6 +20,13 @@ export namespace SiteMiddleware {
 
 struct Environment {
   DatabaseClient::Client database;
+  // Renders the server's metrics for GET /metrics (ServerBootstrap wires in
+  // `Metrics::scrape`). Unset, the route answers 404.
+  std::function<std::string()> metrics;
+  // The multiplayer engine's latest published snapshot as JSON, for GET
+  // /admin/engine (the server main wires in GameServer's); nullopt until the
+  // first one is published. Unset, the route answers 404.
+  std::function<std::optional<std::string>()> engineState;
 };
 
 // Server-side re-validation of a submitted score (the scaled-down analog of
@@ -44,11 +52,15 @@ inline std::optional<std::string> validateSubmission(const SharedModels::ScoreSu
   if (s.duration < 0 || s.duration > 24 * 60 * 60) {
     return "duration out of range";
   }
+  if (s.clientId.size() > 64) {
+    return "clientId must be at most 64 characters";
+  }
   return std::nullopt;
 }
 
 inline ServerRouter::Response respond(const Environment &environment,
                                       const ServerRouter::Request &request) {
+  const Tracing::Span span("SiteMiddleware::respond");
   const auto route = ServerRouter::match(request);
   if (!route.has_value()) {
     // Distinguish a known route with a bad body from an unknown route: POST
@@ -56,6 +68,9 @@ inline ServerRouter::Response respond(const Environment &environment,
     if (request.method == "POST" && request.path == "/scores") {
       return ServerRouter::Response{.status = 400, .body = R"({"error":"malformed submission"})"};
     }
+    if (request.method == "POST" && request.path == "/scores/batch") {
+      return ServerRouter::Response{.status = 400, .body = R"({"error":"malformed batch"})"};
+    }
     return ServerRouter::Response{.status = 404, .body = "{}"};
   }
 
@@ -68,7 +83,9 @@ inline ServerRouter::Response respond(const Environment &environment,
             return ServerRouter::Response{.status = 400,
                                           .body = R"({"error":"unsupported board size"})"};
           }
-          auto entries = environment.database.fetchBestScores(value.gridSize);
+          auto entries = value.ranking == ServerRouter::Ranking::par
+                             ? environment.database.fetchBestScoresByPar(value.gridSize)
+                             : environment.database.fetchBestScores(value.gridSize);
           if (!entries.has_value()) {
             return ServerRouter::Response{.status = 500, .body = R"({"error":"database error"})"};
           }
@@ -84,6 +101,50 @@ inline ServerRouter::Response respond(const Environment &environment,
             return ServerRouter::Response{.status = 500, .body = R"({"error":"database error"})"};
           }
           return ServerRouter::Response{.status = 201, .body = "{}"};
+
+        } else if constexpr (std::is_same_v<V, ServerRouter::SubmitScores>) {
+          if (value.submissions.size() > ServerRouter::maxBatchSize) {
+            return ServerRouter::Response{
+                .status = 400,
+                .body = std::format(R"({{"error":"at most {} submissions per batch"}})",
+                                    ServerRouter::maxBatchSize)};
+          }
+          // Invalid entries are dropped, not fatal: the client retries a failed
+          // batch, and one it could never fix must not wedge its outbox.
+          std::vector<SharedModels::ScoreSubmission> accepted;
+          accepted.reserve(value.submissions.size());
+          for (const auto &submission : value.submissions) {
+            if (!validateSubmission(submission).has_value()) {
+              accepted.push_back(submission);
+            }
+          }
+          const std::size_t rejected = value.submissions.size() - accepted.size();
+          const std::size_t count = accepted.size();
+          if (!environment.database.saveGames(std::move(accepted)).has_value()) {
+            return ServerRouter::Response{.status = 500, .body = R"({"error":"database error"})"};
+          }
+          return ServerRouter::Response{
+              .status = 201,
+              .body = std::format(R"({{"accepted":{},"rejected":{}}})", count, rejected)};
+
+        } else if constexpr (std::is_same_v<V, ServerRouter::FetchMetrics>) {
+          if (!environment.metrics) {
+            return ServerRouter::Response{.status = 404, .body = "{}"};
+          }
+          return ServerRouter::Response{.status = 200,
+                                        .contentType = "text/plain; version=0.0.4; charset=utf-8",
+                                        .body = environment.metrics()};
+
+        } else if constexpr (std::is_same_v<V, ServerRouter::FetchEngineState>) {
+          if (!environment.engineState) {
+            return ServerRouter::Response{.status = 404, .body = "{}"};
+          }
+          auto state = environment.engineState();
+          if (!state.has_value()) {
+            return ServerRouter::Response{.status = 503,
+                                          .body = R"({"error":"no snapshot published yet"})"};
+          }
+          return ServerRouter::Response{.status = 200, .body = std::move(*state)};
         }
       },
       *route);
@@ -7,20 +7,85 @@ import Dependencies;
 // slides from the solved state and records that move history, so a solution is
 // simply the inverse of that history — O(moves) and independent of board size,
 // which is why auto-solve scales to arbitrarily large boards with no search.
-// The live planner lives in `SolverClientLive`; tests inject a stub.
+// That plan is as long as the history, though, so `plan` can also keep
+// searching for shorter ones and hand each over as it is found (`PlanMode`).
+// Hints are different: "a good next move" must come from the board itself, so
+// `hint` searches, and so does `search`, which finds a short (or shortest)
+// solution instead of the history's. The live planner lives in
+// `SolverClientLive`; tests inject a stub.
 export namespace SolverClient {
 
 enum class SolveError : std::uint8_t {
   cancelled,
+  invalidBoard, // not a permutation of the solved tiles, or not solvable
+  memoryLimit,  // every search the planner tried outgrew its memory budget
+};
+
+// How hard `plan` works for a shorter solution.
+enum class PlanMode : std::uint8_t {
+  fast,    // the inverted history, at once
+  anytime, // the inverted history at once, then shorter plans until the deadline
+  optimal, // as `anytime`, but without a deadline, ending in a shortest plan when it fits
+};
+
+// Receives each plan `plan` finds, every one shorter than the last.
+using PlanSink = std::function<void(const std::vector<int> &)>;
+
+// What a search cost, for tuning.
+struct SearchStats {
+  std::uint64_t nodes = 0;              // boards expanded
+  std::size_t peakBytes = 0;            // search memory at its largest (approximate)
+  std::chrono::microseconds elapsed{0}; // wall time
+
+  bool operator==(const SearchStats &) const = default;
+};
+
+struct Plan {
+  std::vector<int> moves; // positions to tap, in order, to reach solved
+  bool optimal = false;   // no shorter solution exists
+  SearchStats stats;
+
+  bool operator==(const Plan &) const = default;
+};
+
+struct Hint {
+  std::optional<int> move; // the position to tap; nullopt when already solved
+  int distance = 0;        // moves to solved: exact when `optimal`, else a lower bound
+  bool optimal = false;    // `move` starts a shortest solution
+  std::uint64_t nodes = 0; // boards the search expanded for this request
+
+  bool operator==(const Hint &) const = default;
 };
 
 struct Client {
   // history: tile positions tapped (from solved) that produced the board.
-  // gridSize: board side length. Returns the positions to tap to reach solved.
-  std::function<std::expected<std::vector<int>, SolveError>(std::vector<int>, int, std::stop_token)>
-      plan = [](std::vector<int>, int, std::stop_token) {
+  // gridSize: board side length. deadline: how long `anytime` keeps improving.
+  // Passes every plan it finds to `improved` (if set) as soon as it has it, and
+  // returns the last — the positions to tap to reach solved.
+  std::function<std::expected<std::vector<int>, SolveError>(
+      std::vector<int>, int, PlanMode, std::chrono::milliseconds, PlanSink, std::stop_token)>
+      plan = [](std::vector<int>, int, PlanMode, std::chrono::milliseconds, PlanSink,
+                std::stop_token) {
         return std::expected<std::vector<int>, SolveError>{std::in_place};
       };
+
+  // tiles, gridSize: the board as the game holds it. Returns the best first
+  // move the search can vouch for within `budget`: the start of an optimal
+  // solution if it finds one in time, otherwise the most promising move.
+  std::function<std::expected<Hint, SolveError>(std::vector<std::string>, int,
+                                                std::chrono::milliseconds, std::stop_token)>
+      hint = [](std::vector<std::string>, int, std::chrono::milliseconds, std::stop_token) {
+        return std::expected<Hint, SolveError>{std::in_place};
+      };
+
+  // tiles, gridSize: the board as the game holds it. memoryLimit: bytes the
+  // search may hold at once. Searches for a shortest solution, settling for a
+  // near-optimal one if that does not fit; meant for 5×5 and 6×6.
+  std::function<std::expected<Plan, SolveError>(std::vector<std::string>, int, std::size_t,
+                                                std::stop_token)>
+      search = [](std::vector<std::string>, int, std::size_t, std::stop_token) {
+        return std::expected<Plan, SolveError>{std::in_place};
+      };
 };
 
 struct Key : Dependencies::DependencyKey<Key, Client> {
@@ -0,0 +1,1065 @@
+module SolverClientLive; // implementation unit
+
+import std;
+import PuzzleCore;
+import SolverClient;
+
+namespace SolverClient {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Entry = PuzzleCore::TranspositionTable::Entry;
+
+constexpr std::size_t kHintTableBytes = std::size_t{16} << 20; // 1M entries
+constexpr std::size_t kPlanSearchBytes = std::size_t{64} << 20;
+constexpr std::size_t kSolutionCacheMoves = std::size_t{1} << 16;
+constexpr std::uint64_t kClockInterval = 1024;                 // nodes between deadline checks
+constexpr int kFound = -1;
+constexpr int kInterrupted = -2;
+
+// What hint searches have proved about boards. Bounds are facts about a board,
+// not about a game, so entries never go stale and every hint on the client
+// shares the table, concurrently if need be. Allocated on the first hint.
+struct HintTable {
+  std::once_flag allocated;
+  std::unique_ptr<PuzzleCore::TranspositionTable> table;
+
+  PuzzleCore::TranspositionTable &get() {
+    std::call_once(allocated, [this] {
+      table = std::make_unique<PuzzleCore::TranspositionTable>(kHintTableBytes);
+    });
+    return *table;
+  }
+};
+
+// Solutions the client has found, least recently used dropped first, so asking
+// again — or from any board along one, as a player following a plan does — is
+// answered without a search. A path is kept as its start board and two bits a
+// move (the side of the blank the tile comes from). Every board on it short of
+// solved is indexed by hash with its offset, proved-shortest paths apart from
+// the rest; a board on several paths keeps the one with the fewest moves left.
+// A hit is replayed from its path's start and compared, so a collision misses.
+class SolutionCache {
+public:
+  struct Solution {
+    std::vector<int> moves;
+    bool optimal = false;
+  };
+
+  // The rest of a cached path from `board`: a proved one in optimal mode, the
+  // shortest known otherwise.
+  std::optional<Solution> find(const PuzzleCore::Board &board, PlanMode mode) {
+    std::scoped_lock lock(mutex_);
+    for (const bool optimal : {true, false}) {
+      if (!optimal && mode == PlanMode::optimal) {
+        break;
+      }
+      const auto &index = index_[optimal ? 1 : 0];
+      const auto it = index.find(board.hash);
+      if (it == index.end()) {
+        continue;
+      }
+      const auto [path, offset] = it->second;
+      PuzzleCore::Board at = path->start;
+      for (std::size_t i = 0; i < offset; ++i) {
+        PuzzleCore::slide(at, cellFrom(at, path->direction(i)));
+      }
+      if (at != board) {
+        continue;
+      }
+      Solution solution{.optimal = optimal};
+      solution.moves.reserve(path->length - offset);
+      for (std::size_t i = offset; i < path->length; ++i) {
+        solution.moves.push_back(cellFrom(at, path->direction(i)));
+        PuzzleCore::slide(at, solution.moves.back());
+      }
+      paths_.splice(paths_.begin(), paths_, path);
+      return solution;
+    }
+    return std::nullopt;
+  }
+
+  // Caches `moves` from `start` unless they do not solve it or every board on
+  // them already has a path at least as short.
+  void insert(PuzzleCore::Board start, const std::vector<int> &moves, bool optimal) {
+    if (moves.empty() || moves.size() > kSolutionCacheMoves) {
+      return;
+    }
+    Path path{.start = start,
+              .packed = std::vector<std::uint8_t>((moves.size() + 3) / 4),
+              .length = moves.size(),
+              .optimal = optimal};
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+      const int direction = directionOf(start, moves[i]);
+      if (direction < 0 || !PuzzleCore::slide(start, moves[i])) {
+        return;
+      }
+      path.packed[i / 4] |= static_cast<std::uint8_t>(direction << (i % 4 * 2));
+    }
+    if (!PuzzleCore::isSolved(start)) {
+      return;
+    }
+
+    std::scoped_lock lock(mutex_);
+    paths_.push_front(std::move(path));
+    const auto added = paths_.begin();
+    auto &index = index_[optimal ? 1 : 0];
+    std::size_t indexed = 0;
+    forEachBoard(*added, [&](const PuzzleCore::Board &board, std::size_t offset) {
+      const auto [it, inserted] = index.try_emplace(board.hash, Position{added, offset});
+      if (inserted || it->second.path->length - it->second.offset > added->length - offset) {
+        it->second = Position{added, offset};
+        ++indexed;
+      }
+    });
+    if (indexed == 0) {
+      paths_.erase(added);
+      return;
+    }
+    moves_ += added->length;
+    while (moves_ > kSolutionCacheMoves) {
+      evict(std::prev(paths_.end()));
+    }
+  }
+
+private:
+  struct Path {
+    PuzzleCore::Board start;
+    std::vector<std::uint8_t> packed; // four moves a byte
+    std::size_t length = 0;
+    bool optimal = false;
+
+    unsigned direction(std::size_t i) const { return packed[i / 4] >> (i % 4 * 2) & 3u; }
+  };
+  using PathList = std::list<Path>; // most recently used first
+
+  struct Position {
+    PathList::iterator path;
+    std::size_t offset = 0; // moves from the path's start
+  };
+
+  // Directions are the blank's neighbours: above, below, left, right.
+  static int cellFrom(const PuzzleCore::Board &board, unsigned direction) {
+    const std::array offsets{-board.grid, board.grid, -1, 1};
+    return board.blank + offsets[direction];
+  }
+  static int directionOf(const PuzzleCore::Board &board, int cell) {
+    for (unsigned direction = 0; direction < 4; ++direction) {
+      if (cellFrom(board, direction) == cell) {
+        return static_cast<int>(direction);
+      }
+    }
+    return -1;
+  }
+
+  // Calls `visit(board, offset)` for every board on `path` before solved.
+  static void forEachBoard(const Path &path, const auto &visit) {
+    PuzzleCore::Board board = path.start;
+    for (std::size_t i = 0; i < path.length; ++i) {
+      visit(board, i);
+      PuzzleCore::slide(board, cellFrom(board, path.direction(i)));
+    }
+  }
+
+  // Unindexes the boards that still point at `path`, then drops it.
+  void evict(PathList::iterator path) {
+    auto &index = index_[path->optimal ? 1 : 0];
+    forEachBoard(*path, [&](const PuzzleCore::Board &board, std::size_t) {
+      if (const auto it = index.find(board.hash); it != index.end() && it->second.path == path) {
+        index.erase(it);
+      }
+    });
+    moves_ -= path->length;
+    paths_.erase(path);
+  }
+
+  std::mutex mutex_; // guards everything below
+  PathList paths_;
+  std::array<std::unordered_map<std::uint64_t, Position>, 2> index_; // [optimal] by hash
+  std::size_t moves_ = 0;                                            // summed path lengths
+};
+
+// What a client keeps between requests, shared by its copies.
+struct ClientState {
+  HintTable hints;
+  SolutionCache solutions;
+};
+
+// The cells whose tile can slide into the blank; returns how many.
+int movableCells(const PuzzleCore::Board &board, std::array<int, 4> &cells) {
+  const int grid = board.grid;
+  const int blank = board.blank;
+  int count = 0;
+  if (blank >= grid) {
+    cells[count++] = blank - grid;
+  }
+  if (blank < grid * (grid - 1)) {
+    cells[count++] = blank + grid;
+  }
+  if (blank % grid > 0) {
+    cells[count++] = blank - 1;
+  }
+  if (blank % grid < grid - 1) {
+    cells[count++] = blank + 1;
+  }
+  return count;
+}
+
+// The admissible estimate the search runs on, updated in O(1) per slide:
+// walking distance where PuzzleCore has tables for it, Manhattan otherwise.
+class Estimate {
+public:
+  explicit Estimate(const PuzzleCore::Board &board) {
+    if (board.grid == PuzzleCore::walkingDistanceGrid) {
+      walkingDistance_ = &PuzzleCore::WalkingDistance::tables();
+      state_ = walkingDistance_->stateOf(board);
+      return;
+    }
+    for (int cell = 0; cell < static_cast<int>(board.cells.size()); ++cell) {
+      if (const int tile = board.cells[static_cast<std::size_t>(cell)]; tile != 0) {
+        manhattan_ += distance(cell, tile - 1, board.grid);
+      }
+    }
+  }
+
+  int value() const {
+    return walkingDistance_ != nullptr ? walkingDistance_->distance(state_) : manhattan_;
+  }
+
+  // Call before the tile at `cell` slides into the blank of `board`.
+  void slide(const PuzzleCore::Board &board, int cell) {
+    if (walkingDistance_ != nullptr) {
+      state_ = walkingDistance_->afterSlide(state_, board, cell);
+      return;
+    }
+    const int home = board.cells[static_cast<std::size_t>(cell)] - 1;
+    manhattan_ += distance(board.blank, home, board.grid) - distance(cell, home, board.grid);
+  }
+
+private:
+  static int distance(int from, int to, int grid) {
+    return std::abs(from / grid - to / grid) + std::abs(from % grid - to % grid);
+  }
+
+  const PuzzleCore::WalkingDistance *walkingDistance_ = nullptr;
+  PuzzleCore::WalkingDistance::State state_;
+  int manhattan_ = 0;
+};
+
+// One hint request: IDA* from the board, reading and extending the table.
+class HintSearch {
+public:
+  HintSearch(PuzzleCore::TranspositionTable &table, Clock::time_point deadline,
+             std::stop_token stop)
+      : table_(table), deadline_(deadline), stop_(std::move(stop)) {}
+
+  std::expected<Hint, SolveError> run(PuzzleCore::Board board);
+
+private:
+  bool interrupted() {
+    cancelled_ = cancelled_ || stop_.stop_requested();
+    return cancelled_ || Clock::now() >= deadline_;
+  }
+
+  int search(PuzzleCore::Board &board, Estimate estimate, int g, int threshold, int previous,
+             int parentBound);
+
+  // Raises the board's lower bound. `work` (the threshold's distance past the
+  // board) ranks it for replacement: deeper bounds saved more search.
+  void learn(std::uint64_t key, int bound, int work) {
+    const auto held = table_.probe(key);
+    if (held && (held->exact || held->bound >= bound)) {
+      return;
+    }
+    table_.store(key, Entry{.bound = static_cast<std::uint16_t>(bound),
+                            .depth = static_cast<std::uint8_t>(std::clamp(work, 0, 255))});
+  }
+
+  // Records a board on a proved-optimal solution.
+  void prove(std::uint64_t key, int distance, int next) {
+    table_.store(key, Entry{.bound = static_cast<std::uint16_t>(distance),
+                            .next = static_cast<std::int16_t>(next),
+                            .exact = true,
+                            .depth = static_cast<std::uint8_t>(std::min(distance, 255))});
+  }
+
+  PuzzleCore::TranspositionTable &table_;
+  Clock::time_point deadline_;
+  std::stop_token stop_;
+  bool cancelled_ = false;
+  std::uint64_t nodes_ = 0;
+};
+
+// Returns kFound if a solution of length `threshold` runs through `board`
+// (reached in `g` moves), kInterrupted, or else the smallest f = g + h past the
+// threshold. `previous` is the cell the blank just left — sliding it back is
+// never useful — and `parentBound` the parent's lower bound. Skipping the move
+// back is why a learned bound is capped at `parentBound + 1`: the best route
+// from this board may well be through its parent.
+int HintSearch::search(PuzzleCore::Board &board, Estimate estimate, int g, int threshold,
+                       int previous, int parentBound) {
+  if (++nodes_ % kClockInterval == 0 && interrupted()) {
+    return kInterrupted;
+  }
+  const std::uint64_t key = board.hash;
+  int bound = estimate.value();
+  if (const auto held = table_.probe(key)) {
+    if (held->exact && g + held->bound <= threshold) {
+      return kFound;
+    }
+    bound = std::max<int>(bound, held->bound);
+  }
+  if (g + bound > threshold) {
+    return g + bound;
+  }
+  if (bound == 0) {
+    return kFound; // both estimates are zero only when solved
+  }
+
+  std::array<int, 4> cells{};
+  const int count = movableCells(board, cells);
+  int minimum = std::numeric_limits<int>::max();
+  for (int i = 0; i < count; ++i) {
+    const int cell = cells[static_cast<std::size_t>(i)];
+    if (cell == previous) {
+      continue;
+    }
+    Estimate child = estimate;
+    child.slide(board, cell);
+    const int blank = board.blank;
+    PuzzleCore::slide(board, cell);
+    const int result = search(board, child, g + 1, threshold, blank, bound);
+    PuzzleCore::slide(board, blank);
+    if (result == kFound) {
+      prove(key, threshold - g, cell);
+      return kFound;
+    }
+    if (result == kInterrupted) {
+      return kInterrupted;
+    }
+    minimum = std::min(minimum, result);
+  }
+  learn(key, std::min(minimum - g, parentBound + 1), threshold - g);
+  return minimum;
+}
+
+std::expected<Hint, SolveError> HintSearch::run(PuzzleCore::Board board) {
+  if (PuzzleCore::isSolved(board)) {
+    return Hint{};
+  }
+  table_.age();
+  const std::uint64_t key = board.hash;
+  const Estimate estimate(board);
+  int bound = estimate.value();
+  if (const auto held = table_.probe(key)) {
+    if (held->exact) {
+      return Hint{.move = held->next, .distance = held->bound, .optimal = true};
+    }
+    bound = std::max<int>(bound, held->bound);
+  }
+
+  // Until an iteration completes, the best guess is the child that looks
+  // closest. Each completed iteration re-ranks the children by what it proved,
+  // and searches the favourite first next time.
+  struct Child {
+    int cell;
+    Estimate estimate;
+    int f;
+    int proved = -1; // the child's distance, if the table has it
+  };
+  std::array<int, 4> cells{};
+  const int count = movableCells(board, cells);
+  std::vector<Child> children;
+  for (int i = 0; i < count; ++i) {
+    Child child{.cell = cells[static_cast<std::size_t>(i)], .estimate = estimate, .f = 0};
+    child.estimate.slide(board, child.cell);
+    child.f = 1 + child.estimate.value();
+
+    // Neighbours' distances differ by one, so a board the last hint proved
+    // something about (typically the one before the player's last move)
+    // bounds this one too.
+    const int blank = board.blank;
+    PuzzleCore::slide(board, child.cell);
+    if (const auto held = table_.probe(board.hash)) {
+      bound = std::max(bound, held->bound - 1);
+      child.proved = held->exact ? held->bound : -1;
+    }
+    PuzzleCore::slide(board, blank);
+    children.push_back(child);
+  }
+  std::ranges::stable_sort(children, {}, &Child::f);
+
+  // Every slide moves the blank one cell, so the distance has the parity of
+  // the blank's distance from home.
+  const int home = board.grid - 1;
+  const int blankDistance =
+      std::abs(home - board.blank / board.grid) + std::abs(home - board.blank % board.grid);
+  bound += (bound ^ blankDistance) & 1;
+  for (const Child &child : children) {
+    if (child.proved >= 0 && child.proved + 1 == bound) {
+      prove(key, bound, child.cell);
+      return Hint{.move = child.cell, .distance = bound, .optimal = true};
+    }
+  }
+
+  // Near the end of a game only the bottom-right corner is still scrambled,
+  // and the endgame table finishes it without a search. That is an upper
+  // bound; when it meets the lower bound (or the corner is the whole board)
+  // it is optimal. Otherwise its move is a better fallback than the
+  // closest-looking child.
+  std::optional<int> cornerMove;
+  if (const auto &corner = PuzzleCore::EndgameTable::threeByThree(); corner.covers(board)) {
+    cornerMove = corner.nextMove(board);
+    const int distance = corner.distance(board);
+    if (distance == bound || board.grid == corner.rows()) {
+      prove(key, distance, *cornerMove);
+      return Hint{.move = cornerMove, .distance = distance, .optimal = true};
+    }
+  }
+
+  for (int threshold = bound; !interrupted(); threshold = bound) {
+    int minimum = std::numeric_limits<int>::max();
+    for (Child &child : children) {
+      const int blank = board.blank;
+      PuzzleCore::slide(board, child.cell);
+      const int result = search(board, child.estimate, 1, threshold, blank, bound);
+      PuzzleCore::slide(board, blank);
+      if (result == kFound) {
+        prove(key, threshold, child.cell);
+        return Hint{.move = child.cell, .distance = threshold, .optimal = true, .nodes = nodes_};
+      }
+      if (result == kInterrupted) {
+        break;
+      }
+      child.f = result;
+      minimum = std::min(minimum, result);
+    }
+    if (cancelled_) {
+      return std::unexpected(SolveError::cancelled);
+    }
+    if (minimum == std::numeric_limits<int>::max() || interrupted()) {
+      break; // out of time mid-iteration: keep the last completed ranking
+    }
+    std::ranges::stable_sort(children, {}, &Child::f);
+    bound = minimum;
+    learn(key, bound, bound);
+  }
+  if (cancelled_) {
+    return std::unexpected(SolveError::cancelled);
+  }
+  return Hint{.move = cornerMove.value_or(children.front().cell),
+              .distance = bound,
+              .optimal = false,
+              .nodes = nodes_};
+}
+
+// Manhattan distance plus linear conflicts toward any target board (solved for
+// a forward search, the start for a backward one). In each row, the tiles that
+// belong in that row but sit out of order cost two extra moves for every tile
+// that has to step aside — the row's length minus its longest in-order run —
+// and likewise for columns. A slide changes the total by at most one, so it is
+// consistent and A* never reopens a board. A slide only touches two rows (or
+// two columns), so children are evaluated from their parent.
+class TargetEstimate {
+public:
+  explicit TargetEstimate(const PuzzleCore::Board &target)
+      : grid_(target.grid), home_(target.cells.size()) {
+    for (std::size_t cell = 0; cell < target.cells.size(); ++cell) {
+      home_[target.cells[cell]] = static_cast<std::uint8_t>(cell);
+    }
+  }
+
+  int operator()(const PuzzleCore::Board &board) const {
+    int manhattan = 0;
+    int stepAside = 0;
+    for (int cell = 0; cell < grid_ * grid_; ++cell) {
+      if (const int tile = board.cells[static_cast<std::size_t>(cell)]; tile != 0) {
+        manhattan += distance(cell, home_[static_cast<std::size_t>(tile)]);
+      }
+    }
+    for (int line = 0; line < grid_; ++line) {
+      stepAside += rowStepAside(board, line) + colStepAside(board, line);
+    }
+    return manhattan + 2 * stepAside;
+  }
+
+  // The estimate after the tile at `cell` slides into the blank, given the
+  // estimate `h` before; `board` is the position before the slide.
+  int afterSlide(int h, PuzzleCore::Board &board, int cell) const {
+    const int blank = board.blank;
+    const int home = home_[board.cells[static_cast<std::size_t>(cell)]];
+    const int before = linesThrough(board, cell, blank);
+    PuzzleCore::slide(board, cell);
+    const int after = linesThrough(board, cell, blank);
+    PuzzleCore::slide(board, blank);
+    return h + distance(blank, home) - distance(cell, home) + 2 * (after - before);
+  }
+
+private:
+  int distance(int from, int to) const {
+    return std::abs(from / grid_ - to / grid_) + std::abs(from % grid_ - to % grid_);
+  }
+
+  // The step-asides in the two rows (vertical slide) or columns (horizontal)
+  // that a slide between `cell` and `blank` changes.
+  int linesThrough(const PuzzleCore::Board &board, int cell, int blank) const {
+    if (cell % grid_ == blank % grid_) {
+      return rowStepAside(board, cell / grid_) + rowStepAside(board, blank / grid_);
+    }
+    return colStepAside(board, cell % grid_) + colStepAside(board, blank % grid_);
+  }
+
+  int rowStepAside(const PuzzleCore::Board &board, int row) const {
+    std::array<int, PuzzleCore::maxGrid> line; // home columns, in order
+    int length = 0;
+    for (int col = 0; col < grid_; ++col) {
+      const int tile = board.cells[static_cast<std::size_t>(row * grid_ + col)];
+      const int home = home_[static_cast<std::size_t>(tile)];
+      if (tile != 0 && home / grid_ == row) {
+        line[static_cast<std::size_t>(length++)] = home % grid_;
+      }
+    }
+    return length - longestIncreasing(line, length);
+  }
+
+  int colStepAside(const PuzzleCore::Board &board, int col) const {
+    std::array<int, PuzzleCore::maxGrid> line; // home rows, in order
+    int length = 0;
+    for (int row = 0; row < grid_; ++row) {
+      const int tile = board.cells[static_cast<std::size_t>(row * grid_ + col)];
+      const int home = home_[static_cast<std::size_t>(tile)];
+      if (tile != 0 && home % grid_ == col) {
+        line[static_cast<std::size_t>(length++)] = home / grid_;
+      }
+    }
+    return length - longestIncreasing(line, length);
+  }
+
+  static int longestIncreasing(const std::array<int, PuzzleCore::maxGrid> &line, int length) {
+    std::array<int, PuzzleCore::maxGrid> ending; // the longest run ending at i
+    int longest = 0;
+    for (int i = 0; i < length; ++i) {
+      int run = 1;
+      for (int j = 0; j < i; ++j) {
+        if (line[static_cast<std::size_t>(j)] < line[static_cast<std::size_t>(i)]) {
+          run = std::max(run, ending[static_cast<std::size_t>(j)] + 1);
+        }
+      }
+      ending[static_cast<std::size_t>(i)] = run;
+      longest = std::max(longest, run);
+    }
+    return longest;
+  }
+
+  int grid_;
+  std::vector<std::uint8_t> home_; // home_[tile]: its cell in the target
+};
+
+// One direction of a best-first search: every board it has reached, an open
+// list ordered by g + weight·h (deeper first on ties), and an open-addressing
+// index from Zobrist hash to node. Boards are stored packed, one byte per cell,
+// next to their node. Storage for as many nodes as `memoryLimit` allows is
+// reserved up front — address space only, until used — so growing never
+// doubles a vector past the limit. A bidirectional search gives each of its
+// two frontiers half of its limit, so together they reserve no more than it.
+class Frontier {
+public:
+  static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+  Frontier(const PuzzleCore::Board &root, const PuzzleCore::Board &target, int weight,
+           std::size_t memoryLimit)
+      : scratch_(root), estimate_(target), weight_(weight), slots_(1'024, kNone) {
+    const std::size_t nodeBytes =
+        sizeof(Node) + root.cells.size() + 2 * sizeof(Item) + 4 * sizeof(std::uint32_t);
+    const std::size_t capacity = std::min<std::size_t>(memoryLimit / nodeBytes, kNone);
+    nodes_.reserve(capacity);
+    cells_.reserve(capacity * root.cells.size());
+    open_.reserve(capacity);
+    remember(root, 0, estimate_(root), kNone);
+  }
+
+  // The best open node, dropping entries made stale by a shorter path; kNone
+  // once nothing is open.
+  std::uint32_t peek() {
+    while (!open_.empty()) {
+      const Item top = open_.front();
+      const Node &node = nodes_[top.node];
+      if (!node.closed && top.g == node.g) {
+        return top.node;
+      }
+      std::ranges::pop_heap(open_, worse);
+      open_.pop_back();
+    }
+    return kNone;
+  }
+
+  int priority(std::uint32_t index) const {
+    return nodes_[index].g + weight_ * nodes_[index].h;
+  }
+  int g(std::uint32_t index) const { return nodes_[index].g; }
+  int h(std::uint32_t index) const { return nodes_[index].h; }
+  std::size_t openSize() const { return open_.size(); }
+
+  // The node holding `board`, or kNone if this side has not reached it.
+  std::uint32_t find(const PuzzleCore::Board &board) const {
+    const std::size_t mask = slots_.size() - 1;
+    for (std::size_t slot = board.hash & mask;; slot = (slot + 1) & mask) {
+      const std::uint32_t index = slots_[slot];
+      if (index == kNone ||
+          (nodes_[index].hash == board.hash && std::ranges::equal(cellsOf(index), board.cells))) {
+        return index;
+      }
+    }
+  }
+
+  // Closes `index` (which peek() just returned) and generates its children,
+  // calling `reached(board, child)` for each board that is new or now has a
+  // shorter path.
+  template <class Reached> void expand(std::uint32_t index, Reached &&reached) {
+    std::ranges::pop_heap(open_, worse);
+    open_.pop_back();
+    nodes_[index].closed = true;
+    const Node node = nodes_[index];
+    PuzzleCore::Board &board = scratch_;
+    std::ranges::copy(cellsOf(index), board.cells.begin());
+    board.blank = node.blank;
+    board.hash = node.hash;
+    const int back = node.parent == kNone ? -1 : nodes_[node.parent].blank;
+
+    std::array<int, 4> cells{};
+    const int count = movableCells(board, cells);
+    for (int i = 0; i < count; ++i) {
+      const int cell = cells[static_cast<std::size_t>(i)];
+      if (cell == back) {
+        continue;
+      }
+      const int h = estimate_.afterSlide(node.h, board, cell);
+      const int blank = board.blank;
+      PuzzleCore::slide(board, cell);
+      const int g = node.g + 1;
+      if (const std::uint32_t seen = find(board); seen == kNone) {
+        reached(std::as_const(board), remember(board, g, h, index));
+      } else if (Node &child = nodes_[seen]; !child.closed && g < child.g) {
+        child.g = static_cast<std::uint16_t>(g);
+        child.parent = index;
+        push(seen);
+        reached(std::as_const(board), seen);
+      }
+      PuzzleCore::slide(board, blank);
+    }
+  }
+
+  // The taps that lead from the root to `index`.
+  std::vector<int> pathTo(std::uint32_t index) const {
+    std::vector<int> taps;
+    for (; nodes_[index].parent != kNone; index = nodes_[index].parent) {
+      taps.push_back(nodes_[index].blank);
+    }
+    std::ranges::reverse(taps);
+    return taps;
+  }
+
+  // The taps that lead from `index` back to the root.
+  std::vector<int> pathFrom(std::uint32_t index) const {
+    std::vector<int> taps;
+    for (; nodes_[index].parent != kNone; index = nodes_[index].parent) {
+      taps.push_back(nodes_[nodes_[index].parent].blank);
+    }
+    return taps;
+  }
+
+  // The memory in use (reserved but untouched storage is not).
+  std::size_t bytes() const {
+    return nodes_.size() * sizeof(Node) + cells_.size() + open_.size() * sizeof(Item) +
+           slots_.size() * sizeof(std::uint32_t);
+  }
+
+private:
+  struct Node {
+    std::uint64_t hash = 0;
+    std::uint32_t parent = kNone;
+    std::uint16_t g = 0;
+    std::uint16_t h = 0;
+    std::uint8_t blank = 0;
+    bool closed = false;
+  };
+  struct Item {
+    std::uint16_t priority;
+    std::uint16_t g;
+    std::uint32_t node;
+  };
+  // Heap order: the top is the lowest priority, then the deepest.
+  static bool worse(const Item &lhs, const Item &rhs) {
+    return lhs.priority != rhs.priority ? lhs.priority > rhs.priority : lhs.g < rhs.g;
+  }
+
+  std::span<const std::uint8_t> cellsOf(std::uint32_t index) const {
+    return std::span(cells_).subspan(index * scratch_.cells.size(), scratch_.cells.size());
+  }
+
+  std::uint32_t remember(const PuzzleCore::Board &board, int g, int h, std::uint32_t parent) {
+    const auto index = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back(Node{.hash = board.hash,
+                          .parent = parent,
+                          .g = static_cast<std::uint16_t>(g),
+                          .h = static_cast<std::uint16_t>(h),
+                          .blank = static_cast<std::uint8_t>(board.blank)});
+    cells_.insert(cells_.end(), board.cells.begin(), board.cells.end());
+    if (nodes_.size() * 2 > slots_.size()) {
+      slots_.assign(slots_.size() * 2, kNone);
+      for (std::uint32_t i = 0; i < index; ++i) {
+        insert(i);
+      }
+    }
+    insert(index);
+    push(index);
+    return index;
+  }
+
+  // Linear probing; the table is kept at most half full.
+  void insert(std::uint32_t index) {
+    std::size_t slot = nodes_[index].hash & (slots_.size() - 1);
+    while (slots_[slot] != kNone) {
+      slot = (slot + 1) & (slots_.size() - 1);
+    }
+    slots_[slot] = index;
+  }
+
+  void push(std::uint32_t index) {
+    open_.push_back(Item{.priority = static_cast<std::uint16_t>(priority(index)),
+                         .g = nodes_[index].g,
+                         .node = index});
+    std::ranges::push_heap(open_, worse);
+  }
+
+  PuzzleCore::Board scratch_; // the board being expanded
+  TargetEstimate estimate_;
+  int weight_;
+  std::vector<Node> nodes_;
+  std::vector<std::uint8_t> cells_;
+  std::vector<Item> open_;
+  std::vector<std::uint32_t> slots_; // node indices; kNone marks an empty slot
+};
+
+// The planner behind `search`: bidirectional A* first, then weighted A* with
+// growing weights, each within the memory limit and each starting from empty.
+class BestFirst {
+public:
+  // `exhausted` (every board reached, the goal not among them) is unreachable
+  // for a solvable board short of a 64-bit hash collision on its path.
+  enum class Outcome : std::uint8_t { solved, outOfMemory, outOfTime, cancelled, exhausted };
+
+  BestFirst(PuzzleCore::Board start, std::size_t memoryLimit, Clock::time_point deadline,
+            std::stop_token stop)
+      : start_(std::move(start)), goal_(PuzzleCore::solvedBoard(start_.grid)),
+        memoryLimit_(memoryLimit), deadline_(deadline), stop_(std::move(stop)) {}
+
+  // The whole strategy behind `search`: optimal if it fits, weighted if not.
+  std::expected<Plan, SolveError> run();
+
+  // One search: bidirectional (and optimal) at weight 1, weighted above it.
+  Outcome solve(int weight, std::vector<int> &moves) {
+    return weight == 1 ? bidirectional(moves) : weighted(weight, moves);
+  }
+
+private:
+  Outcome bidirectional(std::vector<int> &moves);
+  Outcome weighted(int weight, std::vector<int> &moves);
+
+  // Checked once per expansion; the clock and the token only every
+  // kClockInterval nodes.
+  std::optional<Outcome> overBudget(std::size_t bytes) {
+    stats_.peakBytes = std::max(stats_.peakBytes, bytes);
+    if (bytes > memoryLimit_) {
+      return Outcome::outOfMemory;
+    }
+    if (stats_.nodes % kClockInterval == 0) {
+      if (stop_.stop_requested()) {
+        return Outcome::cancelled;
+      }
+      if (Clock::now() >= deadline_) {
+        return Outcome::outOfTime;
+      }
+    }
+    return std::nullopt;
+  }
+
+  PuzzleCore::Board start_;
+  PuzzleCore::Board goal_;
+  std::size_t memoryLimit_;
+  Clock::time_point deadline_;
+  std::stop_token stop_;
+  SearchStats stats_;
+};
+
+// Pohl's bidirectional A*: expand the side with the smaller open list; every
+// board one side reaches that the other already holds closes a path. The best
+// path is optimal once no open board on either side could beat it — its length
+// is at most the larger of the two sides' smallest f.
+BestFirst::Outcome BestFirst::bidirectional(std::vector<int> &moves) {
+  Frontier forward(start_, goal_, 1, memoryLimit_ / 2);
+  Frontier backward(goal_, start_, 1, memoryLimit_ / 2);
+  int best = std::numeric_limits<int>::max();
+  std::uint32_t meetForward = Frontier::kNone;
+  std::uint32_t meetBackward = Frontier::kNone;
+  for (;;) {
+    const std::uint32_t nextForward = forward.peek();
+    const std::uint32_t nextBackward = backward.peek();
+    if (nextForward == Frontier::kNone || nextBackward == Frontier::kNone ||
+        best <= std::max(forward.priority(nextForward), backward.priority(nextBackward))) {
+      break;
+    }
+    if (const auto over = overBudget(forward.bytes() + backward.bytes())) {
+      return *over;
+    }
+    ++stats_.nodes;
+    const bool fromStart = forward.openSize() <= backward.openSize();
+    Frontier &side = fromStart ? forward : backward;
+    Frontier &other = fromStart ? backward : forward;
+    side.expand(fromStart ? nextForward : nextBackward,
+                [&](const PuzzleCore::Board &board, std::uint32_t child) {
+                  const std::uint32_t met = other.find(board);
+                  if (met != Frontier::kNone && side.g(child) + other.g(met) < best) {
+                    best = side.g(child) + other.g(met);
+                    meetForward = fromStart ? child : met;
+                    meetBackward = fromStart ? met : child;
+                  }
+                });
+  }
+  if (meetForward == Frontier::kNone) {
+    return Outcome::exhausted;
+  }
+  moves = forward.pathTo(meetForward);
+  std::ranges::copy(backward.pathFrom(meetBackward), std::back_inserter(moves));
+  return Outcome::solved;
+}
+
+// Weighted A*: f = g + weight·h reaches the goal after far fewer expansions,
+// and the path is at most `weight` times the shortest.
+BestFirst::Outcome BestFirst::weighted(int weight, std::vector<int> &moves) {
+  Frontier forward(start_, goal_, weight, memoryLimit_);
+  for (;;) {
+    const std::uint32_t next = forward.peek();
+    if (next == Frontier::kNone) {
+      return Outcome::exhausted;
+    }
+    if (forward.h(next) == 0) {
+      moves = forward.pathTo(next);
+      return Outcome::solved;
+    }
+    if (const auto over = overBudget(forward.bytes())) {
+      return *over;
+    }
+    ++stats_.nodes;
+    forward.expand(next, [](const PuzzleCore::Board &, std::uint32_t) {});
+  }
+}
+
+std::expected<Plan, SolveError> BestFirst::run() {
+  const Clock::time_point started = Clock::now();
+  Plan plan;
+  auto finish = [&](Outcome outcome) -> std::expected<Plan, SolveError> {
+    plan.stats = stats_;
+    plan.stats.elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - started);
+    if (outcome == Outcome::cancelled || outcome == Outcome::outOfTime) {
+      return std::unexpected(SolveError::cancelled);
+    }
+    if (outcome == Outcome::outOfMemory) {
+      return std::unexpected(SolveError::memoryLimit);
+    }
+    if (outcome == Outcome::exhausted) {
+      return std::unexpected(SolveError::invalidBoard);
+    }
+    return plan;
+  };
+  if (PuzzleCore::isSolved(start_)) {
+    plan.optimal = true;
+    return finish(Outcome::solved);
+  }
+
+  Outcome outcome = bidirectional(plan.moves);
+  plan.optimal = outcome == Outcome::solved;
+  for (const int weight : {2, 4, 8}) {
+    if (outcome != Outcome::outOfMemory) {
+      break;
+    }
+    outcome = weighted(weight, plan.moves);
+  }
+  return finish(outcome);
+}
+
+// Every slide undone in reverse, then the blank slid home: O(history) and
+// valid on any board size.
+std::expected<std::vector<int>, SolveError>
+invertedHistory(const std::vector<int> &history, int gridSize, const std::stop_token &stop) {
+  std::vector<int> solution;
+  if (history.empty()) {
+    return solution; // already solved
+  }
+  solution.reserve(history.size());
+  for (int i = static_cast<int>(history.size()) - 2; i >= 0; --i) {
+    if ((i & 0xFFFF) == 0 && stop.stop_requested()) {
+      return std::unexpected(SolveError::cancelled);
+    }
+    solution.push_back(history[i]);
+  }
+  solution.push_back(gridSize * gridSize - 1); // slide the blank back to the corner
+  return solution;
+}
+
+// A shortest plan on a walking-distance board, by following optimal hints:
+// after the first, each one is answered from the table. nullopt if the first
+// is not proved by the deadline.
+std::optional<std::vector<int>> followHints(PuzzleCore::TranspositionTable &table,
+                                            PuzzleCore::Board board, Clock::time_point deadline,
+                                            const std::stop_token &stop) {
+  std::vector<int> moves;
+  for (;;) {
+    const auto hint = HintSearch(table, deadline, stop).run(board);
+    if (!hint) {
+      return std::nullopt;
+    }
+    if (!hint->move) {
+      return moves;
+    }
+    if (!hint->optimal) {
+      return std::nullopt;
+    }
+    moves.push_back(*hint->move);
+    PuzzleCore::slide(board, *hint->move);
+  }
+}
+
+// `plan` in the anytime modes. The inverted history, with its back-and-forth
+// slides cancelled, is available at once; weighted A* at falling weights then
+// trades time for shorter plans, and the last stage is exact: the hint chain on
+// 4×4, bidirectional A* elsewhere. A stage that runs out of time or memory
+// ends the search — later stages need more of both. A cached path from the
+// board is offered before the search, and a proved one ends it.
+std::expected<std::vector<int>, SolveError>
+improvePlan(HintTable &hints, SolutionCache &solutions, const std::vector<int> &history,
+            int gridSize, PlanMode mode, Clock::time_point deadline, const PlanSink &improved,
+            const std::stop_token &stop) {
+  auto inverted = invertedHistory(history, gridSize, stop);
+  if (!inverted) {
+    return inverted;
+  }
+  std::vector<int> best;
+  bool found = false;
+  const auto offer = [&](std::vector<int> moves) {
+    if (!found || moves.size() < best.size()) {
+      best = std::move(moves);
+      found = true;
+      if (improved) {
+        improved(best);
+      }
+    }
+  };
+  const int blank = history.empty() ? gridSize * gridSize - 1 : history.back();
+  offer(PuzzleCore::withoutBacktracks(*inverted, blank));
+
+  PuzzleCore::Board board = PuzzleCore::solvedBoard(gridSize);
+  for (const int cell : history) {
+    PuzzleCore::slide(board, cell);
+  }
+  if (PuzzleCore::isSolved(board)) {
+    offer({}); // the history walked in a loop
+  }
+  if (best.empty() || gridSize > PuzzleCore::maxGrid) {
+    return best;
+  }
+  std::size_t cached = std::numeric_limits<std::size_t>::max();
+  if (auto hit = solutions.find(board, mode)) {
+    cached = hit->moves.size();
+    offer(std::move(hit->moves));
+    if (hit->optimal) {
+      return best;
+    }
+  }
+
+  BestFirst search(board, kPlanSearchBytes, deadline, stop);
+  bool searching = true;
+  for (const int weight : {8, 4, 2}) {
+    std::vector<int> moves;
+    searching = search.solve(weight, moves) == BestFirst::Outcome::solved;
+    if (!searching) {
+      break;
+    }
+    offer(std::move(moves));
+  }
+  bool proved = false;
+  if (searching && gridSize == PuzzleCore::walkingDistanceGrid) {
+    if (auto moves = followHints(hints.get(), board, deadline, stop)) {
+      offer(std::move(*moves));
+      proved = true;
+    }
+  } else if (searching) {
+    if (std::vector<int> moves; search.solve(1, moves) == BestFirst::Outcome::solved) {
+      offer(std::move(moves));
+      proved = true;
+    }
+  }
+  if (stop.stop_requested()) {
+    return std::unexpected(SolveError::cancelled);
+  }
+  if (proved || best.size() < cached) {
+    solutions.insert(std::move(board), best, proved);
+  }
+  return best;
+}
+
+} // namespace
+
+Client live() {
+  auto state = std::make_shared<ClientState>();
+  return Client{
+      .plan = [state](std::vector<int> history, int gridSize, PlanMode mode,
+                      std::chrono::milliseconds deadline, PlanSink improved,
+                      std::stop_token stop) -> std::expected<std::vector<int>, SolveError> {
+        if (mode == PlanMode::fast) {
+          auto solution = invertedHistory(history, gridSize, stop);
+          if (solution && improved) {
+            improved(*solution);
+          }
+          return solution;
+        }
+        const Clock::time_point until =
+            mode == PlanMode::optimal ? Clock::time_point::max() : Clock::now() + deadline;
+        return improvePlan(state->hints, state->solutions, history, gridSize, mode, until,
+                           improved, stop);
+      },
+      .hint = [state](std::vector<std::string> tiles, int gridSize,
+                      std::chrono::milliseconds budget,
+                      std::stop_token stop) -> std::expected<Hint, SolveError> {
+        const Clock::time_point deadline = Clock::now() + budget;
+        const auto board = PuzzleCore::boardFromTiles(tiles, gridSize);
+        if (!board || !PuzzleCore::isSolvable(*board)) {
+          return std::unexpected(SolveError::invalidBoard);
+        }
+        if (const auto hit = state->solutions.find(*board, PlanMode::optimal)) {
+          return Hint{.move = hit->moves.front(),
+                      .distance = static_cast<int>(hit->moves.size()),
+                      .optimal = true};
+        }
+        return HintSearch(state->hints.get(), deadline, std::move(stop)).run(*board);
+      },
+      .search = [state](std::vector<std::string> tiles, int gridSize, std::size_t memoryLimit,
+                        std::stop_token stop) -> std::expected<Plan, SolveError> {
+        auto board = PuzzleCore::boardFromTiles(tiles, gridSize);
+        if (!board || gridSize > PuzzleCore::maxGrid || !PuzzleCore::isSolvable(*board)) {
+          return std::unexpected(SolveError::invalidBoard);
+        }
+        if (auto hit = state->solutions.find(*board, PlanMode::optimal)) {
+          return Plan{.moves = std::move(hit->moves), .optimal = true};
+        }
+        auto plan = BestFirst(*board, memoryLimit, Clock::time_point::max(), std::move(stop)).run();
+        if (plan) {
+          state->solutions.insert(std::move(*board), plan->moves, plan->optimal);
+        }
+        return plan;
+      }};
+}
+
+} // namespace SolverClient
@@ -8,31 +8,32 @@ import SolverClient;
 // every slide in reverse, finishing by sliding the blank home. This is O(k) and
 // has nothing to do with board size, so it scales to any N×N instantly. Honors
 // the stop token (a pathological history could be huge).
+//
+// The anytime modes hand that plan over with its back-and-forth slides removed,
+// then look for shorter ones: weighted A* at weights 8, 4 and 2, and finally an
+// exact search (the hint chain on 4×4, bidirectional A* elsewhere), each stage
+// within the deadline and a fixed memory budget.
+//
+// Hints run IDA* from the board (walking distance on 4×4, Manhattan distance
+// elsewhere) under the caller's time budget. What each search learns — raised
+// lower bounds, and the optimal next move along a proved solution — goes into a
+// transposition table owned by the client (`PuzzleCore::TranspositionTable`, so
+// hints may run concurrently), and the next hint on the same game — usually one
+// slide further along that solution — is answered from the table. Once only
+// the bottom-right 3×3 corner is left, `PuzzleCore::EndgameTable` answers
+// without a search when it can show its move is optimal.
+//
+// `search` runs bidirectional A* until its frontiers outgrow the memory limit,
+// then weighted A* (w = 2, 4, 8), which trades optimality for far fewer nodes.
+//
+// The solutions `plan` and `search` find are kept in an LRU cache owned by the
+// client, packed two bits a move and indexed by the hash of every board along
+// them, proved-shortest apart from the rest. A request from any of those boards
+// gets the rest of the path: `search`, `hint` and the optimal mode only from a
+// proved one, which answers them without a search; the anytime mode from either,
+// as the plan to beat.
 export namespace SolverClient {
 
 Client live();
 
 } // namespace SolverClient
-
-namespace SolverClient {
-
-Client live() {
-  return Client{.plan = [](std::vector<int> history, int gridSize,
-                           std::stop_token stop) -> std::expected<std::vector<int>, SolveError> {
-    std::vector<int> solution;
-    if (history.empty()) {
-      return solution; // already solved
-    }
-    solution.reserve(history.size());
-    for (int i = static_cast<int>(history.size()) - 2; i >= 0; --i) {
-      if ((i & 0xFFFF) == 0 && stop.stop_requested()) {
-        return std::unexpected(SolveError::cancelled);
-      }
-      solution.push_back(history[i]);
-    }
-    solution.push_back(gridSize * gridSize - 1); // slide the blank back to the corner
-    return solution;
-  }};
-}
-
-} // namespace SolverClient
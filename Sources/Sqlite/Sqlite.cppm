@@ -9,6 +9,7 @@ module;
 export module Sqlite;
 
 import std;
+import Tracing;
 
 // A thin C++ wrapper over the SQLite C API, mirroring isowords' `Sqlite` type.
 // `Database::run` prepares a statement, binds the supplied values, steps
@@ -67,6 +68,7 @@ public:
   // Prepares `sql`, binds `bindings` positionally (1-based), and returns all
   // result rows.
   std::vector<Row> run(const std::string &sql, std::vector<Datatype> bindings = {}) {
+    const Tracing::Span span("Sqlite::Database::run");
     sqlite3_stmt *stmt = nullptr;
     if (sqlite3_prepare_v2(handle_, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
       throw Error{sqlite3_errcode(handle_), sqlite3_errmsg(handle_)};
@@ -248,8 +248,10 @@ std::optional<Listener> Listener::bind(int port) {
   address.sin_family = AF_INET;
   address.sin_addr.s_addr = INADDR_ANY;
   address.sin_port = htons(static_cast<std::uint16_t>(port));
+  // A full backlog lets a burst of connects (a lobby rush, the load generator)
+  // queue in the kernel instead of stalling on SYN retries.
   if (::bind(s, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 ||
-      ::listen(s, 16) != 0) {
+      ::listen(s, SOMAXCONN) != 0) {
     closeNative(s);
     return std::nullopt;
   }
@@ -273,6 +275,11 @@ std::optional<Connection> Listener::accept() {
 
 void Listener::close() {
   if (valid()) {
+#if !defined(_WIN32)
+    // Linux doesn't wake a thread blocked in accept() when the socket is
+    // closed under it; shutting it down first does.
+    ::shutdown(native(handle_), SHUT_RDWR);
+#endif
     closeNative(native(handle_));
     handle_ = kInvalid;
   }
@@ -0,0 +1,119 @@
+module;
+
+// The signal API is C; it lives in this implementation unit's global module
+// fragment so the macros (SIGUSR1) never reach importers.
+#include <signal.h>
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+module Tracing; // implementation unit
+
+import std;
+
+namespace Tracing {
+
+namespace {
+
+// Exited threads whose spans are still dumped; older ones are dropped.
+constexpr std::size_t kRetiredRings = 64;
+
+struct Registry {
+  std::mutex mutex; // guards everything below; taken once per thread, and by dumps
+  std::vector<std::shared_ptr<Ring>> live;
+  std::deque<std::shared_ptr<Ring>> retired;
+  int nextThread = 1;
+};
+
+// Leaked on purpose, like Metrics: threads may exit during static destruction.
+Registry &registry() {
+  static Registry *instance = new Registry;
+  return *instance;
+}
+
+void appendEvents(std::string &out, const Ring &ring) {
+  const std::uint64_t written = ring.written.load(std::memory_order_acquire);
+  const std::uint64_t count = std::min<std::uint64_t>(written, kRingCapacity);
+  for (std::uint64_t n = written - count; n < written; ++n) {
+    const Event &event = ring.events[n % kRingCapacity];
+    const char *name = event.name.load(std::memory_order_relaxed);
+    if (name == nullptr) {
+      continue;
+    }
+    out += std::format(R"({}{{"name":"{}","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                       out.back() == '[' ? "" : ",\n", name, ring.thread,
+                       static_cast<double>(event.start.load(std::memory_order_relaxed)) / 1e3,
+                       static_cast<double>(event.duration.load(std::memory_order_relaxed)) / 1e3);
+  }
+}
+
+// Set by the signal handler, consumed by the dump thread. Lock-free, so
+// touching it is async-signal-safe.
+std::atomic<bool> dumpRequested{false};
+static_assert(std::atomic<bool>::is_always_lock_free);
+
+void requestDump(int) { dumpRequested.store(true, std::memory_order_relaxed); }
+
+} // namespace
+
+LocalRing::LocalRing() : ring(std::make_shared<Ring>()) {
+  Registry &r = registry();
+  std::scoped_lock lock(r.mutex);
+  ring->thread = r.nextThread++;
+  r.live.push_back(ring);
+}
+
+LocalRing::~LocalRing() {
+  Registry &r = registry();
+  std::scoped_lock lock(r.mutex);
+  std::erase(r.live, ring);
+  r.retired.push_back(std::move(ring));
+  if (r.retired.size() > kRetiredRings) {
+    r.retired.pop_front();
+  }
+}
+
+std::string chromeTrace() {
+  std::string out = R"({"traceEvents":[)";
+  {
+    Registry &r = registry();
+    std::scoped_lock lock(r.mutex);
+    for (const auto &ring : r.retired) {
+      appendEvents(out, *ring);
+    }
+    for (const auto &ring : r.live) {
+      appendEvents(out, *ring);
+    }
+  }
+  out += "]}\n";
+  return out;
+}
+
+std::jthread dumpOnSignal(std::filesystem::path directory) {
+#if defined(SIGUSR1)
+  if constexpr (kEnabled) {
+    ::signal(SIGUSR1, &requestDump);
+    return std::jthread([directory = std::move(directory)](std::stop_token stop) {
+      int dumps = 0;
+      while (!stop.stop_requested()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (!dumpRequested.exchange(false, std::memory_order_relaxed)) {
+          continue;
+        }
+        const auto path = directory / std::format("fifteen-trace-{}-{}.json", ::getpid(), ++dumps);
+        std::ofstream file(path);
+        file << chromeTrace();
+        if (file) {
+          std::println("🔎 trace written to {}", path.string());
+        } else {
+          std::println(std::cerr, "tracing: could not write {}", path.string());
+        }
+      }
+    });
+  }
+#endif
+  (void)directory;
+  return {};
+}
+
+} // namespace Tracing
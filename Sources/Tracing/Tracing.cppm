@@ -0,0 +1,124 @@
+export module Tracing;
+
+import std;
+
+// Scoped hot-path spans for "where did the time go" questions a histogram
+// cannot answer: one race's move, stage by stage (read → decode → engine →
+// encode → send), laid out on a timeline.
+//
+// `Span` stamps the clock on construction and destruction and appends the pair
+// to a thread-local ring buffer (the newest `kRingCapacity` spans per thread;
+// older ones are overwritten). Nothing is shared on the recording path: no
+// lock, no allocation after a thread's first span. `chromeTrace()` walks every
+// ring — and the rings of recently exited threads — and renders Chrome
+// trace-event JSON for chrome://tracing or https://ui.perfetto.dev.
+//
+// Tracing is compiled in with the FIFTEEN_TRACING build option; without it
+// `kEnabled` is false and a `Span` is an empty object the optimizer deletes.
+//
+//   void handle() {
+//     const Tracing::Span span("handle"); // name must outlive the program: use a literal
+//     ...
+//   }
+export namespace Tracing {
+
+#if defined(FIFTEEN_TRACING)
+inline constexpr bool kEnabled = true;
+#else
+inline constexpr bool kEnabled = false;
+#endif
+
+// Spans kept per thread. Rings are allocated lazily, on a thread's first span.
+inline constexpr std::size_t kRingCapacity = 1024;
+
+} // namespace Tracing
+
+namespace Tracing {
+
+// One finished span. Fields are atomics only so a dump racing the owning
+// thread is not a data race; a slot overwritten mid-dump may come out mixed.
+struct Event {
+  std::atomic<const char *> name{nullptr};
+  std::atomic<std::int64_t> start{0}; // steady-clock nanoseconds
+  std::atomic<std::int64_t> duration{0};
+};
+
+struct Ring {
+  int thread = 0; // small sequential id, the trace's `tid`
+  std::atomic<std::uint64_t> written{0};
+  std::array<Event, kRingCapacity> events{};
+};
+
+// Owns the calling thread's ring: registers it on first use and, at thread
+// exit, hands it to the registry's retired list so its spans stay dumpable.
+struct LocalRing {
+  LocalRing();
+  ~LocalRing();
+  LocalRing(const LocalRing &) = delete;
+  LocalRing &operator=(const LocalRing &) = delete;
+
+  std::shared_ptr<Ring> ring;
+};
+
+inline Ring &localRing() {
+  thread_local LocalRing local;
+  return *local.ring;
+}
+
+inline std::int64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Single writer: only the owning thread appends, so the slot is filled with
+// relaxed stores and published by the release store of `written`.
+inline void record(const char *name, std::int64_t start, std::int64_t end) {
+  Ring &ring = localRing();
+  const std::uint64_t n = ring.written.load(std::memory_order_relaxed);
+  Event &event = ring.events[n % kRingCapacity];
+  event.name.store(name, std::memory_order_relaxed);
+  event.start.store(start, std::memory_order_relaxed);
+  event.duration.store(end - start, std::memory_order_relaxed);
+  ring.written.store(n + 1, std::memory_order_release);
+}
+
+} // namespace Tracing
+
+export namespace Tracing {
+
+// Records the lifetime of the enclosing scope under `name` (a string literal).
+class Span {
+public:
+  explicit Span(const char *name) {
+    if constexpr (kEnabled) {
+      name_ = name;
+      start_ = now();
+    }
+  }
+  ~Span() {
+    if constexpr (kEnabled) {
+      record(name_, start_, now());
+    }
+  }
+  Span(const Span &) = delete;
+  Span &operator=(const Span &) = delete;
+
+private:
+  const char *name_ = nullptr;
+  std::int64_t start_ = 0;
+};
+
+// Every recorded span as Chrome trace-event JSON ("X" complete events, one
+// `tid` per thread, timestamps in microseconds). `{"traceEvents":[]}` when
+// tracing is compiled out.
+std::string chromeTrace();
+
+// Installs a SIGUSR1 handler and returns the thread that answers it: each
+// signal writes `chromeTrace()` to `directory/fifteen-trace-<pid>-<n>.json`.
+// Destroying the returned thread stops it. Returns a non-joinable thread (and
+// installs nothing) when tracing is compiled out or the platform has no
+// SIGUSR1.
+std::jthread dumpOnSignal(std::filesystem::path directory);
+
+} // namespace Tracing
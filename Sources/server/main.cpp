@@ -9,9 +9,12 @@ import std;
 import Dependencies;
 import GameServer;
 import HttpServer;
+import ParService;
 import ServerBootstrap;
 import SharedModels;
 import SiteMiddleware;
+import SolverClientLive;
+import Tracing;
 
 using Dependencies::DependencyValues;
 using Dependencies::prepareDependencies;
@@ -34,11 +37,19 @@ int main() {
     (void)values.get<Dependencies::RandomNumberGeneratorKey>();
   });
 
-  const auto environment = ServerBootstrap::bootstrap();
+  auto environment = ServerBootstrap::bootstrap();
   if (!environment.has_value()) {
     std::println(std::cerr, "fifteen-server: could not open or migrate the database");
     return 1;
   }
+  // GET /admin/engine reads the referee's published snapshot, never the engine.
+  environment->site.engineState = []() -> std::optional<std::string> {
+    const auto snapshot = GameServer::latestSnapshot();
+    if (snapshot == nullptr) {
+      return std::nullopt;
+    }
+    return GameServer::encodeSnapshot(*snapshot);
+  };
 
   signal(SIGINT, &onSignal);
   signal(SIGTERM, &onSignal);
@@ -52,6 +63,13 @@ int main() {
                environment->envVars.httpPort, environment->envVars.multiplayerPort,
                environment->envVars.maxConnections, environment->envVars.databasePath);
 
+  // `kill -USR1 <pid>` writes the recent hot-path spans as a Chrome trace into
+  // the working directory (when built with FIFTEEN_TRACING).
+  const std::jthread traceDumper = Tracing::dumpOnSignal(std::filesystem::current_path());
+  if (traceDumper.joinable()) {
+    std::println("🔎 fifteen-server: SIGUSR1 dumps a Chrome trace of recent spans");
+  }
+
   // HTTP API on its own thread; the multiplayer referee runs on this one.
   std::jthread http([&](std::stop_token) {
     if (!HttpServer::serve(
@@ -66,15 +84,39 @@ int main() {
     }
   });
 
+  // Every deal is solved for its par on the pool's own threads while the match
+  // is played; a par that arrives after its result was stored is filled in.
+  auto &database = environment->site.database;
+  ParService::Pool pars(SolverClient::live(),
+                        ParService::Options{.threads = environment->envVars.parThreads},
+                        [&database](int grid, std::uint64_t seed, ParService::Par par) {
+                          (void)database.recordPar(grid, seed, par.moves);
+                        });
+
   // Multiplayer winners are server-verified; persist them straight into the
-  // same leaderboard the HTTP API serves.
+  // same leaderboard the HTTP API serves. The referee only queues deals and
+  // reads finished pars, so it never waits on a solve.
   const bool ok = GameServer::run(
       environment->envVars.multiplayerPort,
-      [&](const SharedModels::ScoreSubmission &result) {
-        (void)environment->site.database.saveGame(result);
-        std::println("🏁 verified multiplayer win: {} ({}x{}, {} moves, {}s)", result.name,
-                     result.gridSize, result.gridSize, result.moves, result.duration);
+      [&](SharedModels::ScoreSubmission result) {
+        const auto par = pars.lookup(result.gridSize, result.seed);
+        result.par = par.has_value() ? par->moves : 0;
+        (void)database.saveGame(result);
+        if (!par.has_value()) {
+          // Solved since the lookup (the row may have missed it), or never
+          // cached: store it now, or have it stored when it is found. A deal
+          // the pool could not solve stays cached, so it is not queued again.
+          if (const auto late = pars.lookup(result.gridSize, result.seed)) {
+            (void)database.recordPar(result.gridSize, result.seed, late->moves);
+          } else {
+            pars.request(result.gridSize, result.seed);
+          }
+        }
+        std::println("🏁 verified multiplayer win: {} ({}x{}, {} moves, par {}, {}s)",
+                     result.name, result.gridSize, result.gridSize, result.moves, result.par,
+                     result.duration);
       },
+      [&pars](const GameServer::Deal &deal) { pars.request(deal.grid, deal.seed); },
       environment->envVars.maxConnections, shutdownSource.get_token());
   if (!ok) {
     std::println(std::cerr, "fifteen-server: could not bind multiplayer port {}",
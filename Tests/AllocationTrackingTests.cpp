@@ -0,0 +1,76 @@
+// Tests AllocationTracking with the replacement allocator linked in: counts are
+// per thread, and a tagged scope reports exactly the allocations made inside
+// it through Metrics (or nothing at all when FIFTEEN_ALLOCATION_TRACKING is
+// off).
+
+import std;
+import AllocationTracking;
+import Metrics;
+
+namespace {
+
+int failures = 0;
+void expect(bool ok, std::string_view msg) {
+  if (!ok) {
+    ++failures;
+    std::println(std::cerr, "FAIL: {}", msg);
+  }
+}
+
+void testThreadTotalsCountThisThreadOnly() {
+  // Direct operator new calls: unlike new-expressions, the compiler may not
+  // elide them.
+  const AllocationTracking::Totals before = AllocationTracking::threadTotals();
+  void *block = ::operator new(64);
+  const AllocationTracking::Totals after = AllocationTracking::threadTotals();
+  ::operator delete(block);
+  expect(after.allocations - before.allocations == 1, "totals: one allocation");
+  expect(after.bytes - before.bytes == 64, "totals: bytes requested");
+
+  // Starting a thread allocates on this one, so read the totals after that.
+  std::latch go(1);
+  std::jthread worker([&go] {
+    go.wait();
+    ::operator delete(::operator new(1'000));
+  });
+  const AllocationTracking::Totals mine = AllocationTracking::threadTotals();
+  go.count_down();
+  worker.join();
+  expect(AllocationTracking::threadTotals().allocations == mine.allocations,
+         "totals: another thread's allocations are not counted here");
+}
+
+void testScopesReportThroughMetrics() {
+  static const AllocationTracking::Tag tag{"test"};
+  void *outside = ::operator new(1'000);
+  {
+    const AllocationTracking::Scope scope(tag);
+    ::operator delete(::operator new(24));
+    ::operator delete(::operator new(40));
+  }
+  ::operator delete(outside);
+
+  const std::string text = Metrics::scrape();
+  if constexpr (AllocationTracking::kEnabled) {
+    expect(text.contains("fifteen_allocations_total{scope=\"test\"} 2\n"),
+           "scope: only the allocations inside the scope");
+    expect(text.contains("fifteen_allocated_bytes_total{scope=\"test\"} 64\n"),
+           "scope: bytes inside the scope");
+  } else {
+    expect(!text.contains("fifteen_allocations_total"), "disabled: tags register no metrics");
+  }
+}
+
+} // namespace
+
+int main() {
+  testThreadTotalsCountThisThreadOnly();
+  testScopesReportThroughMetrics();
+
+  if (failures == 0) {
+    std::println("All AllocationTracking tests passed.");
+    return 0;
+  }
+  std::println(std::cerr, "{} AllocationTracking test(s) failed.", failures);
+  return 1;
+}
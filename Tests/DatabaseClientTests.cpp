@@ -1,6 +1,7 @@
 // Tests the SQLite-backed database client against an in-memory (":memory:")
 // database: migrate, save a few games, then verify best-scores ordering (per
-// board size, fastest first) and the aggregate stats.
+// board size, fastest first) and the aggregate stats, then the par ranking and
+// pars recorded after their games, and that a re-sent upload is stored once.
 
 import std;
 import DatabaseClient;
@@ -55,11 +56,117 @@ void testEmptyDatabase() {
   expect(stats.has_value() && stats->gamesPlayed == 0, "no games yet → 0");
 }
 
+void testSaveGamesInOneTransaction() {
+  auto db = DatabaseClient::live(":memory:");
+  expect(db.migrate().has_value(), "migrate for batch");
+
+  expect(db.saveGames({{.name = "Ada", .gridSize = 4, .moves = 80, .duration = 42},
+                       {.name = "Bob", .gridSize = 4, .moves = 60, .duration = 30}})
+             .has_value(),
+         "saveGames succeeds");
+  const auto stats = db.fetchStats();
+  expect(stats.has_value() && stats->gamesPlayed == 2, "saveGames stores every game");
+}
+
+void testOutboxQueue() {
+  auto db = DatabaseClient::live(":memory:");
+  expect(db.migrate().has_value(), "migrate for outbox");
+
+  db.enqueueSubmission({.name = "Ada", .gridSize = 4, .moves = 80, .duration = 42});
+  db.enqueueSubmission({.name = "Bob", .gridSize = 5, .moves = 99, .duration = 70});
+  db.enqueueSubmission({.name = "Cara", .gridSize = 4, .moves = 60, .duration = 30});
+
+  const auto firstTwo = db.fetchOutbox(2);
+  expect(firstTwo.has_value() && firstTwo->size() == 2, "outbox: limit respected");
+  expect(firstTwo.has_value() && firstTwo->size() == 2 &&
+             firstTwo->at(0).submission.name == "Ada" && firstTwo->at(1).submission.name == "Bob",
+         "outbox: oldest first");
+
+  if (firstTwo.has_value()) {
+    std::vector<std::int64_t> ids;
+    for (const auto &entry : *firstTwo) {
+      ids.push_back(entry.id);
+    }
+    expect(db.removeFromOutbox(ids).has_value(), "outbox: remove succeeds");
+  }
+  const auto rest = db.fetchOutbox(10);
+  expect(rest.has_value() && rest->size() == 1 && rest->front().submission.name == "Cara",
+         "outbox: only the unremoved entry is left");
+
+  const auto stats = db.fetchStats();
+  expect(stats.has_value() && stats->gamesPlayed == 0, "outbox: queued scores are not games");
+}
+
+void testClientIdsStoreOnce() {
+  auto db = DatabaseClient::live(":memory:");
+  expect(db.migrate().has_value(), "migrate for client ids");
+
+  db.enqueueSubmission({.name = "Ada", .gridSize = 4, .moves = 80, .duration = 42});
+  db.enqueueSubmission({.name = "Bob", .gridSize = 4, .moves = 60, .duration = 30});
+  const auto queued = db.fetchOutbox(10);
+  expect(queued.has_value() && queued->size() == 2 && !queued->at(0).submission.clientId.empty() &&
+             queued->at(0).submission.clientId != queued->at(1).submission.clientId,
+         "client ids: each outbox entry has its own");
+  if (!queued.has_value() || queued->size() != 2) {
+    return;
+  }
+
+  const std::vector<SharedModels::ScoreSubmission> batch{queued->at(0).submission,
+                                                         queued->at(1).submission};
+  expect(db.saveGames(batch).has_value(), "client ids: the batch is stored");
+  expect(db.saveGames(batch).has_value(), "client ids: the batch sent again succeeds");
+  expect(db.saveGame(batch.front()).has_value(), "client ids: one entry sent again succeeds");
+  auto stats = db.fetchStats();
+  expect(stats.has_value() && stats->gamesPlayed == 2, "client ids: a re-sent entry is skipped");
+
+  // Games without one are never taken for each other.
+  db.saveGame({.name = "Cara", .gridSize = 4, .moves = 50, .duration = 20});
+  db.saveGame({.name = "Cara", .gridSize = 4, .moves = 50, .duration = 20});
+  stats = db.fetchStats();
+  expect(stats.has_value() && stats->gamesPlayed == 4, "client ids: games without one all count");
+}
+
+void testRankByPar() {
+  auto db = DatabaseClient::live(":memory:");
+  expect(db.migrate().has_value(), "migrate for par");
+
+  // Ada's deal was hard (par 60), Bob's easy (par 20); Cara's was not dealt by
+  // the server, and Dan's par is not known yet.
+  db.saveGame({.name = "Ada", .gridSize = 4, .moves = 66, .duration = 50, .seed = 1, .par = 60});
+  db.saveGame({.name = "Bob", .gridSize = 4, .moves = 30, .duration = 20, .seed = 2, .par = 20});
+  db.saveGame({.name = "Cara", .gridSize = 4, .moves = 10, .duration = 5});
+  db.saveGame({.name = "Dan", .gridSize = 4, .moves = 41, .duration = 40, .seed = 3});
+
+  const auto byTime = db.fetchBestScores(4);
+  expect(byTime.has_value() && byTime->size() == 4 && byTime->front().name == "Cara",
+         "par: the time ranking is unchanged");
+  const auto byPar = db.fetchBestScoresByPar(4);
+  expect(byPar.has_value() && byPar->size() == 2, "par: only games with a par are ranked");
+  if (byPar.has_value() && byPar->size() == 2) {
+    expect((*byPar)[0].name == "Ada" && (*byPar)[0].par == 60, "par: 1.1× par beats 1.5× par");
+    expect((*byPar)[1].name == "Bob", "par: more moves per par move ranks lower");
+  }
+
+  // A late par fills in only games of that deal that have none.
+  expect(db.recordPar(4, 3, 40).has_value(), "par: recordPar succeeds");
+  expect(db.recordPar(4, 1, 10).has_value(), "par: recordPar on a known par succeeds");
+  const auto filled = db.fetchBestScoresByPar(4);
+  expect(filled.has_value() && filled->size() == 3, "par: the late par ranks Dan's game");
+  if (filled.has_value() && filled->size() == 3) {
+    expect((*filled)[0].name == "Dan" && (*filled)[0].par == 40, "par: 41/40 ranks first");
+    expect((*filled)[1].name == "Ada" && (*filled)[1].par == 60, "par: a known par is kept");
+  }
+}
+
 } // namespace
 
 int main() {
   testSaveAndQuery();
   testEmptyDatabase();
+  testSaveGamesInOneTransaction();
+  testOutboxQueue();
+  testClientIdsStoreOnce();
+  testRankByPar();
   if (failures == 0) {
     std::println("All DatabaseClient tests passed.");
     return 0;
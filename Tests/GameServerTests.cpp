@@ -2,7 +2,8 @@
 // deals both players the same seed, moves are re-played (and illegal ones
 // rejected) on the server's own boards, the win is detected by the referee —
 // never claimed by a client — and a verified result comes out the other end.
-// Time and randomness are pinned through the Dependencies library.
+// Time and randomness are pinned through the Dependencies library. Last, over a
+// real socket, the published engine snapshot once the last player disconnects.
 
 import std;
 import Dependencies;
@@ -10,6 +11,7 @@ import GameServer;
 import MultiplayerCore;
 import PuzzleCore;
 import SharedModels;
+import TcpSocket;
 
 using Dependencies::DependencyContext;
 using Dependencies::DependencyValues;
@@ -93,7 +95,10 @@ void testMatchmakingDealsTheSameBoard() {
              "matchmaking: agreed grid size");
       expect(startForAda->opponentName == "Bob" && startForBob->opponentName == "Ada",
              "matchmaking: opponents introduced by name");
+      expect(started.deals == std::vector{GameServer::Deal{.grid = 4, .seed = startForAda->seed}},
+             "matchmaking: the deal is reported once, for its par");
     }
+    expect(queued.deals.empty(), "matchmaking: queueing deals nothing");
   });
 }
 
@@ -179,6 +184,8 @@ void testServerDetectsTheWinAndVerifiesTheResult() {
       expect(result.moves == static_cast<int>(solution.size()),
              "win: result carries the replayed move count");
       expect(result.duration == 0, "win: pinned clock gives a zero duration");
+      expect(result.seed == start->seed && result.par == 0,
+             "win: result names the deal and leaves its par to the shell");
     }
 
     // The race is over: further moves are ignored.
@@ -250,6 +257,110 @@ void testLiveFeedTracksMatches() {
   });
 }
 
+void testActiveRoomsCountsMatchesInProgress() {
+  withPinnedDependencies([] {
+    GameServer::Engine engine;
+    (void)engine.join(1, "Ada", 4);
+    expect(engine.activeRooms() == 0, "rooms: a queued player is not a match");
+    const auto started = engine.join(2, "Bob", 4);
+    (void)engine.join(3, "Cy", 5);
+    (void)engine.join(4, "Dee", 5);
+    expect(engine.activeRooms() == 2, "rooms: two matches in progress");
+
+    const auto *start = messageFor<MultiplayerCore::Start>(started, 1);
+    for (const int move : solutionFor(4, start->seed)) {
+      (void)engine.move(1, move);
+    }
+    expect(engine.activeRooms() == 1, "rooms: a solved match is no longer active");
+
+    (void)engine.leave(3);
+    expect(engine.activeRooms() == 0, "rooms: a walkover ends the match");
+    (void)engine.leave(1);
+    (void)engine.leave(2);
+    (void)engine.leave(4);
+    expect(engine.activeRooms() == 0, "rooms: leaving finished rooms does not double count");
+  });
+}
+
+void testSnapshotReportsRoomsQueuesAndMemory() {
+  withPinnedDependencies([] {
+    GameServer::Engine engine;
+    (void)engine.observe(100);
+    (void)engine.join(1, "Ada", 4);
+    const auto started = engine.join(2, "Bob", 4);
+    (void)engine.join(3, "Cy", 5);
+    (void)engine.join(4, "Dee", 6);
+    (void)engine.join(5, "Eve", 6);
+
+    const auto *start = messageFor<MultiplayerCore::Start>(started, 1);
+    const std::vector<int> solution = solutionFor(4, start->seed);
+    (void)engine.move(1, solution.front());
+    (void)engine.move(1, solution[1]);
+
+    const GameServer::EngineSnapshot snapshot = engine.snapshot();
+    expect(snapshot.takenAt == 50.0, "snapshot: stamped with the pinned clock");
+    expect(snapshot.roomsByGrid == std::map<int, int>{{4, 1}, {6, 1}},
+           "snapshot: rooms counted by grid");
+    expect(snapshot.queuedByGrid == std::map<int, int>{{5, 1}}, "snapshot: queue by grid");
+    expect(snapshot.observers == 1, "snapshot: observer count");
+    expect(snapshot.rooms.size() == 2, "snapshot: one entry per room, not per player");
+    if (snapshot.rooms.size() == 2) {
+      const GameServer::RoomSnapshot &room = snapshot.rooms.front();
+      expect(room.gridSize == 4 && room.moves == std::vector<int>{2, 0},
+             "snapshot: per-player move counts");
+      expect(room.ageSeconds == 0.0 && !room.finished, "snapshot: age from the pinned clock");
+    }
+    expect(snapshot.boardBytes >= (16 + 16 + 36 + 36) * sizeof(std::string),
+           "snapshot: board memory covers every tile");
+    expect(snapshot.historyBytes >= 2 * sizeof(int), "snapshot: history memory");
+
+    const std::string json = GameServer::encodeSnapshot(snapshot);
+    expect(json.find(R"("roomsByGrid":{"4":1,"6":1})") != std::string::npos,
+           "snapshot: JSON keys grids by size");
+    expect(json.find(R"("moves":[2,0])") != std::string::npos, "snapshot: JSON per-room moves");
+  });
+}
+
+// Over a socket: the last player to disconnect leaves a snapshot without them,
+// even within a second of the previous one — nobody else is left to publish.
+void testLastDisconnectPublishesTheSnapshot() {
+  constexpr int kPort = 47391;
+  std::jthread server([](std::stop_token stop) {
+    (void)GameServer::run(kPort, nullptr, nullptr, 0, std::move(stop));
+  });
+  std::optional<TcpSocket::Connection> client;
+  for (int attempt = 0; attempt < 100 && !client; ++attempt) {
+    client = TcpSocket::Connection::connect("127.0.0.1", kPort);
+    if (!client) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+  }
+  expect(client.has_value(), "disconnect: connected to the server");
+  if (!client) {
+    return;
+  }
+  const auto queued = [] {
+    const auto snapshot = GameServer::latestSnapshot();
+    return snapshot ? snapshot->queuedByGrid : std::map<int, int>{};
+  };
+  const auto within = [](std::chrono::milliseconds timeout, const std::function<bool()> &done) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!done() && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return done();
+  };
+
+  client->sendAll(
+      MultiplayerCore::encode(MultiplayerCore::ClientMessage{MultiplayerCore::Join{"Ada", 4}}) +
+      "\n");
+  expect(within(std::chrono::seconds(3), [&] { return queued() == std::map<int, int>{{4, 1}}; }),
+         "disconnect: the waiting player is published");
+  client->close(); // within a second of that snapshot
+  expect(within(std::chrono::seconds(3), [&] { return queued().empty(); }),
+         "disconnect: the snapshot drops the player once nobody is connected");
+}
+
 } // namespace
 
 int main() {
@@ -259,6 +370,9 @@ int main() {
   testServerDetectsTheWinAndVerifiesTheResult();
   testLeavingMidRaceNotifiesTheOpponent();
   testLiveFeedTracksMatches();
+  testActiveRoomsCountsMatchesInProgress();
+  testSnapshotReportsRoomsQueuesAndMemory();
+  testLastDisconnectPublishesTheSnapshot();
 
   if (failures == 0) {
     std::println("All GameServer tests passed.");
@@ -0,0 +1,99 @@
+// Tests the Metrics registry: recording from many threads adds up, counts
+// survive the threads that made them, histograms bucket by upper bound, and
+// the scrape renders the Prometheus text format.
+
+import std;
+import Metrics;
+
+namespace {
+
+int failures = 0;
+void expect(bool ok, std::string_view msg) {
+  if (!ok) {
+    ++failures;
+    std::println(std::cerr, "FAIL: {}", msg);
+  }
+}
+
+bool contains(std::string_view text, std::string_view needle) {
+  return text.find(needle) != std::string_view::npos;
+}
+
+void testCountersSumAcrossThreads() {
+  static const Metrics::Counter counter{"test_events_total", "Events."};
+  {
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < 8; ++t) {
+      threads.emplace_back([] {
+        for (int i = 0; i < 10'000; ++i) {
+          counter.inc();
+        }
+      });
+    }
+  } // joined: every shard has been folded into the retired totals
+  expect(counter.value() == 80'000, "counter: 8 threads x 10k increments, none lost");
+
+  counter.inc(5);
+  expect(counter.value() == 80'005, "counter: live shard and retired totals both count");
+}
+
+void testGaugesGoBothWays() {
+  static const Metrics::Gauge gauge{"test_open", "Open things."};
+  gauge.inc();
+  gauge.inc();
+  std::jthread([] { gauge.dec(); }).join();
+  expect(gauge.value() == 1, "gauge: a decrement on another thread nets out");
+  gauge.add(-3);
+  expect(gauge.value() == -2, "gauge: can go negative");
+}
+
+void testHistogramBuckets() {
+  static const Metrics::Histogram histogram{
+      "test_latency_seconds", "Latency.", {{"route", "a"}}, {0.001, 0.01}};
+  histogram.observe(std::chrono::microseconds(500)); // <= 1ms
+  histogram.observe(std::chrono::milliseconds(1));   // exactly on a bound: same bucket
+  histogram.observe(std::chrono::milliseconds(5));   // <= 10ms
+  histogram.observe(std::chrono::seconds(1));        // +Inf
+  expect(histogram.count() == 4, "histogram: count is every observation");
+
+  const std::string text = Metrics::scrape();
+  expect(contains(text, "test_latency_seconds_bucket{route=\"a\",le=\"0.001\"} 2\n"),
+         "histogram: le is inclusive");
+  expect(contains(text, "test_latency_seconds_bucket{route=\"a\",le=\"0.01\"} 3\n"),
+         "histogram: buckets are cumulative");
+  expect(contains(text, "test_latency_seconds_bucket{route=\"a\",le=\"+Inf\"} 4\n"),
+         "histogram: +Inf holds everything");
+  expect(contains(text, "test_latency_seconds_count{route=\"a\"} 4\n"), "histogram: _count");
+  expect(contains(text, "test_latency_seconds_sum{route=\"a\"} 1.0065\n"),
+         "histogram: _sum in seconds");
+}
+
+void testExpositionFormat() {
+  static const Metrics::Counter hits{"test_hits_total", "Hits by route.", {{"route", "x"}}};
+  static const Metrics::Counter otherHits{"test_hits_total", "Hits by route.", {{"route", "y"}}};
+  hits.inc(2);
+  otherHits.inc();
+
+  const std::string text = Metrics::scrape();
+  expect(contains(text, "# HELP test_hits_total Hits by route.\n# TYPE test_hits_total counter\n"
+                        "test_hits_total{route=\"x\"} 2\ntest_hits_total{route=\"y\"} 1\n"),
+         "scrape: one HELP/TYPE header, then every labelled series");
+  expect(contains(text, "# TYPE test_open gauge\ntest_open -2\n"), "scrape: gauges are signed");
+  expect(contains(text, "# TYPE test_latency_seconds histogram\n"), "scrape: histogram type");
+}
+
+} // namespace
+
+int main() {
+  testCountersSumAcrossThreads();
+  testGaugesGoBothWays();
+  testHistogramBuckets();
+  testExpositionFormat();
+
+  if (failures == 0) {
+    std::println("All Metrics tests passed.");
+    return 0;
+  }
+  std::println(std::cerr, "{} Metrics test(s) failed.", failures);
+  return 1;
+}
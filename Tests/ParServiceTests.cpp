@@ -0,0 +1,181 @@
+// Tests the par pool against a stub solver: an exact hint is the par, anything
+// else falls back to the search; requests return at once while a solve is
+// still running, repeats of a deal share one solve, every par reaches `onPar`
+// and the cache, a deal with no par is not solved again, and the cache drops
+// its oldest deals first.
+
+import std;
+import ParService;
+import SolverClient;
+
+namespace {
+
+int failures = 0;
+void expect(bool ok, std::string_view msg) {
+  if (!ok) {
+    ++failures;
+    std::println(std::cerr, "FAIL: {}", msg);
+  }
+}
+
+// Polls `done` for up to a few seconds; the pool reports from its own threads.
+bool eventually(const std::function<bool()> &done) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!done()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+SolverClient::Client exactHints(int distance) {
+  SolverClient::Client solver;
+  solver.hint = [distance](std::vector<std::string>, int, std::chrono::milliseconds,
+                           std::stop_token) {
+    return std::expected<SolverClient::Hint, SolverClient::SolveError>{
+        SolverClient::Hint{.move = 0, .distance = distance, .optimal = true}};
+  };
+  solver.search = [](std::vector<std::string>, int, std::size_t, std::stop_token) {
+    return std::expected<SolverClient::Plan, SolverClient::SolveError>{
+        std::unexpected(SolverClient::SolveError::memoryLimit)};
+  };
+  return solver;
+}
+
+void testSolve() {
+  const ParService::Options options;
+  expect(ParService::solve(exactHints(7), 4, 1, options, {}) ==
+             ParService::Par{.moves = 7, .optimal = true},
+         "solve: an exact hint is the par");
+
+  SolverClient::Client searching;
+  searching.hint = [](std::vector<std::string>, int, std::chrono::milliseconds, std::stop_token) {
+    return std::expected<SolverClient::Hint, SolverClient::SolveError>{
+        SolverClient::Hint{.move = 0, .distance = 5}};
+  };
+  std::size_t searchedWith = 0;
+  searching.search = [&searchedWith](std::vector<std::string>, int grid,
+                                     std::size_t memoryLimit, std::stop_token) {
+    searchedWith = memoryLimit;
+    return std::expected<SolverClient::Plan, SolverClient::SolveError>{SolverClient::Plan{
+        .moves = std::vector<int>(static_cast<std::size_t>(grid * 3), 0), .optimal = false}};
+  };
+  expect(ParService::solve(searching, 5, 1, options, {}) == ParService::Par{.moves = 15},
+         "solve: a lower bound falls back to the search");
+  expect(searchedWith == options.searchBytes, "solve: the search gets the memory budget");
+
+  SolverClient::Client failing = exactHints(0);
+  failing.hint = [](std::vector<std::string>, int, std::chrono::milliseconds, std::stop_token) {
+    return std::expected<SolverClient::Hint, SolverClient::SolveError>{
+        std::unexpected(SolverClient::SolveError::cancelled)};
+  };
+  expect(!ParService::solve(failing, 6, 1, options, {}).has_value(),
+         "solve: no par when neither finds a solution");
+}
+
+void testRequestsNeverWait() {
+  // The solver holds every solve until released, like a long search would.
+  std::mutex mutex;
+  std::condition_variable released;
+  bool release = false;
+  std::atomic<int> solves = 0;
+  SolverClient::Client solver = exactHints(0);
+  solver.hint = [&](std::vector<std::string>, int grid, std::chrono::milliseconds,
+                    std::stop_token) {
+    ++solves;
+    std::unique_lock lock(mutex);
+    released.wait(lock, [&] { return release; });
+    return std::expected<SolverClient::Hint, SolverClient::SolveError>{
+        SolverClient::Hint{.move = 0, .distance = grid * 10, .optimal = true}};
+  };
+
+  std::mutex reportedMutex;
+  std::vector<std::tuple<int, std::uint64_t, int>> reported;
+  ParService::Pool pool(solver, ParService::Options{.threads = 2},
+                        [&](int grid, std::uint64_t seed, ParService::Par par) {
+                          std::scoped_lock lock(reportedMutex);
+                          reported.emplace_back(grid, seed, par.moves);
+                        });
+
+  pool.request(4, 7);
+  pool.request(4, 7); // the other player's result, or a rematch
+  pool.request(5, 7);
+  expect(pool.pending() == 2, "pool: a repeated deal is queued once");
+  expect(!pool.lookup(4, 7).has_value(), "pool: no par while the solve runs");
+  expect(eventually([&] { return solves == 2; }), "pool: both deals are being solved");
+
+  {
+    std::scoped_lock lock(mutex);
+    release = true;
+  }
+  released.notify_all();
+  expect(eventually([&] {
+           std::scoped_lock lock(reportedMutex);
+           return reported.size() == 2;
+         }),
+         "pool: both pars are reported");
+  expect(pool.pending() == 0, "pool: the queue drains");
+  expect(pool.lookup(4, 7) == ParService::Par{.moves = 40, .optimal = true},
+         "pool: the 4x4 par is cached");
+  expect(pool.lookup(5, 7) == ParService::Par{.moves = 50, .optimal = true},
+         "pool: deals are keyed by grid and seed");
+  {
+    std::scoped_lock lock(reportedMutex);
+    std::ranges::sort(reported);
+    expect(reported == std::vector<std::tuple<int, std::uint64_t, int>>{{4, 7, 40}, {5, 7, 50}},
+           "pool: each par is reported once");
+  }
+
+  pool.request(4, 7);
+  expect(pool.pending() == 0 && solves == 2, "pool: a cached deal is not solved again");
+}
+
+void testFailuresAreCached() {
+  std::atomic<int> solves = 0;
+  SolverClient::Client failing = exactHints(0);
+  failing.hint = [&solves](std::vector<std::string>, int, std::chrono::milliseconds,
+                           std::stop_token) {
+    ++solves;
+    return std::expected<SolverClient::Hint, SolverClient::SolveError>{
+        std::unexpected(SolverClient::SolveError::cancelled)};
+  };
+  std::atomic<int> reported = 0;
+  ParService::Pool pool(failing, ParService::Options{.threads = 1},
+                        [&reported](int, std::uint64_t, ParService::Par) { ++reported; });
+  pool.request(4, 7);
+  expect(eventually([&] { return pool.pending() == 0; }), "failure: the solve finishes");
+  expect(!pool.lookup(4, 7).has_value() && reported == 0, "failure: no par is reported");
+
+  pool.request(4, 7);
+  expect(pool.pending() == 0 && solves == 1, "failure: a deal with no par is not solved again");
+}
+
+void testCacheDropsTheOldest() {
+  ParService::Pool pool(exactHints(9), ParService::Options{.threads = 1, .capacity = 2},
+                        nullptr);
+  for (std::uint64_t seed = 1; seed <= 3; ++seed) {
+    pool.request(4, seed);
+    expect(eventually([&] { return pool.lookup(4, seed).has_value(); }),
+           "cache: each par arrives");
+  }
+  expect(!pool.lookup(4, 1).has_value(), "cache: the oldest par is dropped");
+  expect(pool.lookup(4, 2).has_value() && pool.lookup(4, 3).has_value(),
+         "cache: the newest pars are kept");
+}
+
+} // namespace
+
+int main() {
+  testSolve();
+  testRequestsNeverWait();
+  testFailuresAreCached();
+  testCacheDropsTheOldest();
+  if (failures == 0) {
+    std::println("All ParService tests passed.");
+    return 0;
+  }
+  std::println(std::cerr, "{} ParService test(s) failed.", failures);
+  return 1;
+}
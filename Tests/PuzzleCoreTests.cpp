@@ -0,0 +1,273 @@
+// Tests PuzzleCore's search board and walking-distance tables: the table has
+// the known 24,964 states, the incremental update after a slide agrees with
+// recomputing from scratch, and the heuristic never overestimates. Zobrist
+// hashes follow slides the same way, and the transposition table keeps the
+// right entries and never hands a reader a torn one. Also covers cancelling
+// back-and-forth taps out of a plan and the 2×3/3×3 endgame tables.
+
+import std;
+import Dependencies;
+import PuzzleCore;
+
+namespace {
+
+int failures = 0;
+void expect(bool ok, std::string_view msg) {
+  if (!ok) {
+    ++failures;
+    std::println(std::cerr, "FAIL: {}", msg);
+  }
+}
+
+void testBoardFromTiles() {
+  const auto solved = PuzzleCore::boardFromTiles(PuzzleCore::solvedTiles(4), 4);
+  expect(solved == PuzzleCore::solvedBoard(4), "board: solved tiles give the solved board");
+  expect(solved && PuzzleCore::isSolved(*solved), "board: solved board is solved");
+  expect(solved && solved->blank == 15, "board: blank found");
+
+  auto tiles = PuzzleCore::scrambled(5, 7);
+  const auto board = PuzzleCore::boardFromTiles(tiles, 5);
+  expect(board && board->cells.size() == 25, "board: 5x5 converts");
+  expect(board && tiles[static_cast<std::size_t>(board->blank)].empty(), "board: 5x5 blank");
+
+  expect(board && PuzzleCore::isSolvable(*board), "board: a dealt board is solvable");
+  auto swapped = *board;
+  std::swap(swapped.cells[swapped.blank == 0 ? 1 : 0], swapped.cells[swapped.blank == 2 ? 3 : 2]);
+  expect(!PuzzleCore::isSolvable(swapped), "board: swapping two tiles makes it unsolvable");
+
+  tiles[0] = tiles[1];
+  expect(!PuzzleCore::boardFromTiles(tiles, 5), "board: duplicate tile rejected");
+  expect(!PuzzleCore::boardFromTiles({"1", "2", "x", ""}, 2), "board: label rejected");
+  expect(!PuzzleCore::boardFromTiles({"1", "2", ""}, 2), "board: wrong size rejected");
+}
+
+void testSlideMatchesTilesSlide() {
+  auto tiles = PuzzleCore::solvedTiles(4);
+  std::vector<int> history;
+  PuzzleCore::Board board = PuzzleCore::solvedBoard(4);
+  expect(!PuzzleCore::slide(board, 0), "slide: non-adjacent cell rejected");
+  expect(!PuzzleCore::slide(board, 16), "slide: out of range rejected");
+  for (const int cell : {14, 10, 11, 7, 6, 2}) {
+    expect(PuzzleCore::slide(board, cell), "slide: adjacent cell moves");
+    PuzzleCore::slide(tiles, history, 4, cell);
+  }
+  expect(PuzzleCore::boardFromTiles(tiles, 4) == board, "slide: agrees with the tiles rule");
+  // Cell 3 is the end of row 0; cell 4 starts row 1: not neighbours.
+  board = *PuzzleCore::boardFromTiles({"1", "2", "3", "", "4", "5", "6", "7", "8", "9", "10",
+                                       "11", "12", "13", "14", "15"},
+                                      4);
+  expect(!PuzzleCore::slide(board, 4), "slide: no wrap between rows");
+}
+
+void testWithoutBacktracks() {
+  // Out and back (twice, nested) disappears; a loop around a block does not.
+  expect(PuzzleCore::withoutBacktracks({14, 10, 14, 15}, 15) == std::vector<int>{},
+         "backtracks: nested pairs cancel");
+  expect(PuzzleCore::withoutBacktracks({14, 10, 11, 15}, 15) == std::vector<int>{14, 10, 11, 15},
+         "backtracks: a loop is kept");
+
+  // A random walk that may step straight back, as a player's taps do.
+  auto rng = Dependencies::RandomNumberGenerator::seeded(5);
+  auto tiles = PuzzleCore::solvedTiles(6);
+  std::vector<int> history;
+  for (int i = 0; i < 360; ++i) {
+    const auto options = PuzzleCore::neighbors(*PuzzleCore::emptyIndex(tiles), 6);
+    PuzzleCore::slide(tiles, history, 6, options[PuzzleCore::nextIndex(rng, options.size())]);
+  }
+  const auto direct = PuzzleCore::withoutBacktracks(history, 35);
+  auto replayed = PuzzleCore::solvedTiles(6);
+  std::vector<int> replayHistory;
+  for (const int pos : direct) {
+    PuzzleCore::slide(replayed, replayHistory, 6, pos);
+  }
+  expect(direct.size() < history.size() && replayed == tiles, "backtracks: same board, fewer taps");
+}
+
+void testWalkingDistanceTables() {
+  const auto &wd = PuzzleCore::WalkingDistance::tables();
+  expect(wd.stateCount() == 24'964, "wd: table size");
+  expect(&wd == &PuzzleCore::WalkingDistance::tables(), "wd: generated once");
+
+  const auto solved = wd.stateOf(PuzzleCore::solvedBoard(4));
+  expect(wd.distance(solved) == 0, "wd: solved is 0");
+
+  // One slide away: exactly one.
+  PuzzleCore::Board board = PuzzleCore::solvedBoard(4);
+  PuzzleCore::slide(board, 14);
+  expect(wd.distance(wd.stateOf(board)) == 1, "wd: one slide is 1");
+}
+
+void testIncrementalUpdateAndBound() {
+  const auto &wd = PuzzleCore::WalkingDistance::tables();
+  auto rng = Dependencies::RandomNumberGenerator::seeded(2024);
+  PuzzleCore::Board board = PuzzleCore::solvedBoard(4);
+  auto state = wd.stateOf(board);
+  bool agrees = true;
+  bool bounded = true;
+  for (int walked = 1; walked <= 2'000; ++walked) {
+    const auto options = PuzzleCore::neighbors(board.blank, 4);
+    const int cell = options[static_cast<std::size_t>(rng() % options.size())];
+    state = wd.afterSlide(state, board, cell);
+    PuzzleCore::slide(board, cell);
+    agrees = agrees && state == wd.stateOf(board);
+    // A random walk of n slides proves the board is at most n from solved.
+    bounded = bounded && wd.distance(state) <= walked;
+  }
+  expect(agrees, "wd: incremental update matches a full recompute");
+  expect(bounded, "wd: never more than the walk length");
+
+  // The classic hard instance needs 80 moves; WD must stay at or under that.
+  const auto hard = *PuzzleCore::boardFromTiles(
+      {"", "12", "9", "13", "15", "11", "10", "14", "3", "7", "2", "5", "4", "8", "6", "1"}, 4);
+  const int h = wd.distance(wd.stateOf(hard));
+  expect(h > 0 && h <= 80, "wd: 80-move board is admissible");
+}
+
+void testEndgameTables() {
+  const auto &small = PuzzleCore::EndgameTable::twoByThree();
+  const auto &corner = PuzzleCore::EndgameTable::threeByThree();
+  expect(small.stateCount() == 360 && small.maxDistance() == 21, "endgame: 2x3 table");
+  expect(corner.stateCount() == 181'440 && corner.maxDistance() == 31, "endgame: 3x3 table");
+
+  // One of the two hardest 8-puzzle positions.
+  const auto hardest =
+      *PuzzleCore::boardFromTiles({"8", "6", "7", "2", "5", "4", "3", "", "1"}, 3);
+  expect(corner.covers(hardest) && corner.distance(hardest) == 31, "endgame: 31 moves");
+
+  // Scramble only the bottom-right corner of a 6×6 board; following the
+  // table's moves finishes in exactly its distance.
+  auto rng = Dependencies::RandomNumberGenerator::seeded(31);
+  PuzzleCore::Board board = PuzzleCore::solvedBoard(6);
+  for (int i = 0; i < 200; ++i) {
+    std::vector<int> inCorner;
+    for (const int cell : PuzzleCore::neighbors(board.blank, 6)) {
+      if (cell / 6 >= 3 && cell % 6 >= 3) {
+        inCorner.push_back(cell);
+      }
+    }
+    PuzzleCore::slide(board, inCorner[PuzzleCore::nextIndex(rng, inCorner.size())]);
+  }
+  expect(corner.covers(board), "endgame: covers a scrambled corner");
+  const int distance = corner.distance(board);
+  int moves = 0;
+  while (const auto move = corner.nextMove(board)) {
+    PuzzleCore::slide(board, *move);
+    ++moves;
+  }
+  expect(PuzzleCore::isSolved(board) && moves == distance, "endgame: next moves finish");
+
+  PuzzleCore::slide(board, 34);
+  PuzzleCore::slide(board, 28);
+  expect(small.covers(board) && small.distance(board) == 2, "endgame: 2x3 corner");
+  PuzzleCore::slide(board, 27);
+  PuzzleCore::slide(board, 26);
+  expect(!corner.covers(board), "endgame: a tile outside the corner is out of place");
+}
+
+void testZobristHashFollowsSlides() {
+  auto rng = Dependencies::RandomNumberGenerator::seeded(99);
+  PuzzleCore::Board board = PuzzleCore::solvedBoard(5);
+  const std::uint64_t solved = board.hash;
+  expect(solved == PuzzleCore::zobristHash(board), "hash: solved board");
+  expect(solved != PuzzleCore::solvedBoard(4).hash, "hash: grids differ");
+
+  std::unordered_set<std::uint64_t> seen{solved};
+  std::set<std::vector<std::uint8_t>> boards{board.cells};
+  bool agrees = true;
+  for (int i = 0; i < 5'000; ++i) {
+    const auto options = PuzzleCore::neighbors(board.blank, 5);
+    PuzzleCore::slide(board, options[static_cast<std::size_t>(rng() % options.size())]);
+    agrees = agrees && board.hash == PuzzleCore::zobristHash(board);
+    seen.insert(board.hash);
+    boards.insert(board.cells);
+  }
+  expect(agrees, "hash: incremental update matches a full recompute");
+  expect(seen.size() == boards.size(), "hash: distinct boards, distinct hashes");
+
+  // Sliding back restores the hash exactly.
+  const std::uint64_t before = board.hash;
+  const int blank = board.blank;
+  PuzzleCore::slide(board, PuzzleCore::neighbors(blank, 5).front());
+  PuzzleCore::slide(board, blank);
+  expect(board.hash == before, "hash: slide and back");
+}
+
+void testTranspositionTable() {
+  using Entry = PuzzleCore::TranspositionTable::Entry;
+  PuzzleCore::TranspositionTable table(64 * 1024);
+  expect(table.capacity() == 4'096, "tt: 1024 buckets of 4");
+  expect(!table.probe(42), "tt: empty");
+
+  table.store(42, Entry{.bound = 30, .next = 7, .exact = true, .depth = 30});
+  expect(table.probe(42) == Entry{.bound = 30, .next = 7, .exact = true, .depth = 30},
+         "tt: round trip");
+  table.store(42, Entry{.bound = 31});
+  expect(table.probe(42) == Entry{.bound = 31}, "tt: same key overwrites");
+
+  // Six keys for one bucket of four: the exact and the deep entries survive
+  // the two shallow newcomers.
+  const std::uint64_t stride = 1'024;
+  table.clear();
+  table.store(1 * stride, Entry{.bound = 10, .exact = true, .depth = 1});
+  table.store(2 * stride, Entry{.bound = 10, .depth = 50});
+  table.store(3 * stride, Entry{.bound = 10, .depth = 1});
+  table.store(4 * stride, Entry{.bound = 10, .depth = 2});
+  table.store(5 * stride, Entry{.bound = 10, .depth = 3});
+  table.store(6 * stride, Entry{.bound = 10, .depth = 4});
+  expect(table.probe(1 * stride) && table.probe(2 * stride), "tt: exact and deep entries kept");
+  expect(table.probe(6 * stride) && !table.probe(3 * stride), "tt: shallowest replaced");
+
+  // After aging, the old generation goes first, however deep.
+  table.age();
+  table.store(7 * stride, Entry{.bound = 10, .depth = 0});
+  expect(table.probe(7 * stride).has_value(), "tt: new generation stored");
+  expect(!table.probe(5 * stride), "tt: the shallowest old entry made room");
+}
+
+void testTranspositionTableAcrossThreads() {
+  // Writers hammer a tiny table so slots are contended; every entry encodes
+  // its key, so a reader that ever got a torn slot would see a mismatch.
+  PuzzleCore::TranspositionTable table(4 * 64);
+  std::atomic<int> torn = 0;
+  std::atomic<int> hits = 0;
+  {
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&table, &torn, &hits, t] {
+        for (std::uint64_t i = 0; i < 200'000; ++i) {
+          const std::uint64_t key = PuzzleCore::splitMix64(i % 64 + 1);
+          const auto expected = static_cast<std::uint16_t>(key);
+          if (i % 2 == static_cast<std::uint64_t>(t % 2)) {
+            table.store(key, PuzzleCore::TranspositionTable::Entry{.bound = expected});
+          } else if (const auto held = table.probe(key)) {
+            ++hits;
+            torn += held->bound != expected ? 1 : 0;
+          }
+        }
+      });
+    }
+  }
+  expect(hits > 0, "tt threads: readers found entries");
+  expect(torn == 0, "tt threads: no torn entries");
+}
+
+} // namespace
+
+int main() {
+  testBoardFromTiles();
+  testSlideMatchesTilesSlide();
+  testWithoutBacktracks();
+  testWalkingDistanceTables();
+  testIncrementalUpdateAndBound();
+  testEndgameTables();
+  testZobristHashFollowsSlides();
+  testTranspositionTable();
+  testTranspositionTableAcrossThreads();
+
+  if (failures == 0) {
+    std::println("All PuzzleCore tests passed.");
+    return 0;
+  }
+  std::println(std::cerr, "{} PuzzleCore test(s) failed.", failures);
+  return 1;
+}
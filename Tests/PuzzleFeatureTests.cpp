@@ -125,12 +125,17 @@ void testOnMountShufflesAndStartsTimer() {
       });
 }
 
-// A SolverClient stub returning a fixed plan, so the async auto-solve flow is
-// deterministic and thread-free under TestStore (effects run inline).
-SolverClient::Client stubSolver(std::vector<int> plan) {
-  return SolverClient::Client{.plan = [plan](std::vector<int>, int, std::stop_token) {
-    return std::expected<std::vector<int>, SolverClient::SolveError>{plan};
-  }};
+// A SolverClient stub reporting fixed plans in order, so the async auto-solve
+// flow is deterministic and thread-free under TestStore (effects run inline).
+SolverClient::Client stubSolver(std::vector<std::vector<int>> plans) {
+  return SolverClient::Client{
+      .plan = [plans](std::vector<int>, int, SolverClient::PlanMode, std::chrono::milliseconds,
+                      const SolverClient::PlanSink &improved, std::stop_token) {
+        for (const std::vector<int> &plan : plans) {
+          improved(plan);
+        }
+        return std::expected<std::vector<int>, SolverClient::SolveError>{plans.back()};
+      }};
 }
 
 // AutoSolve kicks off the (stubbed) solver, receives its moves, and animates
@@ -140,7 +145,7 @@ void testAutoSolveAnimatesToSolved() {
       [](DependencyValues &values) {
         values.context = DependencyContext::test;
         values.set<DateGeneratorKey>(DateGenerator::constant(0.0));
-        values.set<SolverClient::Key>(stubSolver({15})); // one move solves almostSolvedState
+        values.set<SolverClient::Key>(stubSolver({{15}})); // one move solves almostSolvedState
       },
       [] {
         TestStore<PuzzleFeature::State, PuzzleFeature::Action> store(almostSolvedState(),
@@ -173,6 +178,50 @@ void testAutoSolveAnimatesToSolved() {
       });
 }
 
+// A shorter plan arriving while the first is queued replaces it.
+void testShorterPlanTakesOver() {
+  // Three turns of the empty cell around the bottom-right 2×2 block leave the
+  // board as it was, so this is a 13-move plan that ends like the 1-move one.
+  std::vector<int> detour;
+  for (int turn = 0; turn < 3; ++turn) {
+    detour.insert(detour.end(), {15, 11, 10, 14});
+  }
+  detour.push_back(15);
+  withDependencies(
+      [detour](DependencyValues &values) {
+        values.context = DependencyContext::test;
+        values.set<DateGeneratorKey>(DateGenerator::constant(0.0));
+        values.set<SolverClient::Key>(stubSolver({detour, {15}}));
+      },
+      [detour] {
+        TestStore<PuzzleFeature::State, PuzzleFeature::Action> store(almostSolvedState(),
+                                                                     PuzzleFeature::body);
+
+        store.send(PuzzleFeature::AutoSolveButtonTapped{},
+                   [](PuzzleFeature::State &state) { state.isSolving = true; });
+        store.receive([detour](PuzzleFeature::State &state) {
+          state.pendingMoves = detour;
+          state.nextMoveAt = 0.0;
+          state.solveInterval = 0.10; // clamp(4.0 / 13 moves)
+        });
+        store.receive([](PuzzleFeature::State &state) { state.pendingMoves = {15}; });
+
+        store.send(PuzzleFeature::TimerTicked{}, [](PuzzleFeature::State &state) {
+          std::swap(state.tiles[14], state.tiles[15]);
+          state.moveHistory.push_back(15);
+          state.pendingMoves.clear();
+          state.nextMoveAt += 0.10;
+          state.isSolving = false;
+          state.isGameOver = true;
+          state.lastDuration = 0;
+          state.startDate = std::nullopt;
+        });
+
+        expect(!store.failed(), "a shorter plan replaces the queued one");
+        return 0;
+      });
+}
+
 // Interacting mid-solve cancels the auto-solve.
 void testInteractionCancelsAutoSolve() {
   withDependencies(
@@ -180,7 +229,7 @@ void testInteractionCancelsAutoSolve() {
         values.context = DependencyContext::test;
         values.set<DateGeneratorKey>(DateGenerator::constant(0.0));
         values.set<RandomNumberGeneratorKey>(RandomNumberGenerator::seeded(7));
-        values.set<SolverClient::Key>(stubSolver({15}));
+        values.set<SolverClient::Key>(stubSolver({{15}}));
       },
       [] {
         TestStore<PuzzleFeature::State, PuzzleFeature::Action> store(almostSolvedState(),
@@ -215,6 +264,7 @@ int main() {
   testTimerTickedAdvancesElapsedSeconds();
   testOnMountShufflesAndStartsTimer();
   testAutoSolveAnimatesToSolved();
+  testShorterPlanTakesOver();
   testInteractionCancelsAutoSolve();
 
   if (failures == 0) {
@@ -1,7 +1,10 @@
 // Tests the saved-game JSON file strategy: round-trips an in-progress game and,
 // crucially, deletes the file when saving std::nullopt (the clear-on-win path).
+// Also covers journal mode (appends, replay, compaction, torn tails, a crash
+// mid-compaction onto a new game) and the memory-mapped packed layout.
 
 import std;
+import PuzzleCore;
 import Sharing;
 import SavedGame;
 import SavedGameLive;
@@ -47,10 +50,196 @@ void testRoundTripAndClear() {
   std::filesystem::remove(path, ec);
 }
 
+std::uintmax_t sizeOf(const std::filesystem::path &path) {
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(path, ec);
+  return ec ? 0 : size;
+}
+
+// A 2×2 board: the empty cell starts at 3, and sliding 2 then 0 then 1 is legal.
+SavedGame::Game journalStart() {
+  return SavedGame::Game{
+      .grid = 2, .tiles = {"1", "2", "3", ""}, .moveHistory = {}, .secondsElapsed = 0};
+}
+
+SavedGame::Game advanced(SavedGame::Game game, int pos, int seconds) {
+  expect(PuzzleCore::slide(game.tiles, game.moveHistory, game.grid, pos), "test move is legal");
+  game.secondsElapsed = seconds;
+  return game;
+}
+
+void testJournalAppendsAndReplays() {
+  const auto path = std::filesystem::temp_directory_path() / "fifteen-savedgame-journal.json";
+  const auto journal = std::filesystem::path(path).concat(".journal");
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+  std::filesystem::remove(journal, ec);
+
+  auto strategy = SavedGame::savedGameJournalStorage(path);
+  expect(!strategy.load().has_value(), "journal: missing file → nullopt");
+
+  auto game = journalStart();
+  strategy.save(game); // first save has nothing to extend → snapshot
+  expect(std::filesystem::exists(path, ec), "journal: first save writes the snapshot");
+  const auto snapshotSize = sizeOf(path);
+
+  game = advanced(game, 2, 1);
+  strategy.save(game);
+  game = advanced(game, 0, 2);
+  strategy.save(game);
+  expect(sizeOf(path) == snapshotSize, "journal: continuing saves leave the snapshot alone");
+  expect(sizeOf(journal) > 0 && sizeOf(journal) < snapshotSize,
+         "journal: continuing saves append a few bytes");
+
+  // A fresh strategy (a relaunch) rebuilds the game from snapshot + journal.
+  auto relaunched = SavedGame::savedGameJournalStorage(path);
+  const auto loaded = relaunched.load();
+  expect(loaded.has_value() && loaded->has_value() && **loaded == game,
+         "journal: snapshot + journal replays to the latest game");
+
+  // A torn final record (crash mid-append) is ignored.
+  {
+    std::ofstream out(journal, std::ios::binary | std::ios::app);
+    out << "2 3 1";
+  }
+  const auto torn = SavedGame::savedGameJournalStorage(path).load();
+  expect(torn.has_value() && torn->has_value() && **torn == game,
+         "journal: a torn tail is dropped on replay");
+
+  // Clear-on-win removes both files.
+  relaunched.save(std::nullopt);
+  expect(!std::filesystem::exists(path, ec), "journal: save(nullopt) removes the snapshot");
+  expect(!std::filesystem::exists(journal, ec), "journal: save(nullopt) removes the journal");
+  expect(!relaunched.load().has_value(), "journal: save(nullopt) → load nullopt");
+}
+
+void testJournalCompacts() {
+  const auto path = std::filesystem::temp_directory_path() / "fifteen-savedgame-compact.json";
+  const auto journal = std::filesystem::path(path).concat(".journal");
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+  std::filesystem::remove(journal, ec);
+
+  auto strategy = SavedGame::savedGameJournalStorage(path, 2);
+  auto game = journalStart();
+  strategy.save(game);
+  game = advanced(game, 2, 1);
+  strategy.save(game);
+  expect(sizeOf(journal) > 0, "compact: first continuation is journaled");
+  game = advanced(game, 0, 2);
+  strategy.save(game); // second record hits compactEvery → snapshot + truncate
+  expect(!std::filesystem::exists(journal, ec), "compact: journal truncated after compaction");
+  const auto loaded = SavedGame::savedGameFileStorage(path).load();
+  expect(loaded.has_value() && loaded->has_value() && **loaded == game,
+         "compact: the snapshot alone holds the latest game");
+
+  // A save that does not extend the history (a new game) snapshots directly.
+  const SavedGame::Game fresh{
+      .grid = 4, .tiles = {"1", "2", "3", ""}, .moveHistory = {3}, .secondsElapsed = 0};
+  strategy.save(fresh);
+  const auto reloaded = SavedGame::savedGameJournalStorage(path, 2).load();
+  expect(reloaded.has_value() && reloaded->has_value() && **reloaded == fresh,
+         "compact: a non-continuation save replaces the snapshot");
+
+  std::filesystem::remove(path, ec);
+  std::filesystem::remove(journal, ec);
+}
+
+// A new deal's history is as long as the last game's, so the old game's journal
+// records line up with it by length: a crash after the new snapshot is written
+// but before the journal is truncated must not replay old taps onto it.
+void testJournalNewGameAfterCrash() {
+  const auto path = std::filesystem::temp_directory_path() / "fifteen-savedgame-newgame.json";
+  const auto journal = std::filesystem::path(path).concat(".journal");
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+  std::filesystem::remove(journal, ec);
+
+  auto strategy = SavedGame::savedGameJournalStorage(path);
+  const auto old = advanced(journalStart(), 2, 1); // dealt one move from solved
+  strategy.save(old);
+  strategy.save(advanced(old, 0, 2));
+  std::string oldRecords;
+  {
+    std::ifstream in(journal, std::ios::binary);
+    oldRecords.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  expect(!oldRecords.empty(), "new game: the old game's move is journaled");
+
+  // A new deal, also one move from solved, where tapping 0 is legal too.
+  const auto fresh = advanced(journalStart(), 1, 0);
+  strategy.save(fresh);
+  {
+    std::ofstream out(journal, std::ios::binary | std::ios::trunc);
+    out << oldRecords; // the crash: the old journal outlives the new snapshot
+  }
+  const auto loaded = SavedGame::savedGameJournalStorage(path).load();
+  expect(loaded.has_value() && loaded->has_value() && **loaded == fresh,
+         "new game: loads unchanged after a crash mid-compaction");
+
+  std::filesystem::remove(path, ec);
+  std::filesystem::remove(journal, ec);
+}
+
+void testMappedStorage() {
+  const auto path = std::filesystem::temp_directory_path() / "fifteen-savedgame-test.map";
+  const auto overflow = std::filesystem::path(path).concat(".json");
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+  std::filesystem::remove(overflow, ec);
+
+  auto strategy = SavedGame::savedGameMappedStorage(path);
+  expect(!strategy.load().has_value(), "mapped: missing file → nullopt");
+
+  auto game = SavedGame::Game{.grid = 4,
+                              .tiles = PuzzleCore::solvedTiles(4),
+                              .moveHistory = {},
+                              .secondsElapsed = 7};
+  for (const int pos : {11, 10, 6}) {
+    expect(PuzzleCore::slide(game.tiles, game.moveHistory, game.grid, pos), "mapped: legal move");
+  }
+  strategy.save(game);
+  const auto loaded = SavedGame::savedGameMappedStorage(path).load();
+  expect(loaded.has_value() && loaded->has_value() && **loaded == game,
+         "mapped: packed game round-trips");
+
+  // A hand solve on 13×13 outgrows the packed history: it falls back to a JSON
+  // snapshot instead of clearing the slot.
+  auto longGame = SavedGame::Game{.grid = 13,
+                                  .tiles = PuzzleCore::solvedTiles(13),
+                                  .moveHistory = {},
+                                  .secondsElapsed = 900};
+  for (std::size_t i = 0; i <= SavedGame::kMappedHistoryCapacity; ++i) {
+    PuzzleCore::slide(longGame.tiles, longGame.moveHistory, 13, i % 2 == 0 ? 167 : 168);
+  }
+  strategy.save(longGame);
+  const auto overflowed = SavedGame::savedGameMappedStorage(path).load();
+  expect(overflowed.has_value() && overflowed->has_value() && **overflowed == longGame,
+         "mapped: a game past the history capacity round-trips");
+
+  // Back within the layout, the packed slot holds it again.
+  strategy.save(game);
+  expect(!std::filesystem::exists(overflow, ec), "mapped: a packed save removes the overflow");
+  const auto repacked = SavedGame::savedGameMappedStorage(path).load();
+  expect(repacked.has_value() && repacked->has_value() && **repacked == game,
+         "mapped: a packed save replaces the overflow");
+
+  strategy.save(longGame);
+  strategy.save(std::nullopt);
+  expect(!strategy.load().has_value(), "mapped: save(nullopt) → load nullopt");
+  expect(!std::filesystem::exists(overflow, ec), "mapped: save(nullopt) removes the overflow");
+
+  std::filesystem::remove(path, ec);
+}
+
 } // namespace
 
 int main() {
   testRoundTripAndClear();
+  testJournalAppendsAndReplays();
+  testJournalCompacts();
+  testJournalNewGameAfterCrash();
+  testMappedStorage();
   if (failures == 0) {
     std::println("All SavedGame tests passed.");
     return 0;
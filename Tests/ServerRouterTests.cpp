@@ -31,6 +31,23 @@ void testFetchLeaderboardRoundTrip() {
   expect(matched.has_value() && matched == route, "fetch: match(print(route)) == route");
 }
 
+void testFetchLeaderboardByParRoundTrip() {
+  const ServerRouter::Route route =
+      ServerRouter::FetchLeaderboard{.gridSize = 4, .ranking = ServerRouter::Ranking::par};
+  const ServerRouter::Request request = ServerRouter::print(route);
+
+  expect(request.query == "size=4&rank=par", "par: prints the rank query");
+  const auto matched = ServerRouter::match(request);
+  expect(matched.has_value() && matched == route, "par: match(print(route)) == route");
+  const auto byTime =
+      ServerRouter::match({.method = "GET", .path = "/leaderboard", .query = "size=4&rank=time"});
+  expect(byTime == ServerRouter::Route{ServerRouter::FetchLeaderboard{.gridSize = 4}},
+         "par: rank=time is the default ranking");
+  expect(!ServerRouter::match({.method = "GET", .path = "/leaderboard", .query = "rank=speed"})
+              .has_value(),
+         "par: an unknown ranking does not match");
+}
+
 void testSubmitScoreRoundTrip() {
   const ServerRouter::Route route = ServerRouter::SubmitScore{.submission = kSubmission};
   const ServerRouter::Request request = ServerRouter::print(route);
@@ -42,6 +59,61 @@ void testSubmitScoreRoundTrip() {
   expect(matched.has_value() && matched == route, "submit: match(print(route)) == route");
 }
 
+void testSubmitScoresRoundTrip() {
+  auto second = kSubmission;
+  second.name = "Bob";
+  second.clientId = "0f3a9c-7"; // an outbox entry's, carried through to the server
+  const ServerRouter::Route route =
+      ServerRouter::SubmitScores{.submissions = {kSubmission, second}};
+  const ServerRouter::Request request = ServerRouter::print(route);
+
+  expect(request.method == "POST" && request.path == "/scores/batch",
+         "batch: prints POST /scores/batch");
+  const auto matched = ServerRouter::match(request);
+  expect(matched.has_value() && matched == route, "batch: match(print(route)) == route");
+  expect(
+      !ServerRouter::match({.method = "POST", .path = "/scores/batch", .body = "{}"}).has_value(),
+      "batch: a non-array body does not match");
+}
+
+void testFetchMetricsRoundTrip() {
+  const ServerRouter::Route route = ServerRouter::FetchMetrics{};
+  const ServerRouter::Request request = ServerRouter::print(route);
+
+  expect(request.method == "GET" && request.path == "/metrics", "metrics: prints GET /metrics");
+  const auto matched = ServerRouter::match(request);
+  expect(matched.has_value() && matched == route, "metrics: match(print(route)) == route");
+}
+
+void testFetchEngineStateRoundTrip() {
+  const ServerRouter::Route route = ServerRouter::FetchEngineState{};
+  const ServerRouter::Request request = ServerRouter::print(route);
+
+  expect(request.method == "GET" && request.path == "/admin/engine",
+         "admin: prints GET /admin/engine");
+  const auto matched = ServerRouter::match(request);
+  expect(matched.has_value() && matched == route, "admin: match(print(route)) == route");
+}
+
+void testRouteNames() {
+  expect(ServerRouter::routeName(ServerRouter::print(ServerRouter::FetchLeaderboard{})) ==
+             "leaderboard",
+         "routeName: leaderboard");
+  expect(ServerRouter::routeName({.method = "POST", .path = "/scores", .body = "not json"}) ==
+             "scores",
+         "routeName: names /scores without decoding the body");
+  expect(ServerRouter::routeName(ServerRouter::print(ServerRouter::SubmitScores{})) ==
+             "scores_batch",
+         "routeName: scores_batch");
+  expect(ServerRouter::routeName(ServerRouter::print(ServerRouter::FetchMetrics{})) == "metrics",
+         "routeName: metrics");
+  expect(ServerRouter::routeName(ServerRouter::print(ServerRouter::FetchEngineState{})) ==
+             "admin",
+         "routeName: admin");
+  expect(ServerRouter::routeName({.method = "GET", .path = "/nope"}) == "unknown",
+         "routeName: anything else is unknown");
+}
+
 void testUnknownRoutesDoNotMatch() {
   expect(!ServerRouter::match({.method = "GET", .path = "/nope"}).has_value(),
          "unknown path does not match");
@@ -62,7 +134,7 @@ void testCodecsRoundTrip() {
          "submission codec round-trips");
 
   const std::vector<SharedModels::LeaderboardEntry> entries{
-      {.name = "Ada", .gridSize = 4, .moves = 80, .duration = 42, .playedAt = 1.0},
+      {.name = "Ada", .gridSize = 4, .moves = 80, .duration = 42, .playedAt = 1.0, .par = 52},
       {.name = "Bob", .gridSize = 4, .moves = 60, .duration = 30, .playedAt = 2.0}};
   const auto decodedEntries =
       ServerRouter::decodeLeaderboardEntries(ServerRouter::encodeLeaderboardEntries(entries));
@@ -71,6 +143,13 @@ void testCodecsRoundTrip() {
   expect(!ServerRouter::decodeLeaderboardEntries("{\"not\":\"an array\"}").has_value() ||
              ServerRouter::decodeLeaderboardEntries("{\"not\":\"an array\"}")->empty(),
          "non-array leaderboard body decodes to nothing useful");
+  // The deal and its par are the server's to fill in, never a client's claim.
+  auto dealt = kSubmission;
+  dealt.seed = 99;
+  dealt.par = 12;
+  expect(ServerRouter::decodeScoreSubmission(ServerRouter::encodeScoreSubmission(dealt)) ==
+             kSubmission,
+         "submission codec leaves out the seed and par");
   expect(!ServerRouter::decodeScoreSubmission("[]").has_value(),
          "wrong-shape submission fails to decode");
 }
@@ -79,7 +158,12 @@ void testCodecsRoundTrip() {
 
 int main() {
   testFetchLeaderboardRoundTrip();
+  testFetchLeaderboardByParRoundTrip();
   testSubmitScoreRoundTrip();
+  testSubmitScoresRoundTrip();
+  testFetchMetricsRoundTrip();
+  testFetchEngineStateRoundTrip();
+  testRouteNames();
   testUnknownRoutesDoNotMatch();
   testCodecsRoundTrip();
 
@@ -1,6 +1,7 @@
 // Tests the Sharing library: the in-memory strategy round-trips a value, and
 // the JSON file strategy persists across reloads while treating a missing or
 // corrupt file as "absent" (falling back to defaults rather than throwing).
+// The memory-mapped strategy survives a torn slot and rejects a foreign layout.
 
 import std;
 import Sharing;
@@ -72,11 +73,57 @@ void testFileStorageRoundTrip() {
   std::filesystem::remove(path, ec);
 }
 
+struct Sample {
+  std::int64_t score = 0;
+  std::int64_t moves = 0;
+
+  bool operator==(const Sample &) const = default;
+};
+
+void testMmapStorage() {
+  const auto path = std::filesystem::temp_directory_path() / "fifteen-sharing-test.map";
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+
+  {
+    auto strategy = Sharing::mmapStorage<Sample>(path);
+    expect(!strategy.load().has_value(), "mmapStorage: new file → absent");
+    strategy.save(Sample{.score = 1, .moves = 10});
+    strategy.save(Sample{.score = 2, .moves = 20});
+    expect(strategy.load() == Sample{.score = 2, .moves = 20}, "mmapStorage: latest save loads");
+  }
+
+  // A fresh mapping (a relaunch) sees the last save.
+  expect(Sharing::mmapStorage<Sample>(path).load() == Sample{.score = 2, .moves = 20},
+         "mmapStorage: value persists across mappings");
+
+  // Tear the active slot: the second save (sequence 2) went to slot 0, which
+  // sits right after the 40-byte header. The previous slot must win.
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(40);
+    file.put('\x7f');
+  }
+  expect(Sharing::mmapStorage<Sample>(path).load() == Sample{.score = 1, .moves = 10},
+         "mmapStorage: a torn active slot falls back to the previous one");
+
+  // A different layout version reads as absent, and its first save takes over.
+  {
+    auto other = Sharing::mmapStorage<Sample>(path, 2);
+    expect(!other.load().has_value(), "mmapStorage: layout mismatch → absent");
+    other.save(Sample{.score = 3, .moves = 30});
+    expect(other.load() == Sample{.score = 3, .moves = 30}, "mmapStorage: save reinitialises");
+  }
+
+  std::filesystem::remove(path, ec);
+}
+
 } // namespace
 
 int main() {
   testInMemoryRoundTrip();
   testFileStorageRoundTrip();
+  testMmapStorage();
   if (failures == 0) {
     std::println("All Sharing tests passed.");
     return 0;
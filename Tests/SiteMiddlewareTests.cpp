@@ -2,7 +2,8 @@
 // Request → Response against an explicit environment, so we exercise the real
 // route matching, validation and database logic in-process — and then back the
 // client's ApiClient with the same middleware and drive a client feature
-// (LeaderboardFeature) against the real server logic, no sockets anywhere.
+// (LeaderboardFeature) and the outbox uploader against the real server logic,
+// no sockets anywhere.
 
 import std;
 import ApiClient;
@@ -10,6 +11,7 @@ import ComposableArchitecture;
 import DatabaseClient;
 import DatabaseClientLive;
 import LeaderboardFeature;
+import ScoreUploader;
 import ServerRouter;
 import SharedModels;
 import SiteMiddleware;
@@ -67,6 +69,16 @@ ApiClient::Client middlewareBackedClient(SiteMiddleware::Environment environment
     }
     return {};
   };
+  client.submitScores = [environment](std::vector<ScoreSubmission> submissions,
+                                      std::stop_token) -> std::expected<void, ApiClient::ApiError> {
+    const auto response = SiteMiddleware::respond(
+        environment,
+        ServerRouter::print(ServerRouter::SubmitScores{.submissions = std::move(submissions)}));
+    if (response.status < 200 || response.status >= 300) {
+      return std::unexpected(ApiClient::ApiError::httpError);
+    }
+    return {};
+  };
   return client;
 }
 
@@ -134,6 +146,142 @@ void testServerSideValidation() {
          "routing: out-of-range board size answers 400");
 }
 
+void testBatchSubmit() {
+  const auto environment = inMemoryEnvironment();
+
+  auto blankName = kSubmission;
+  blankName.name = "";
+  auto second = kSubmission;
+  second.name = "Bob";
+  const auto response = SiteMiddleware::respond(
+      environment, ServerRouter::print(ServerRouter::SubmitScores{
+                       .submissions = {kSubmission, blankName, second}}));
+  expect(response.status == 201, "batch: answers 201");
+  expect(response.body == R"({"accepted":2,"rejected":1})", "batch: reports what was dropped");
+
+  const auto entries = ServerRouter::decodeLeaderboardEntries(
+      SiteMiddleware::respond(environment,
+                              ServerRouter::print(ServerRouter::FetchLeaderboard{.gridSize = 4}))
+          .body);
+  expect(entries.has_value() && entries->size() == 2, "batch: the valid submissions are stored");
+
+  const std::vector<ScoreSubmission> tooMany(ServerRouter::maxBatchSize + 1, kSubmission);
+  expect(SiteMiddleware::respond(environment, ServerRouter::print(ServerRouter::SubmitScores{
+                                                  .submissions = tooMany}))
+                 .status == 400,
+         "batch: oversized batch answers 400");
+  expect(SiteMiddleware::respond(environment,
+                                 {.method = "POST", .path = "/scores/batch", .body = "{}"})
+                 .status == 400,
+         "batch: malformed batch answers 400");
+}
+
+// Scores queued while offline stay queued, then reach the server in batches
+// once it is reachable.
+void testOutboxDrainsThroughMiddleware() {
+  const auto environment = inMemoryEnvironment();
+  auto localDatabase = DatabaseClient::live(":memory:");
+  (void)localDatabase.migrate();
+
+  const int queued = static_cast<int>(ServerRouter::maxBatchSize) + 20; // two batches
+  for (int i = 0; i < queued; ++i) {
+    auto submission = kSubmission;
+    submission.duration = 100 + i;
+    (void)localDatabase.enqueueSubmission(submission);
+  }
+
+  const ScoreUploader::Report offline = ScoreUploader::drainOutbox(
+      localDatabase, ApiClient::Key::testValue(), std::stop_source{}.get_token());
+  expect(!offline.drained && offline.uploaded == 0, "outbox: nothing leaves while offline");
+  const auto kept = localDatabase.fetchOutbox(queued);
+  expect(kept.has_value() && static_cast<int>(kept->size()) == queued,
+         "outbox: everything stays queued while offline");
+
+  const ScoreUploader::Report online = ScoreUploader::drainOutbox(
+      localDatabase, middlewareBackedClient(environment), std::stop_source{}.get_token());
+  expect(online.drained && online.uploaded == queued, "outbox: the whole queue is uploaded");
+  const auto left = localDatabase.fetchOutbox(queued);
+  expect(left.has_value() && left->empty(), "outbox: uploaded entries are removed");
+  const auto stats = environment.database.fetchStats();
+  expect(stats.has_value() && stats->gamesPlayed == queued, "outbox: the server stored each one");
+}
+
+// The server stores a batch but its acknowledgement is lost, then it is
+// unreachable for a while: the uploader keeps retrying, and the batch it sends
+// again is stored once.
+void testOutboxRetriesUntilStored() {
+  const auto environment = inMemoryEnvironment();
+  auto localDatabase = DatabaseClient::live(":memory:");
+  (void)localDatabase.migrate();
+  const int queued = 3;
+  for (int i = 0; i < queued; ++i) {
+    auto submission = kSubmission;
+    submission.duration = 100 + i;
+    (void)localDatabase.enqueueSubmission(submission);
+  }
+
+  auto flaky = middlewareBackedClient(environment);
+  int attempts = 0;
+  flaky.submitScores = [&attempts, server = flaky.submitScores](
+                           std::vector<ScoreSubmission> submissions,
+                           std::stop_token stop) -> std::expected<void, ApiClient::ApiError> {
+    ++attempts;
+    if (attempts == 1) {
+      (void)server(std::move(submissions), stop); // stored, but the reply never arrives
+    }
+    if (attempts <= 3) {
+      return std::unexpected(ApiClient::ApiError::offline);
+    }
+    return server(std::move(submissions), stop);
+  };
+
+  const ScoreUploader::Report report = ScoreUploader::drainUntilEmpty(
+      localDatabase, flaky,
+      ScoreUploader::Backoff{.first = std::chrono::milliseconds(1),
+                             .longest = std::chrono::milliseconds(2)},
+      std::stop_source{}.get_token());
+  expect(report.drained && report.uploaded == queued && attempts == 4,
+         "retry: the uploader retries until the server acknowledges");
+  const auto left = localDatabase.fetchOutbox(queued);
+  expect(left.has_value() && left->empty(), "retry: the outbox is empty");
+  const auto stats = environment.database.fetchStats();
+  expect(stats.has_value() && stats->gamesPlayed == queued,
+         "retry: the re-sent batch is stored once");
+}
+
+void testMetricsEndpoint() {
+  auto environment = inMemoryEnvironment();
+  const auto request = ServerRouter::print(ServerRouter::FetchMetrics{});
+
+  expect(SiteMiddleware::respond(environment, request).status == 404,
+         "metrics: 404 when no exporter is wired in");
+
+  environment.metrics = [] { return std::string("fifteen_up 1\n"); };
+  const auto response = SiteMiddleware::respond(environment, request);
+  expect(response.status == 200, "metrics: answers 200");
+  expect(response.contentType.starts_with("text/plain; version=0.0.4"),
+         "metrics: Prometheus text content type");
+  expect(response.body == "fifteen_up 1\n", "metrics: body is the exporter's text");
+}
+
+void testEngineStateEndpoint() {
+  auto environment = inMemoryEnvironment();
+  const auto request = ServerRouter::print(ServerRouter::FetchEngineState{});
+
+  expect(SiteMiddleware::respond(environment, request).status == 404,
+         "admin: 404 when no engine is wired in");
+
+  std::optional<std::string> published;
+  environment.engineState = [&published] { return published; };
+  expect(SiteMiddleware::respond(environment, request).status == 503,
+         "admin: 503 before the first snapshot");
+
+  published = R"({"observers":0})";
+  const auto response = SiteMiddleware::respond(environment, request);
+  expect(response.status == 200 && response.body == *published,
+         "admin: answers with the published snapshot");
+}
+
 // The full isowords integration pattern: a client feature runs against the
 // real middleware + database through its normal ApiClient dependency.
 void testLeaderboardFeatureAgainstRealMiddleware() {
@@ -178,6 +326,11 @@ void testLeaderboardFeatureAgainstRealMiddleware() {
 int main() {
   testSubmitThenFetchRoundTrip();
   testServerSideValidation();
+  testBatchSubmit();
+  testOutboxDrainsThroughMiddleware();
+  testOutboxRetriesUntilStored();
+  testMetricsEndpoint();
+  testEngineStateEndpoint();
   testLeaderboardFeatureAgainstRealMiddleware();
 
   if (failures == 0) {
@@ -1,5 +1,12 @@
 // Tests the reverse-history planner across board sizes: scramble with recorded
 // legal moves, plan the inverse, apply it, and verify the board reaches solved.
+// The anytime and optimal modes stream ever shorter plans that all solve it.
+// Then the hint search: optimal hints walk a 4×4 board home one move at a time
+// (answered from the table after the first), big boards still get a legal move
+// within the budget, and bad boards and cancellation are reported. Finally the
+// best-first search: optimal on boards that fit, a near-optimal plan within the
+// memory limit on 5×5, and its errors. Last, the solution cache: a solved board
+// and every board along its solution are answered again without a search.
 
 import std;
 import SolverClient;
@@ -68,7 +75,8 @@ void testPlansAllSizes() {
   for (int n = 4; n <= 13; ++n) { // levels 0..9
     for (std::uint64_t seed = 1; seed <= 50; ++seed) {
       auto s = scramble(n, n * n * 10, seed);
-      auto plan = client.plan(s.history, n, std::stop_token{});
+      auto plan = client.plan(s.history, n, SolverClient::PlanMode::fast, {}, {},
+                              std::stop_token{});
       if (!plan.has_value()) {
         expect(false, std::format("n={} seed={}: planner returned an error", n, seed));
         continue;
@@ -81,11 +89,263 @@ void testPlansAllSizes() {
   std::println("planned 4..13 x 50 scrambles; longest plan = {} moves", longest);
 }
 
+void testAnytimePlansImprove() {
+  auto client = SolverClient::live();
+  for (const int n : {4, 5, 9}) {
+    auto s = scramble(n, n * n * 10, 5);
+    std::vector<std::vector<int>> plans;
+    const auto start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration firstAfter{};
+    const auto plan = client.plan(
+        s.history, n, SolverClient::PlanMode::anytime, std::chrono::milliseconds(500),
+        [&](const std::vector<int> &moves) {
+          if (plans.empty()) {
+            firstAfter = std::chrono::steady_clock::now() - start;
+          }
+          plans.push_back(moves);
+        },
+        std::stop_token{});
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    expect(plan.has_value() && !plans.empty() && plans.back() == *plan,
+           std::format("anytime n={}: returns the last plan it reported", n));
+    expect(firstAfter < std::chrono::milliseconds(50),
+           std::format("anytime n={}: the first plan comes at once", n));
+    expect(elapsed < std::chrono::seconds(2), std::format("anytime n={}: within the deadline", n));
+    expect(!plans.empty() && plans.front().size() < s.history.size(),
+           std::format("anytime n={}: shorter than the history", n));
+    for (std::size_t i = 0; i < plans.size(); ++i) {
+      expect(i == 0 || plans[i].size() < plans[i - 1].size(),
+             std::format("anytime n={}: each plan shorter", n));
+      auto tiles = s.tiles;
+      applyMoves(tiles, plans[i]);
+      expect(tiles == solvedBoard(n), std::format("anytime n={}: plan {} solves", n, i));
+    }
+  }
+}
+
+void testOptimalPlanMatchesHint() {
+  auto client = SolverClient::live();
+  auto s = scramble(4, 160, 9);
+  const auto plan = client.plan(s.history, 4, SolverClient::PlanMode::optimal, {}, {},
+                                std::stop_token{});
+  // A fresh client, so the hint is searched rather than read from the plan's cache.
+  const auto hint =
+      SolverClient::live().hint(s.tiles, 4, std::chrono::seconds(30), std::stop_token{});
+  expect(plan.has_value() && hint.has_value() && hint->optimal &&
+             static_cast<int>(plan->size()) == hint->distance,
+         "optimal plan: as long as the optimal hint distance");
+  applyMoves(s.tiles, plan.value_or(std::vector<int>{}));
+  expect(s.tiles == solvedBoard(4), "optimal plan: solves the board");
+
+  std::stop_source stop;
+  stop.request_stop();
+  expect(client.plan(s.history, 4, SolverClient::PlanMode::anytime, std::chrono::seconds(1), {},
+                     stop.get_token())
+                 .error() == SolverClient::SolveError::cancelled,
+         "plan: cancelled");
+}
+
+bool isAdjacentToEmpty(const std::vector<std::string> &tiles, int n, int pos) {
+  const int empty = emptyIndex(tiles);
+  return (pos / n == empty / n && std::abs(pos - empty) == 1) || std::abs(pos - empty) == n;
+}
+
+void testHintsWalkHomeOptimally() {
+  auto client = SolverClient::live();
+  auto s = scramble(4, 60, 11);
+  auto first = client.hint(s.tiles, 4, std::chrono::seconds(30), std::stop_token{});
+  expect(first.has_value() && first->optimal && first->move.has_value(), "hint: 4x4 optimal");
+  if (!first.has_value() || !first->optimal) {
+    return;
+  }
+  expect(first->nodes > 0, "hint: the first hint searches");
+  int distance = first->distance;
+  std::uint64_t laterNodes = 0;
+  while (first.has_value() && first->move.has_value()) {
+    expect(isAdjacentToEmpty(s.tiles, 4, *first->move), "hint: move is legal");
+    applyMoves(s.tiles, {*first->move});
+    first = client.hint(s.tiles, 4, std::chrono::seconds(30), std::stop_token{});
+    if (first.has_value() && first->move.has_value()) {
+      expect(first->optimal && first->distance == distance - 1, "hint: one move closer");
+      laterNodes += first->nodes;
+      distance = first->distance;
+    }
+  }
+  expect(first.has_value() && !first->move.has_value(), "hint: none once solved");
+  expect(s.tiles == solvedBoard(4), "hint: following hints solves the board");
+  expect(laterNodes == 0, "hint: hints along the solution come from the table");
+}
+
+void testHintWithinBudgetOnBigBoards() {
+  auto client = SolverClient::live();
+  for (const int n : {5, 9, 13}) {
+    auto s = scramble(n, n * n * 10, 3);
+    const auto start = std::chrono::steady_clock::now();
+    const auto hint = client.hint(s.tiles, n, std::chrono::milliseconds(50), std::stop_token{});
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    expect(hint.has_value() && hint->move.has_value() && isAdjacentToEmpty(s.tiles, n, *hint->move),
+           std::format("hint n={}: a legal move", n));
+    expect(elapsed < std::chrono::milliseconds(500), std::format("hint n={}: within budget", n));
+  }
+}
+
+void testHintFromEndgameTable() {
+  auto client = SolverClient::live();
+  // One of the two hardest 8-puzzle positions: answered by the 3×3 table.
+  const auto hint = client.hint({"8", "6", "7", "2", "5", "4", "3", "", "1"}, 3,
+                                std::chrono::seconds(1), std::stop_token{});
+  expect(hint.has_value() && hint->optimal && hint->distance == 31 && hint->nodes == 0,
+         "hint 3x3: exact from the endgame table");
+
+  // A 7×7 board with only its corner scrambled still gets a move at once.
+  auto s = scramble(3, 30, 2);
+  auto tiles = solvedBoard(7);
+  for (int cell = 0; cell < 9; ++cell) {
+    const int local = s.tiles[static_cast<std::size_t>(cell)].empty()
+                          ? 8
+                          : std::stoi(s.tiles[static_cast<std::size_t>(cell)]) - 1;
+    const int home = (4 + local / 3) * 7 + 4 + local % 3;
+    tiles[static_cast<std::size_t>((4 + cell / 3) * 7 + 4 + cell % 3)] =
+        local == 8 ? "" : std::to_string(home + 1);
+  }
+  const auto corner = client.hint(tiles, 7, std::chrono::milliseconds(20), std::stop_token{});
+  expect(corner.has_value() && corner->move.has_value() &&
+             isAdjacentToEmpty(tiles, 7, *corner->move),
+         "hint 7x7: a legal move in the corner");
+}
+
+void testHintErrors() {
+  auto client = SolverClient::live();
+  auto unsolvable = solvedBoard(4);
+  std::swap(unsolvable[0], unsolvable[1]);
+  expect(client.hint(unsolvable, 4, std::chrono::seconds(1), std::stop_token{}).error() ==
+             SolverClient::SolveError::invalidBoard,
+         "hint: unsolvable board rejected");
+  expect(client.hint({"1", "2"}, 4, std::chrono::seconds(1), std::stop_token{}).error() ==
+             SolverClient::SolveError::invalidBoard,
+         "hint: malformed board rejected");
+
+  std::stop_source stop;
+  stop.request_stop();
+  const auto s = scramble(4, 200, 5);
+  expect(client.hint(s.tiles, 4, std::chrono::seconds(1), stop.get_token()).error() ==
+             SolverClient::SolveError::cancelled,
+         "hint: cancelled");
+}
+
+void testSearchOptimalWhenItFits() {
+  auto client = SolverClient::live();
+  for (const int n : {3, 4}) {
+    auto s = scramble(n, 40, 7);
+    const auto plan = client.search(s.tiles, n, std::size_t{256} << 20, std::stop_token{});
+    expect(plan.has_value() && plan->optimal, std::format("search n={}: optimal", n));
+    if (!plan.has_value()) {
+      continue;
+    }
+    expect(plan->stats.nodes > 0 && plan->stats.peakBytes > 0, "search: stats reported");
+    if (n == 4) {
+      const auto hint =
+          SolverClient::live().hint(s.tiles, 4, std::chrono::seconds(30), std::stop_token{});
+      expect(hint.has_value() && hint->optimal &&
+                 hint->distance == static_cast<int>(plan->moves.size()),
+             "search: as short as the optimal hint");
+    }
+    applyMoves(s.tiles, plan->moves);
+    expect(s.tiles == solvedBoard(n), std::format("search n={}: solves the board", n));
+  }
+}
+
+void testSearchFallsBackWithinMemory() {
+  auto client = SolverClient::live();
+  auto s = scramble(5, 250, 3);
+  const std::size_t limit = std::size_t{8} << 20;
+  const auto plan = client.search(s.tiles, 5, limit, std::stop_token{});
+  expect(plan.has_value(), "search 5x5: a plan within 8 MB");
+  if (!plan.has_value()) {
+    return;
+  }
+  expect(plan->stats.peakBytes <= limit + limit / 8, "search 5x5: memory stays near the limit");
+  applyMoves(s.tiles, plan->moves);
+  expect(s.tiles == solvedBoard(5), "search 5x5: the fallback plan solves the board");
+}
+
+void testSearchErrors() {
+  auto client = SolverClient::live();
+  const auto s = scramble(5, 250, 4);
+  expect(client.search(s.tiles, 5, 1'024, std::stop_token{}).error() ==
+             SolverClient::SolveError::memoryLimit,
+         "search: a 1 KB limit is too small");
+  auto unsolvable = solvedBoard(4);
+  std::swap(unsolvable[0], unsolvable[1]);
+  expect(client.search(unsolvable, 4, 1 << 20, std::stop_token{}).error() ==
+             SolverClient::SolveError::invalidBoard,
+         "search: unsolvable board rejected");
+
+  std::stop_source stop;
+  stop.request_stop();
+  expect(client.search(s.tiles, 5, 1 << 20, stop.get_token()).error() ==
+             SolverClient::SolveError::cancelled,
+         "search: cancelled");
+
+  const auto solved = client.search(solvedBoard(6), 6, 1 << 20, std::stop_token{});
+  expect(solved.has_value() && solved->moves.empty() && solved->optimal, "search: solved board");
+}
+
+void testSolutionCache() {
+  auto client = SolverClient::live();
+  auto s = scramble(4, 40, 7);
+  const auto first = client.search(s.tiles, 4, std::size_t{256} << 20, std::stop_token{});
+  expect(first.has_value() && first->optimal && first->moves.size() > 1, "cache: searched");
+  if (!first.has_value() || first->moves.size() < 2) {
+    return;
+  }
+  const auto again = client.search(s.tiles, 4, std::size_t{256} << 20, std::stop_token{});
+  expect(again.has_value() && again->optimal && again->moves == first->moves &&
+             again->stats.nodes == 0,
+         "cache: the same board again, without a search");
+
+  // One move along the solution, the rest of it.
+  auto along = s.tiles;
+  applyMoves(along, {first->moves.front()});
+  const std::vector<int> rest(first->moves.begin() + 1, first->moves.end());
+  const auto suffix = client.search(along, 4, std::size_t{256} << 20, std::stop_token{});
+  expect(suffix.has_value() && suffix->optimal && suffix->moves == rest &&
+             suffix->stats.nodes == 0,
+         "cache: a board along the solution gets the rest of it");
+  const auto hint = client.hint(along, 4, std::chrono::seconds(1), std::stop_token{});
+  expect(hint.has_value() && hint->optimal && hint->move == rest.front() &&
+             hint->distance == static_cast<int>(rest.size()) && hint->nodes == 0,
+         "cache: the hint there comes from the cache");
+
+  // The anytime planner, with no time to search, still finds the proved path.
+  auto history = s.history;
+  history.push_back(first->moves.front());
+  const auto plan = client.plan(history, 4, SolverClient::PlanMode::anytime,
+                                std::chrono::milliseconds(0), {}, std::stop_token{});
+  expect(plan.has_value() && plan->size() == rest.size(),
+         "cache: anytime plans reuse the proved path");
+
+  // A different board misses.
+  const auto other = scramble(4, 40, 8);
+  const auto missed = client.search(other.tiles, 4, std::size_t{256} << 20, std::stop_token{});
+  expect(missed.has_value() && missed->stats.nodes > 0, "cache: another board is searched");
+}
+
 } // namespace
 
 int main() {
   const auto start = std::chrono::steady_clock::now();
   testPlansAllSizes();
+  testAnytimePlansImprove();
+  testOptimalPlanMatchesHint();
+  testHintsWalkHomeOptimally();
+  testHintWithinBudgetOnBigBoards();
+  testHintFromEndgameTable();
+  testHintErrors();
+  testSearchOptimalWhenItFits();
+  testSearchFallsBackWithinMemory();
+  testSearchErrors();
+  testSolutionCache();
   const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
       std::chrono::steady_clock::now() - start);
   if (failures == 0) {
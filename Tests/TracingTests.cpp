@@ -0,0 +1,92 @@
+// Tests the Tracing rings: spans from every thread (including exited ones)
+// reach the Chrome trace, nested spans nest in time, and a ring keeps only its
+// newest spans. Compiled without FIFTEEN_TRACING, spans must leave no trace.
+
+import std;
+import Tracing;
+
+namespace {
+
+int failures = 0;
+void expect(bool ok, std::string_view msg) {
+  if (!ok) {
+    ++failures;
+    std::println(std::cerr, "FAIL: {}", msg);
+  }
+}
+
+std::size_t occurrences(std::string_view text, std::string_view needle) {
+  std::size_t count = 0;
+  for (std::size_t at = text.find(needle); at != std::string_view::npos;
+       at = text.find(needle, at + needle.size())) {
+    ++count;
+  }
+  return count;
+}
+
+// The `field` number of the first event named `name`.
+double fieldOf(std::string_view trace, std::string_view name, std::string_view field) {
+  const std::size_t event = trace.find(std::format(R"("name":"{}")", name));
+  const std::size_t at = trace.find(std::format(R"("{}":)", field), event) + field.size() + 3;
+  double value = 0.0;
+  std::from_chars(trace.data() + at, trace.data() + trace.size(), value);
+  return value;
+}
+
+void testSpansFromEveryThreadAreDumped() {
+  {
+    const Tracing::Span outer("test.outer");
+    const Tracing::Span inner("test.inner");
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::jthread([] { const Tracing::Span span("test.worker"); }).join();
+
+  const std::string trace = Tracing::chromeTrace();
+  expect(trace.starts_with(R"({"traceEvents":[)"), "trace: Chrome trace-event envelope");
+  if constexpr (!Tracing::kEnabled) {
+    expect(occurrences(trace, R"("ph")") == 0, "disabled: spans record nothing");
+    return;
+  }
+  expect(occurrences(trace, R"("name":"test.outer","ph":"X")") == 1, "trace: complete event");
+  expect(occurrences(trace, R"("name":"test.worker")") == 1,
+         "trace: an exited thread's spans are kept");
+
+  const double outerStart = fieldOf(trace, "test.outer", "ts");
+  const double outerDuration = fieldOf(trace, "test.outer", "dur");
+  const double innerStart = fieldOf(trace, "test.inner", "ts");
+  const double innerDuration = fieldOf(trace, "test.inner", "dur");
+  expect(innerDuration >= 1000.0, "trace: durations are in microseconds");
+  expect(outerStart <= innerStart && innerStart + innerDuration <= outerStart + outerDuration,
+         "trace: an inner span nests inside its outer span");
+  expect(fieldOf(trace, "test.outer", "tid") != fieldOf(trace, "test.worker", "tid"),
+         "trace: one tid per thread");
+}
+
+void testRingKeepsTheNewestSpans() {
+  if constexpr (!Tracing::kEnabled) {
+    return;
+  }
+  std::jthread([] {
+    for (std::size_t i = 0; i < Tracing::kRingCapacity + 100; ++i) {
+      const Tracing::Span span(i < 100 ? "test.old" : "test.new");
+    }
+  }).join();
+  const std::string trace = Tracing::chromeTrace();
+  expect(occurrences(trace, R"("name":"test.old")") == 0, "ring: the oldest spans are overwritten");
+  expect(occurrences(trace, R"("name":"test.new")") == Tracing::kRingCapacity,
+         "ring: a full ring's worth of spans is kept");
+}
+
+} // namespace
+
+int main() {
+  testSpansFromEveryThreadAreDumped();
+  testRingKeepsTheNewestSpans();
+
+  if (failures == 0) {
+    std::println("All Tracing tests passed.");
+    return 0;
+  }
+  std::println(std::cerr, "{} Tracing test(s) failed.", failures);
+  return 1;
+}